@@ -0,0 +1,224 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <vector>
+
+#include "data/dataHandler.h"
+#include "data/primitiveTypeArray.h"
+#include "environment.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "program/program.h"
+
+#include "archive.h"
+
+/**
+ * \brief Cost of Archive::addRecording() on a full Archive.
+ *
+ * Each recording uses new data, so each insertion copies a DataHandler and
+ * each eviction frees one. The argument is the size of the Archive: the
+ * time per recording is expected to remain constant when it grows.
+ */
+static void BM_ArchiveAddRecording(benchmark::State& state)
+{
+    const size_t archiveSize = state.range(0);
+    const size_t nbPrograms = 64;
+
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    set.add(add);
+    set.add(sub);
+    Data::PrimitiveTypeArray<double> data(16);
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    Environment env(set, dataSources, 8);
+    std::vector<Program::Program> programs(nbPrograms, Program::Program(env));
+
+    // Fill the Archive
+    Archive archive(archiveSize, 1.0);
+    uint64_t nbRecordings = 0;
+    auto addRecording = [&]() {
+        data.setDataAt(typeid(double), 0, (double)nbRecordings);
+        archive.addRecording(&programs.at(nbRecordings % nbPrograms),
+                             dataSources, (double)nbRecordings);
+        nbRecordings++;
+    };
+    while (archive.getNbRecordings() < archiveSize) {
+        addRecording();
+    }
+
+    for (auto _ : state) {
+        addRecording();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ArchiveAddRecording)->RangeMultiplier(4)->Range(1 << 8, 1 << 16);
+
+/**
+ * \brief Cost of Archive::areProgramResultsUnique() on a full Archive.
+ *
+ * The argument is the size of the Archive.
+ */
+static void BM_ArchiveAreProgramResultsUnique(benchmark::State& state)
+{
+    const size_t archiveSize = state.range(0);
+    const size_t nbPrograms = 64;
+
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    set.add(add);
+    set.add(sub);
+    Data::PrimitiveTypeArray<double> data(16);
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    Environment env(set, dataSources, 8);
+    std::vector<Program::Program> programs(nbPrograms, Program::Program(env));
+
+    Archive archive(archiveSize, 1.0);
+    std::map<size_t, double> hashesAndResults;
+    for (uint64_t idx = 0; idx < archiveSize; idx++) {
+        data.setDataAt(typeid(double), 0, (double)idx);
+        archive.addRecording(&programs.at(idx % nbPrograms), dataSources,
+                             (double)idx);
+        // Results differing from all archived programs.
+        hashesAndResults.emplace(data.getHash(), -1.0 - (double)idx);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            archive.areProgramResultsUnique(hashesAndResults));
+    }
+}
+BENCHMARK(BM_ArchiveAreProgramResultsUnique)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 16);
+
+/**
+ * \brief Cost of Archive::areProgramResultsUnique() on a full Archive where
+ * each recording comes from a different Program, on a few DataHandler.
+ *
+ * The argument is the size of the Archive.
+ */
+static void BM_ArchiveAreProgramResultsUniqueManyPrograms(
+    benchmark::State& state)
+{
+    const size_t archiveSize = state.range(0);
+    const size_t nbData = 16;
+
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    set.add(add);
+    set.add(sub);
+    Data::PrimitiveTypeArray<double> data(16);
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    Environment env(set, dataSources, 8);
+    std::vector<Program::Program> programs(archiveSize, Program::Program(env));
+
+    Archive archive(archiveSize, 1.0);
+    std::map<size_t, double> hashesAndResults;
+    for (uint64_t idx = 0; idx < archiveSize; idx++) {
+        data.setDataAt(typeid(double), 0, (double)(idx % nbData));
+        archive.addRecording(&programs.at(idx), dataSources, (double)idx);
+        // Results differing from all archived programs.
+        hashesAndResults.emplace(data.getHash(), -1.0 - (double)idx);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            archive.areProgramResultsUnique(hashesAndResults));
+    }
+}
+BENCHMARK(BM_ArchiveAreProgramResultsUniqueManyPrograms)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 16);
+
+/**
+ * \brief Cost of Archive::areProgramResultsUnique() on a full Archive filled
+ * as during training.
+ *
+ * During training, all the Program of the teams visited during an inference
+ * are recorded on the same DataHandler, and a Program is recorded on several
+ * DataHandler. As in TPGMutator::mutateProgramBehaviorAgainstArchive(), the
+ * results of the checked Program are given for all archived DataHandler.
+ *
+ * The argument is the size of the Archive.
+ */
+static void BM_ArchiveAreProgramResultsUniqueTraining(benchmark::State& state)
+{
+    const size_t archiveSize = state.range(0);
+    const size_t nbRecordingsPerData = 16;
+    const size_t nbRecordingsPerProgram = 4;
+
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    set.add(add);
+    set.add(sub);
+    Data::PrimitiveTypeArray<double> data(16);
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    Environment env(set, dataSources, 8);
+    std::vector<Program::Program> programs(
+        archiveSize / nbRecordingsPerProgram, Program::Program(env));
+
+    Archive archive(archiveSize, 1.0);
+    std::map<size_t, double> hashesAndResults;
+    for (uint64_t idx = 0; idx < archiveSize; idx++) {
+        data.setDataAt(typeid(double), 0,
+                       (double)(idx / nbRecordingsPerData));
+        archive.addRecording(&programs.at(idx % programs.size()), dataSources,
+                             (double)idx);
+        // Results differing from all archived programs.
+        hashesAndResults.emplace(data.getHash(), -1.0 - (double)idx);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            archive.areProgramResultsUnique(hashesAndResults));
+    }
+}
+BENCHMARK(BM_ArchiveAreProgramResultsUniqueTraining)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 16);
@@ -0,0 +1,146 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "data/hash.h"
+#include "data/primitiveTypeArray.h"
+
+/**
+ * \brief Reference hash of an array, computed as DataHandler hashes were
+ * before the incremental hash: byte-wise FNV-1a hashes of all elements,
+ * combined with rotations.
+ */
+static size_t referenceArrayHash(size_t id, const std::vector<double>& values)
+{
+    size_t hash = Data::Hash<size_t>()(id);
+    Data::Hash<double> hasher;
+    for (double value : values) {
+        hash = (hash >> 1) | (hash << 63);
+        hash ^= hasher(value);
+    }
+    return hash;
+}
+
+/**
+ * \brief Cost of hashing a complete array with the reference byte-wise FNV-1a
+ * hash. The argument is the number of elements.
+ */
+static void BM_HashArrayReference(benchmark::State& state)
+{
+    std::vector<double> values(state.range(0));
+    for (size_t i = 0; i < values.size(); i++) {
+        values.at(i) = (double)i;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(referenceArrayHash(0, values));
+    }
+    state.SetBytesProcessed(state.iterations() * values.size() *
+                            sizeof(double));
+}
+BENCHMARK(BM_HashArrayReference)->RangeMultiplier(16)->Range(64, 1 << 16);
+
+/**
+ * \brief Cost of hashing a complete PrimitiveTypeArray, when all its content
+ * is invalidated. The argument is the number of elements.
+ */
+static void BM_HashArrayFull(benchmark::State& state)
+{
+    Data::PrimitiveTypeArray<double> data(state.range(0));
+    for (size_t i = 0; i < (size_t)state.range(0); i++) {
+        data.setDataAt(typeid(double), i, (double)i);
+    }
+
+    for (auto _ : state) {
+        data.invalidateCachedHash();
+        benchmark::DoNotOptimize(data.getHash());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            sizeof(double));
+}
+BENCHMARK(BM_HashArrayFull)->RangeMultiplier(16)->Range(64, 1 << 16);
+
+/**
+ * \brief Cost of updating the hash of a PrimitiveTypeArray after a single
+ * setDataAt(). The argument is the number of elements: the time is expected
+ * to remain constant when it grows.
+ */
+static void BM_HashArrayIncremental(benchmark::State& state)
+{
+    const size_t nbElements = state.range(0);
+    Data::PrimitiveTypeArray<double> data(nbElements);
+    benchmark::DoNotOptimize(data.getHash());
+
+    size_t step = 0;
+    for (auto _ : state) {
+        data.setDataAt(typeid(double), (step * 7919) % nbElements,
+                       (double)step);
+        benchmark::DoNotOptimize(data.getHash());
+        step++;
+    }
+}
+BENCHMARK(BM_HashArrayIncremental)->RangeMultiplier(16)->Range(64, 1 << 16);
+
+/**
+ * \brief Cost of hashing a byte range with the byte-wise FNV-1a hash. The
+ * argument is the number of bytes.
+ */
+static void BM_HashBytesFnv1a(benchmark::State& state)
+{
+    std::vector<unsigned char> bytes(state.range(0), 42);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Data::_Fnv1a_append_bytes(
+            Data::_FNV_offset_basis, bytes.data(), bytes.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_HashBytesFnv1a)->RangeMultiplier(16)->Range(64, 1 << 16);
+
+/**
+ * \brief Cost of hashing a byte range with the word-at-a-time hash. The
+ * argument is the number of bytes.
+ */
+static void BM_HashBytesWord(benchmark::State& state)
+{
+    std::vector<unsigned char> bytes(state.range(0), 42);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Data::_Word_hash_append_bytes(
+            Data::_FNV_offset_basis, bytes.data(), bytes.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_HashBytesWord)->RangeMultiplier(16)->Range(64, 1 << 16);
@@ -0,0 +1,205 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <vector>
+
+#include "data/dataHandler.h"
+#include "data/primitiveTypeArray.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "learn/learningEnvironment.h"
+#include "learn/learningParameters.h"
+#include "learn/parallelLearningAgent.h"
+#include "mutator/rng.h"
+
+/**
+ * \brief Synthetic LearningEnvironment for benchmarking the training
+ * process.
+ *
+ * The environment exposes 16 random double values. The score is
+ * incremented each time the chosen action is the index of the greatest of
+ * the first values. After each action, one of the values is drawn again.
+ */
+class SyntheticLearningEnvironment : public Learn::LearningEnvironment
+{
+  protected:
+    /// Number of actions of each episode.
+    static const uint64_t NB_STEPS = 20;
+
+    /// Values exposed to the learning agent.
+    Data::PrimitiveTypeArray<double> data;
+
+    /// Copy of the values, for reading them directly.
+    std::vector<double> values;
+
+    /// RNG used to draw values.
+    Mutator::RNG rng;
+
+    /// Number of actions since the last reset.
+    uint64_t nbSteps = 0;
+
+    /// Score of the current episode.
+    double score = 0.0;
+
+    /// Draw the value at the given index.
+    void drawValue(size_t idx)
+    {
+        this->values.at(idx) = this->rng.getDouble(-10.0, 10.0);
+        this->data.setDataAt(typeid(double), idx, this->values.at(idx));
+    }
+
+  public:
+    /// Constructor with the number of actions.
+    SyntheticLearningEnvironment(uint64_t nbActions)
+        : LearningEnvironment(nbActions), data(16), values(16, 0.0)
+    {
+    }
+
+    /// Copy constructor used by clone().
+    SyntheticLearningEnvironment(const SyntheticLearningEnvironment& other) =
+        default;
+
+    /// Inherited via LearningEnvironment
+    LearningEnvironment* clone() const override
+    {
+        return new SyntheticLearningEnvironment(*this);
+    }
+
+    /// Inherited via LearningEnvironment
+    bool isCopyable() const override
+    {
+        return true;
+    }
+
+    /// Inherited via LearningEnvironment
+    void doAction(uint64_t actionID) override
+    {
+        LearningEnvironment::doAction(actionID);
+        auto begin = this->values.begin();
+        auto best = std::max_element(begin, begin + this->nbActions);
+        if ((uint64_t)(best - begin) == actionID) {
+            this->score += 1.0;
+        }
+        this->drawValue(this->nbSteps % this->values.size());
+        this->nbSteps++;
+    }
+
+    /// Inherited via LearningEnvironment
+    void reset(size_t seed, Learn::LearningMode mode,
+               uint16_t iterationNumber, uint64_t generationNumber) override
+    {
+        this->rng.setSeed(seed);
+        for (size_t idx = 0; idx < this->values.size(); idx++) {
+            this->drawValue(idx);
+        }
+        this->nbSteps = 0;
+        this->score = 0.0;
+    }
+
+    /// Inherited via LearningEnvironment
+    std::vector<std::reference_wrapper<const Data::DataHandler>>
+    getDataSources() override
+    {
+        return {this->data};
+    }
+
+    /// Inherited via LearningEnvironment
+    double getScore() const override
+    {
+        return this->score;
+    }
+
+    /// Inherited via LearningEnvironment
+    bool isTerminal() const override
+    {
+        return this->nbSteps >= NB_STEPS;
+    }
+};
+
+/**
+ * \brief Cost of a complete generation of training with
+ * LearningAgent::trainOneGeneration() on a SyntheticLearningEnvironment.
+ *
+ * The arguments are the number of roots of the TPGGraph, the maximum number
+ * of lines of its Program, and the number of threads of the
+ * ParallelLearningAgent.
+ */
+static void BM_TrainOneGeneration(benchmark::State& state)
+{
+    const size_t nbRoots = state.range(0);
+    const size_t programSize = state.range(1);
+    const size_t nbThreads = state.range(2);
+
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    Instructions::LambdaInstruction<double, double> max(
+        [](double a, double b) { return std::max(a, b); });
+    set.add(add);
+    set.add(sub);
+    set.add(max);
+
+    Learn::LearningParameters params;
+    params.mutation.tpg.nbRoots = nbRoots;
+    params.mutation.tpg.maxInitOutgoingEdges = 3;
+    params.mutation.tpg.maxOutgoingEdges = 5;
+    params.mutation.prog.maxProgramSize = programSize;
+    params.mutation.tpg.pEdgeDeletion = 0.7;
+    params.mutation.tpg.pEdgeAddition = 0.7;
+    params.mutation.tpg.pProgramMutation = 0.2;
+    params.mutation.tpg.pEdgeDestinationChange = 0.1;
+    params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+    params.mutation.prog.pAdd = 0.5;
+    params.mutation.prog.pDelete = 0.5;
+    params.mutation.prog.pMutate = 1.0;
+    params.mutation.prog.pSwap = 1.0;
+    params.nbIterationsPerPolicyEvaluation = 2;
+    params.nbThreads = nbThreads;
+
+    SyntheticLearningEnvironment le(4);
+    Learn::ParallelLearningAgent la(le, set, params);
+    la.init(0);
+
+    uint64_t generation = 0;
+    for (auto _ : state) {
+        la.trainOneGeneration(generation++);
+    }
+}
+BENCHMARK(BM_TrainOneGeneration)
+    ->ArgsProduct({{64, 256}, {16, 96}, {1, 2, 4, 8}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,244 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "data/dataHandler.h"
+#include "data/primitiveTypeArray.h"
+#include "environment.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/doubleOperationInstruction.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "mutator/lineMutator.h"
+#include "mutator/rng.h"
+#include "program/compiledProgram.h"
+#include "program/laneEvaluator.h"
+#include "program/nativeProgram.h"
+#include "program/program.h"
+#include "program/programExecutionEngine.h"
+
+/**
+ * \brief Cost of the copy of a Program, as done when mutating the Program
+ * of a TPGEdge.
+ *
+ * The argument is the number of lines of the copied Program.
+ */
+static void BM_ProgramCopy(benchmark::State& state)
+{
+    const size_t nbLines = state.range(0);
+
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    set.add(add);
+    set.add(sub);
+    Data::PrimitiveTypeArray<double> data(16);
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    Environment env(set, dataSources, 8, 2);
+
+    Mutator::RNG rng(0);
+    Program::Program prog(env);
+    for (size_t i = 0; i < nbLines; i++) {
+        Mutator::LineMutator::initRandomCorrectLine(prog.addNewLine(), rng);
+    }
+
+    for (auto _ : state) {
+        Program::Program copy(prog);
+        benchmark::DoNotOptimize(&copy);
+    }
+}
+BENCHMARK(BM_ProgramCopy)->RangeMultiplier(4)->Range(16, 1024);
+
+/**
+ * \brief Cost of ProgramExecutionEngine::executeProgram(), as done for each
+ * bid of a TPGEdge during inference.
+ *
+ * The argument is the number of lines of the executed Program.
+ */
+static void BM_ExecuteProgram(benchmark::State& state)
+{
+    const size_t nbLines = state.range(0);
+
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    set.add(add);
+    set.add(sub);
+    Data::PrimitiveTypeArray<double> data(16);
+    for (size_t i = 0; i < 16; i++) {
+        data.setDataAt(typeid(double), i, (double)i);
+    }
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    Environment env(set, dataSources, 8, 2);
+
+    Mutator::RNG rng(0);
+    Program::Program prog(env);
+    for (size_t i = 0; i < nbLines; i++) {
+        Mutator::LineMutator::initRandomCorrectLine(prog.addNewLine(), rng);
+    }
+    prog.identifyIntrons();
+
+    Program::ProgramExecutionEngine pee(prog);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pee.executeProgram());
+    }
+
+    state.SetItemsProcessed(state.iterations() * nbLines);
+}
+BENCHMARK(BM_ExecuteProgram)->RangeMultiplier(4)->Range(16, 1024);
+
+/**
+ * \brief Cost of the execution of a Program translated into native code,
+ * compared to its CompiledProgram.
+ *
+ * The first argument is the number of lines of the executed Program, the
+ * second selects the execution of the CompiledProgram (0) or of the
+ * NativeProgram (1).
+ */
+static void BM_ExecuteNativeProgram(benchmark::State& state)
+{
+    const size_t nbLines = state.range(0);
+    const bool useNative = state.range(1) != 0;
+
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::DoubleOperationInstruction sub(
+        Program::DoubleOperation::Opcode::SUB);
+    set.add(add);
+    set.add(sub);
+    Data::PrimitiveTypeArray<double> data(16);
+    for (size_t i = 0; i < 16; i++) {
+        data.setDataAt(typeid(double), i, (double)i);
+    }
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    Environment env(set, dataSources, 8, 0);
+
+    Mutator::RNG rng(0);
+    Program::Program prog(env);
+    for (size_t i = 0; i < nbLines; i++) {
+        Mutator::LineMutator::initRandomCorrectLine(prog.addNewLine(), rng);
+    }
+    prog.identifyIntrons();
+    Program::CompiledProgram compiled(prog);
+    Program::NativeProgram native(compiled);
+
+    Program::ProgramExecutionEngine pee(prog);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(useNative
+                                     ? pee.executeNativeProgram(native)
+                                     : pee.executeCompiledProgram(compiled));
+    }
+
+    state.counters["native"] = native.isNative() ? 1.0 : 0.0;
+    state.SetItemsProcessed(state.iterations() * nbLines);
+}
+BENCHMARK(BM_ExecuteNativeProgram)
+    ->ArgsProduct({{16, 64, 256, 1024}, {0, 1}});
+
+/**
+ * \brief Cost of the evaluation of the 16 Program of a team in SIMD lanes,
+ * compared to their interpretation.
+ *
+ * The first argument is the number of lines of each Program, the second
+ * selects the interpretation of each Program (-1) or the
+ * Program::LaneEvaluator::InstructionSet used for the evaluation in lanes.
+ */
+static void BM_LaneEvaluator(benchmark::State& state)
+{
+    const size_t nbLines = state.range(0);
+    const int64_t instructionSet = state.range(1);
+    const size_t nbPrograms = 16;
+    if (instructionSet >= 0 &&
+        !Program::LaneEvaluator::isSupported(
+            (Program::LaneEvaluator::InstructionSet)instructionSet)) {
+        state.SkipWithError("InstructionSet not supported.");
+        return;
+    }
+
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::DoubleOperationInstruction sub(
+        Program::DoubleOperation::Opcode::SUB);
+    set.add(add);
+    set.add(sub);
+    Data::PrimitiveTypeArray<double> data(16);
+    for (size_t i = 0; i < 16; i++) {
+        data.setDataAt(typeid(double), i, (double)i);
+    }
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    Environment env(set, dataSources, 8, 0);
+
+    Mutator::RNG rng(0);
+    std::vector<Program::Program> programs(nbPrograms, Program::Program(env));
+    std::vector<const Program::Program*> pointers;
+    for (Program::Program& prog : programs) {
+        for (size_t i = 0; i < nbLines; i++) {
+            Mutator::LineMutator::initRandomCorrectLine(prog.addNewLine(),
+                                                        rng);
+        }
+        prog.identifyIntrons();
+        pointers.push_back(&prog);
+    }
+
+    std::vector<double> bids(nbPrograms);
+    Program::ProgramExecutionEngine pee(env);
+    if (instructionSet < 0) {
+        for (auto _ : state) {
+            for (size_t i = 0; i < nbPrograms; i++) {
+                pee.setProgram(programs[i]);
+                bids[i] = pee.executeProgram();
+            }
+            benchmark::DoNotOptimize(bids.data());
+        }
+    }
+    else {
+        Program::LaneEvaluator evaluator(
+            pointers, (Program::LaneEvaluator::InstructionSet)instructionSet);
+        for (auto _ : state) {
+            evaluator.evaluate(dataSources, bids.data());
+            benchmark::DoNotOptimize(bids.data());
+        }
+        state.counters["evaluable"] = evaluator.isEvaluable() ? 1.0 : 0.0;
+    }
+
+    state.SetItemsProcessed(state.iterations() * nbPrograms * nbLines);
+}
+BENCHMARK(BM_LaneEvaluator)->ArgsProduct({{16, 64, 256}, {-1, 0, 1, 2}});
@@ -0,0 +1,300 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+#include "archive.h"
+#include "data/dataHandler.h"
+#include "data/primitiveTypeArray.h"
+#include "environment.h"
+#include "file/tpgGraphDotExporter.h"
+#include "file/tpgGraphDotImporter.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/rng.h"
+#include "mutator/tpgMutator.h"
+#include "tpg/tpgArenaFactory.h"
+#include "tpg/tpgExecutionEngine.h"
+#include "tpg/tpgGraph.h"
+#include "tpg/tpgTeam.h"
+#include "util/threadPool.h"
+
+/// Number of actions of the TPGGraph built by the benchmarks.
+static const uint64_t NB_ACTIONS = 8;
+
+/**
+ * \brief Fixture-like holder of an Environment for TPG benchmarks.
+ */
+struct TPGBenchmarkEnvironment
+{
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub{
+        [](double a, double b) { return a - b; }};
+    Data::PrimitiveTypeArray<double> data{16};
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    std::unique_ptr<Environment> env;
+
+    TPGBenchmarkEnvironment()
+    {
+        set.add(add);
+        set.add(sub);
+        for (size_t i = 0; i < 16; i++) {
+            data.setDataAt(typeid(double), i, (double)i);
+        }
+        env = std::make_unique<Environment>(set, dataSources, 8, 2);
+    }
+};
+
+/**
+ * \brief Get MutationParameters for a TPGGraph with the given number of
+ * roots and Program size.
+ */
+static Mutator::MutationParameters getMutationParameters(size_t nbRoots,
+                                                         size_t programSize)
+{
+    Mutator::MutationParameters params;
+    params.tpg.initNbRoots = NB_ACTIONS;
+    params.tpg.nbRoots = nbRoots;
+    params.tpg.maxInitOutgoingEdges = 3;
+    params.tpg.maxOutgoingEdges = 5;
+    params.prog.maxProgramSize = programSize;
+    // Proba as in Kelly's paper
+    params.tpg.pEdgeDeletion = 0.7;
+    params.tpg.pEdgeAddition = 0.7;
+    params.tpg.pProgramMutation = 0.2;
+    params.tpg.pEdgeDestinationChange = 0.1;
+    params.tpg.pEdgeDestinationIsAction = 0.5;
+    params.prog.pAdd = 0.5;
+    params.prog.pDelete = 0.5;
+    params.prog.pMutate = 1.0;
+    params.prog.pSwap = 1.0;
+    params.prog.pConstantMutation = 0.5;
+    params.prog.minConstValue = 0;
+    params.prog.maxConstValue = 10;
+    return params;
+}
+
+/**
+ * \brief Remove half of the root TPGTeam of a TPGGraph, as the LearningAgent
+ * does with the worst roots of each generation.
+ */
+static void removeHalfRootTeams(TPG::TPGGraph& tpg)
+{
+    std::vector<const TPG::TPGVertex*> rootTeams;
+    for (const TPG::TPGVertex* root : tpg.getRootVertices()) {
+        if (dynamic_cast<const TPG::TPGTeam*>(root) != nullptr) {
+            rootTeams.push_back(root);
+        }
+    }
+    for (size_t idx = 0; idx < rootTeams.size() / 2; idx++) {
+        tpg.removeVertex(*rootTeams.at(idx));
+    }
+}
+
+/**
+ * \brief Build a TPGGraph with the given number of roots, by successive
+ * generations of root deletion and population.
+ */
+static void buildTPGGraph(TPG::TPGGraph& tpg,
+                          const Mutator::MutationParameters& params,
+                          size_t nbGenerations)
+{
+    Mutator::RNG rng(0);
+    Archive archive;
+    Mutator::TPGMutator::initRandomTPG(tpg, params, rng, NB_ACTIONS);
+    for (size_t generation = 0; generation < nbGenerations; generation++) {
+        Mutator::TPGMutator::populateTPG(tpg, archive, params, rng,
+                                         NB_ACTIONS, 0);
+        // Remove half of the roots to grow the depth of the graph.
+        removeHalfRootTeams(tpg);
+    }
+    Mutator::TPGMutator::populateTPG(tpg, archive, params, rng, NB_ACTIONS, 0);
+}
+
+/**
+ * \brief Cost of TPGExecutionEngine::executeFromRoot() for all roots of a
+ * TPGGraph.
+ *
+ * The arguments are the number of roots of the TPGGraph and the maximum
+ * number of lines of its Program.
+ */
+static void BM_TPGExecuteFromRoot(benchmark::State& state)
+{
+    const size_t nbRoots = state.range(0);
+    const size_t programSize = state.range(1);
+
+    TPGBenchmarkEnvironment be;
+    TPG::TPGGraph tpg(*be.env);
+    buildTPGGraph(tpg, getMutationParameters(nbRoots, programSize), 5);
+    const auto roots = tpg.getRootVertices();
+
+    TPG::TPGExecutionEngine tee(*be.env);
+    for (auto _ : state) {
+        for (const TPG::TPGVertex* root : roots) {
+            benchmark::DoNotOptimize(tee.executeFromRoot(*root));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * roots.size());
+}
+BENCHMARK(BM_TPGExecuteFromRoot)
+    ->ArgsProduct({{16, 64, 256, 1024}, {16, 96}});
+
+/**
+ * \brief Cost of TPGMutator::populateTPG() after the deletion of half of the
+ * roots of a TPGGraph.
+ *
+ * The counter-based engine is used, so that both the structural mutation of
+ * teams and the mutation of Program behaviors use the threads. The arguments
+ * are the number of roots of the TPGGraph and the number of threads.
+ */
+static void BM_TPGMutatorPopulateTPG(benchmark::State& state)
+{
+    const size_t nbRoots = state.range(0);
+    const uint64_t nbThreads = state.range(1);
+
+    TPGBenchmarkEnvironment be;
+    const Mutator::MutationParameters params =
+        getMutationParameters(nbRoots, 32);
+    Util::ThreadPool pool(nbThreads);
+    Archive archive;
+    Mutator::RNG rng(0, Mutator::RNG::EngineType::PHILOX_4X32);
+
+    TPG::TPGGraph tpg(*be.env);
+    Mutator::TPGMutator::initRandomTPG(tpg, params, rng, NB_ACTIONS);
+    for (auto _ : state) {
+        state.PauseTiming();
+        removeHalfRootTeams(tpg);
+        state.ResumeTiming();
+
+        Mutator::TPGMutator::populateTPG(tpg, archive, params, rng,
+                                         NB_ACTIONS, nbThreads, &pool);
+    }
+}
+BENCHMARK(BM_TPGMutatorPopulateTPG)
+    ->ArgsProduct({{64, 256, 1024}, {1, 2, 4, 8}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * \brief Cost of allocations in a TPGArena shared by concurrent threads.
+ *
+ * Each iteration allocates, then releases, a batch of slots of the sizes of
+ * TPGGraph elements, as the threads mutating Program in
+ * TPGMutator::populateTPG() do. The argument is the number of slots of the
+ * batch.
+ */
+static void BM_TPGArenaContention(benchmark::State& state)
+{
+    static TPG::TPGArena arena;
+    static const size_t sizes[] = {48, 112, 176, 400};
+    const size_t nbSlots = state.range(0);
+
+    std::vector<void*> slots(nbSlots);
+    for (auto _ : state) {
+        for (size_t i = 0; i < nbSlots; i++) {
+            slots[i] = arena.allocate(sizes[i % 4]);
+        }
+        benchmark::DoNotOptimize(slots.data());
+        for (size_t i = nbSlots; i > 0; i--) {
+            arena.deallocate(slots[i - 1], sizes[(i - 1) % 4]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * nbSlots);
+}
+BENCHMARK(BM_TPGArenaContention)
+    ->Arg(64)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+/**
+ * \brief Cost of the export of a TPGGraph with the TPGGraphDotExporter.
+ *
+ * The argument is the number of roots of the TPGGraph.
+ */
+static void BM_TPGGraphDotExport(benchmark::State& state)
+{
+    const size_t nbRoots = state.range(0);
+
+    TPGBenchmarkEnvironment be;
+    TPG::TPGGraph tpg(*be.env);
+    buildTPGGraph(tpg, getMutationParameters(nbRoots, 32), 5);
+
+    for (auto _ : state) {
+        File::TPGGraphDotExporter exporter("benchmark_tpg.dot", tpg);
+        exporter.print();
+    }
+
+    state.SetItemsProcessed(state.iterations() * tpg.getNbVertices());
+}
+BENCHMARK(BM_TPGGraphDotExport)
+    ->RangeMultiplier(4)
+    ->Range(16, 256)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * \brief Cost of the import of a TPGGraph with the TPGGraphDotImporter.
+ *
+ * The argument is the number of roots of the imported TPGGraph.
+ */
+static void BM_TPGGraphDotImport(benchmark::State& state)
+{
+    const size_t nbRoots = state.range(0);
+
+    TPGBenchmarkEnvironment be;
+    TPG::TPGGraph tpg(*be.env);
+    buildTPGGraph(tpg, getMutationParameters(nbRoots, 32), 5);
+    {
+        File::TPGGraphDotExporter exporter("benchmark_tpg.dot", tpg);
+        exporter.print();
+    }
+
+    TPG::TPGGraph importedTPG(*be.env);
+    File::TPGGraphDotImporter importer("benchmark_tpg.dot", *be.env,
+                                       importedTPG);
+    for (auto _ : state) {
+        importer.importGraph();
+    }
+
+    state.SetItemsProcessed(state.iterations() * tpg.getNbVertices());
+}
+BENCHMARK(BM_TPGGraphDotImport)
+    ->RangeMultiplier(4)
+    ->Range(16, 256)
+    ->Unit(benchmark::kMillisecond);
@@ -41,6 +41,7 @@
 #include <map>
 #include <memory>
 #include <random>
+#include <unordered_map>
 
 #include "data/dataHandler.h"
 #include "mutator/rng.h"
@@ -107,6 +108,17 @@ class Archive
              std::vector<std::reference_wrapper<const Data::DataHandler>>>
         dataHandlers;
 
+    /**
+     * \brief Number of recordings referencing each entry of the
+     * dataHandlers.
+     *
+     * When the count of a hash drops to zero, the corresponding copies of
+     * DataHandler are freed and removed from the dataHandlers. This hash
+     * table is also used for the lookups of hashes, which do not depend on
+     * the order of the dataHandlers.
+     */
+    std::unordered_map<size_t, size_t> nbRecordingsPerDataHandlers;
+
     /**
      * \brief Map storing the Program pointers referenced in recordings the
      * associated recording.
@@ -117,12 +129,83 @@ class Archive
      *
      * The Map is used to speed the unicity tests.
      */
-    std::map<const Program::Program*, std::deque<ArchiveRecording>>
+    std::unordered_map<const Program::Program*, std::deque<ArchiveRecording>>
         recordingsPerProgram;
 
     /// Recordings of the Archive
     std::deque<ArchiveRecording> recordings;
 
+    /**
+     * \brief Width of the result intervals used to index recordings.
+     *
+     * Results of recordings are quantized with this resolution to build the
+     * resultsIndex. Uniqueness checks with a tau margin that spans more than
+     * MAX_INDEXED_TAU_RATIO intervals fall back to a scan of all Program of
+     * the Archive.
+     */
+    const double resultsIndexResolution;
+
+    /// Maximum ratio between tau and the resultsIndexResolution for which the
+    /// resultsIndex is used by areProgramResultsUnique.
+    static constexpr double MAX_INDEXED_TAU_RATIO = 16.0;
+
+    /// Key of the resultsIndex: a DataHandler hash and a quantized result.
+    typedef std::pair<size_t, int64_t> ResultsIndexKey;
+
+    /// Hash function for the ResultsIndexKey.
+    struct ResultsIndexKeyHash
+    {
+        size_t operator()(const ResultsIndexKey& key) const
+        {
+            return key.first ^ (std::hash<int64_t>()(key.second) +
+                                0x9e3779b97f4a7c15 + (key.first << 6) +
+                                (key.first >> 2));
+        }
+    };
+
+    /**
+     * \brief Behavior-signature index of the recordings.
+     *
+     * For each DataHandler hash and each quantized result, this map stores
+     * the Program having at least a recording within the corresponding
+     * interval, with the number of such recordings.
+     *
+     * The index is used by areProgramResultsUnique to only check Program
+     * that produced a result close to one of the tested results, instead of
+     * all the Program of the Archive. Recordings whose result is not finite
+     * are not indexed, as they can never be equal to another result.
+     */
+    std::unordered_map<ResultsIndexKey,
+                       std::unordered_map<const Program::Program*, size_t>,
+                       ResultsIndexKeyHash>
+        resultsIndex;
+
+    /**
+     * \brief Get the index of the interval containing the given result in
+     * the resultsIndex.
+     *
+     * Results too large to be represented are saturated to the first or last
+     * interval.
+     *
+     * \param[in] result the finite result whose interval is computed.
+     */
+    int64_t getResultsIndexInterval(double result) const;
+
+    /**
+     * \brief Check if the recordings of a Program are equivalent to the given
+     * hash-results pairs.
+     *
+     * \param[in] programRecordings the recordings of a Program.
+     * \param[in] hashesAndResults the hash-results pairs to compare to.
+     * \param[in] tau the margin within which results are equal.
+     * \return true if at least one recording has a hash contained in the
+     * map, and if all such recordings are associated to results equal to
+     * those of the map.
+     */
+    static bool areRecordingsEquivalent(
+        const std::deque<ArchiveRecording>& programRecordings,
+        const std::map<size_t, double>& hashesAndResults, double tau);
+
     /**
      * \brief Probability of adding any program execution to the archive.
      */
@@ -136,11 +219,15 @@ class Archive
      * addRecording to actually lead to a new recodring in the Archive.
      * \param[in] size maximum number of recordings kept in the Archive.
      * \param[in] initialSeed Seed value for the randomEngine.
+     * \param[in] resultsIndexResolution width of the intervals used to index
+     * the results of recordings. For best performance, it should be equal to
+     * the tau margin used when calling areProgramResultsUnique.
      */
     Archive(size_t size = 50, double archivingProbability = 1.0,
-            size_t initialSeed = 0)
+            size_t initialSeed = 0, double resultsIndexResolution = 1e-4)
         : archivingProbability{archivingProbability}, maxSize{size},
-          recordings(), rng(initialSeed){};
+          recordings(), rng(initialSeed),
+          resultsIndexResolution{resultsIndexResolution} {};
 
     /**
      * Disable Archive copy construction.
@@ -193,7 +280,8 @@ class Archive
      * probability specified by the archivingProbability attribute unless it is
      * forced, in which case the recording is added without randomness.
      * If the maximum number of recordings held in the archive is reached, the
-     * oldest recording will be removed.
+     * oldest recording will be removed. Insertion and eviction of recordings
+     * have a constant amortized cost, whatever the size of the Archive.
      * If this is the first time this set of DataHandler is stored in the
      * Archive according to its DataHandler::getHash() method, a copy of the
      * dataHandler will be created.
@@ -230,6 +318,13 @@ class Archive
      * for which all recordings with hashes contained in the given map, are
      * associated to results equal to those of the given map (within tau
      * margin).
+     *
+     * When tau is not larger than MAX_INDEXED_TAU_RATIO times the
+     * resultsIndexResolution, and when the number of given hash-results pairs
+     * is small compared to the number of recordings in the Archive, only the
+     * Program with a recording close to one of the given results are checked,
+     * using the resultsIndex. Otherwise, all Program of the Archive are
+     * checked, until one is found equivalent.
      */
     virtual bool areProgramResultsUnique(
         const std::map<size_t, double>& hashesAndResults,
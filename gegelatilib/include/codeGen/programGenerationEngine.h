@@ -39,6 +39,9 @@
 #ifndef PROGRAM_GENERATION_ENGINE_H
 #define PROGRAM_GENERATION_ENGINE_H
 #include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "data/dataHandlerPrinter.h"
 #include "data/primitiveTypeArray.h"
@@ -58,6 +61,24 @@ namespace CodeGen {
      * In the generated code, inclusion of externHeader.h allows including
      * necessary headers (like math.h) to compile the generated code without
      * modifying it.
+     *
+     * By default, generated Program read their inputs from global variables
+     * and are not reentrant. In reentrant mode, the inputs and the registers
+     * are instead gathered in a TPGContext struct declared in the generated
+     * header, and each Program takes a pointer to this struct as a
+     * parameter. Programs can then be executed concurrently, as long as each
+     * concurrent execution uses its own TPGContext.
+     *
+     * In batch mode, the generated header also declares an in_t struct
+     * holding the inputs of one sample, and generateBatchProgram() generates
+     * functions evaluating a Program over a set of samples.
+     *
+     * The generateTeamBids() method generates a single function computing
+     * the bids of all the Program of a team. Lines of these Program are
+     * value-numbered together: identical computations on the same inputs
+     * are computed once in shared temporaries, lines whose operands are all
+     * known at generation time are folded into literals, and lines not
+     * contributing to any bid are not generated.
      */
     class ProgramGenerationEngine : public Program::ProgramEngine
     {
@@ -84,6 +105,70 @@ namespace CodeGen {
         /// name of the temporary operand used in the TPG's programs.
         static const std::string nameOperandVariable;
 
+        /// name of the context struct type in reentrant mode.
+        static const std::string nameContextType;
+
+        /// name of the context parameter of the programs in reentrant mode.
+        static const std::string nameContextVariable;
+
+        /// Whether the generated programs take a TPGContext parameter.
+        const bool reentrant;
+
+        /// name of the struct type holding the inputs of a sample in batch
+        /// mode.
+        static const std::string nameBatchInputType;
+
+        /// name of the pointer to the current sample in batch programs.
+        static const std::string nameBatchInputVariable;
+
+        /// Whether the in_t struct is declared for batch programs.
+        const bool batch;
+
+        /// Whether a batch program is being generated.
+        bool batchGeneration;
+
+        /// Operand of an OptimizedValue.
+        struct OptimizedOperand
+        {
+            /// Origin of the operand.
+            enum class Kind
+            {
+                /// Another OptimizedValue, identified by its index.
+                VALUE,
+                /// A Data::Constant of the Program, identified by its value.
+                CONSTANT,
+                /// Environment data, identified by the index of its data
+                /// source and by its scaled location.
+                DATA
+            } kind;
+
+            /// Index of the OptimizedValue, constant value or data source
+            /// index, depending on the kind of the operand.
+            int64_t id;
+
+            /// Scaled location of DATA operands.
+            uint64_t location;
+
+            /// Type of the operand, as required by the Instruction.
+            const std::type_info* type;
+        };
+
+        /// Value computed by the Program of a team, see generateTeamBids().
+        struct OptimizedValue
+        {
+            /// Whether the value is known at generation time.
+            bool isLiteral;
+
+            /// Value known at generation time.
+            double literal;
+
+            /// Instruction computing the value, if not a literal.
+            const Instructions::Instruction* instruction;
+
+            /// Operands of the instruction, if not a literal.
+            std::vector<OptimizedOperand> operands;
+        };
+
         /// The file in which programs will be added.
         std::ofstream fileC;
         /// The file in which prototypes of programs will be added.
@@ -113,11 +198,20 @@ namespace CodeGen {
          * \param[in] path a const reference to the path in which the file must
          * be generated. By default, the file is generated in the current
          * directory.
+         *
+         * \param[in] reentrant whether the generated programs access their
+         * inputs and registers through a TPGContext parameter instead of
+         * global variables.
+         *
+         * \param[in] batch whether the in_t struct is declared in the header
+         * to generate batch programs with generateBatchProgram().
          */
         ProgramGenerationEngine(const std::string& filename,
                                 const Environment& env,
-                                const std::string& path = "./")
-            : ProgramEngine(env), dataPrinter()
+                                const std::string& path = "./",
+                                bool reentrant = false, bool batch = false)
+            : ProgramEngine(env), reentrant{reentrant}, batch{batch},
+              batchGeneration{false}, dataPrinter()
         {
             openFile(filename, path, env.getNbConstant());
         }
@@ -139,11 +233,17 @@ namespace CodeGen {
          *
          * \param[in] path const reference to the path in which the file is
          * generated
+         *
+         * \param[in] reentrant see the other constructor.
+         *
+         * \param[in] batch see the other constructor.
          */
         ProgramGenerationEngine(const std::string& filename,
                                 const Program::Program& p,
-                                const std::string& path = "./")
-            : ProgramEngine(p), dataPrinter()
+                                const std::string& path = "./",
+                                bool reentrant = false, bool batch = false)
+            : ProgramEngine(p), reentrant{reentrant}, batch{batch},
+              batchGeneration{false}, dataPrinter()
         {
             openFile(filename, path, p.getEnvironment().getNbConstant());
             setProgram(p);
@@ -161,6 +261,12 @@ namespace CodeGen {
             fileH.close();
         }
 
+        /// Whether the generated programs take a TPGContext parameter.
+        bool isReentrant() const;
+
+        /// Whether the in_t struct is declared for batch programs.
+        bool isBatch() const;
+
         /**
          * \brief Generate the current line of the program.
          *
@@ -176,8 +282,8 @@ namespace CodeGen {
          * Print a function in the file "filename"_program.c that regroups all
          * the instruction of the program and return a double. The name of the
          * printed function is based on the identifier of the program. The
-         * declaration of function of the program with ID=1 is double P1(int*
-         * action)
+         * declaration of function of the program with ID=1 is double P1(),
+         * or double P1(TPGContext* ctx) in reentrant mode.
          *
          * \param[in] progID : unique identifier of the program used to generate
          *            the name of the function in the C file.
@@ -192,7 +298,101 @@ namespace CodeGen {
         void generateProgram(uint64_t progID,
                              const bool ignoreException = false);
 
+        /**
+         * \brief Generate the C code evaluating the member program of the
+         * class over a set of samples.
+         *
+         * Print a function void P<progID>Batch(const in_t* inputs, const int*
+         * samples, int n, double* bids) in the file "filename"_program.c. For
+         * each i < n, the function stores in bids[i] the result of the
+         * program for the sample inputs[samples[i]]. Each iteration of the
+         * loop over the samples uses its own registers, so that the C
+         * compiler can vectorize it.
+         *
+         * \param[in] progID : unique identifier of the program, as given to
+         *            generateProgram().
+         * \param[in] ignoreException see generateProgram().
+         * \throw std::runtime_error if the engine is not in batch mode.
+         */
+        void generateBatchProgram(uint64_t progID,
+                                  const bool ignoreException = false);
+
+        /**
+         * \brief Whether a Program can be part of the function generated by
+         * generateTeamBids().
+         *
+         * Program whose lines read arrays from the registers, or constants
+         * with a type other than Data::Constant, cannot be value-numbered.
+         * They must be generated with generateProgram() before their team,
+         * and their function is called by the function of the team.
+         *
+         * \param[in] p the Program to check.
+         * \return true if the Program can be value-numbered.
+         */
+        bool isOptimizable(const Program::Program& p);
+
+        /**
+         * \brief Generate a function computing the bids of all the Program
+         * of a team.
+         *
+         * Print a function void T<teamID>Bids(double* bids) in the file
+         * "filename"_program.c, or void T<teamID>Bids(TPGContext* ctx,
+         * double* bids) in reentrant mode.
+         *
+         * \param[in] teamID unique identifier of the team, used to generate
+         * the name of the function.
+         * \param[in] programs the Program of the team, each with the index
+         * in bids where its result is stored.
+         * \throw std::invalid_argument if a Program does not satisfy
+         * isOptimizable().
+         * \throw std::runtime_error if an Instruction is not printable.
+         */
+        void generateTeamBids(
+            uint64_t teamID,
+            const std::vector<std::pair<const Program::Program*, uint64_t>>&
+                programs);
+
       protected:
+        /**
+         * \brief Value-number the non-intron lines of a Program.
+         *
+         * \param[in] p the Program to analyze, which must satisfy
+         * isOptimizable(). It becomes the current Program of the engine.
+         * \param[in,out] values the values computed by the Program are
+         * appended to this vector, unless an identical value is already
+         * present.
+         * \param[in,out] index map from the keys of the values to their index
+         * in values.
+         * \return the index of the value of register 0 at the end of the
+         * Program.
+         * \throw std::runtime_error if an Instruction is not printable.
+         */
+        uint64_t analyzeProgram(
+            const Program::Program& p, std::vector<OptimizedValue>& values,
+            std::unordered_map<std::string, uint64_t>& index);
+
+        /**
+         * \brief Get the C expression of an OptimizedValue.
+         *
+         * \param[in] values the values of a team.
+         * \param[in] idx the index of the value.
+         * \return the literal of the value, or the name of its temporary.
+         */
+        static std::string printValue(const std::vector<OptimizedValue>& values,
+                                      uint64_t idx);
+
+        /**
+         * \brief Replace the operands of the printTemplate of an
+         * Instruction.
+         *
+         * \param[in] instruction the Instruction to print.
+         * \param[in] destination the C expression replacing $0.
+         * \return a copy of the printTemplate where $0 is replaced with
+         * destination and $i with the i-th operand variable.
+         */
+        std::string formatTemplate(const Instructions::Instruction& instruction,
+                                   const std::string& destination) const;
+
         /**
          * \brief Set global variables in the file holding the programs.
          *
@@ -201,6 +401,13 @@ namespace CodeGen {
          * type of the global variable accordingly to the type of the data
          * sources of the Environment of the printed Program.
          *
+         * In reentrant mode, the inputs are instead declared as members of
+         * the TPGContext struct printed in the header, along with the
+         * registers.
+         *
+         * In batch mode, the in_t struct holding the inputs of a sample is
+         * printed in the header.
+         *
          * \param[in] nbConstant size_t of the number of Data::Constant
          * available for a Program.
          */
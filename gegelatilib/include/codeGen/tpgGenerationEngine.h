@@ -118,10 +118,21 @@ namespace CodeGen {
          *
          * \param[in] path to the folder in which the file are generated. If the
          * folder does not exist.
+         *
+         * \param[in] reentrant whether the Program of the TPGGraph are
+         * generated in the reentrant mode of the ProgramGenerationEngine. In
+         * this mode, the header of the main file includes the header of the
+         * programs, where the TPGContext struct is declared.
+         *
+         * \param[in] batch whether the Program of the TPGGraph are
+         * generated in the batch mode of the ProgramGenerationEngine. In this
+         * mode, the header of the main file includes the header of the
+         * programs, where the in_t struct is declared.
          */
         TPGGenerationEngine(const std::string& filename,
                             const TPG::TPGGraph& tpg,
-                            const std::string& path = "./");
+                            const std::string& path = "./",
+                            bool reentrant = false, bool batch = false);
 
         /**
          * \brief destructor of the class.
@@ -55,7 +55,16 @@ namespace CodeGen {
         enum generationEngineMode
         {
             stackMode,
-            switchMode
+            switchMode,
+            /// switchMode generating reentrant code, see
+            /// TPGSwitchGenerationEngine.
+            reentrantSwitchMode,
+            /// switchMode also generating a batch inference function, see
+            /// TPGSwitchGenerationEngine.
+            batchSwitchMode,
+            /// switchMode generating optimized code, see
+            /// TPGSwitchGenerationEngine.
+            optimizedSwitchMode
         };
 
         /**
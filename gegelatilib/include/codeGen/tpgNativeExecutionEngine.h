@@ -0,0 +1,218 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifdef CODE_GENERATION
+
+#ifndef TPG_NATIVE_EXECUTION_ENGINE_H
+#define TPG_NATIVE_EXECUTION_ENGINE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tpg/tpgExecutionEngine.h"
+#include "tpg/tpgGraph.h"
+
+namespace CodeGen {
+    /**
+     * \brief TPGExecutionEngine executing a TPGGraph with native code compiled
+     * in-process.
+     *
+     * The compile() method generates the C code of all TPGTeam reachable
+     * from the given roots, using the ProgramGenerationEngine for their
+     * Program, compiles it with the C compiler of the system into a shared
+     * library, and loads this library in the process. The generated code
+     * reads the data of the DataHandler of the Environment directly, so that
+     * the native inference always uses the current state of the
+     * LearningEnvironment.
+     *
+     * The executeFromRoot() method uses the native code for compiled roots
+     * and returns the same trace of visited TPGVertex as the
+     * TPGExecutionEngine. It falls back to the interpretation of the
+     * TPGGraph when:
+     * - the root was not compiled,
+     * - the compilation failed, for example because no C compiler is
+     *   available or because an Instruction is not printable,
+     * - an Archive is set, since native Program executions are not recorded,
+     * - the platform does not support the dynamic loading of libraries.
+     *
+     * Native code can only access DataHandler whose data of the native type
+     * is stored contiguously, like the PrimitiveTypeArray and ArrayWrapper
+     * classes and their 2D counterparts. The compiled code remains valid as
+     * long as the TPGGraph and its Program are not modified.
+     */
+    class TPGNativeExecutionEngine : public TPG::TPGExecutionEngine
+    {
+      protected:
+        /**
+         * \brief Signature of the generated inference function.
+         *
+         * The function returns the number of visited TPGVertex written in the
+         * trace, or -1 if the path from the root visits more TPGVertex than
+         * the TPGGraph holds, which only happens with a cycle.
+         */
+        typedef int (*InferenceFunction)(int root, int* trace);
+
+        /// Signature of the generated function setting a data source.
+        typedef void (*SetInputFunction)(int idx, const void* data);
+
+        /// TPGGraph executed by the engine.
+        const TPG::TPGGraph& tpg;
+
+        /// Data sources read by the native code.
+        std::vector<std::reference_wrapper<const Data::DataHandler>>
+            dataSources;
+
+        /// Command used to call the C compiler.
+        std::string compiler;
+
+        /// Directory where the code is generated and compiled.
+        std::string workingDirectory;
+
+        /// Number of shared libraries compiled by the engine.
+        uint64_t nbCompilations = 0;
+
+        /// Handle of the loaded shared library, or nullptr.
+        void* library = nullptr;
+
+        /// Generated inference function, or nullptr.
+        InferenceFunction inferenceFunction = nullptr;
+
+        /// Generated function setting the pointer to a data source.
+        SetInputFunction setInputFunction = nullptr;
+
+        /// TPGVertex of the TPGGraph, indexed as in the generated code.
+        std::vector<const TPG::TPGVertex*> vertices;
+
+        /// Index of the compiled root TPGVertex in the generated code.
+        std::unordered_map<const TPG::TPGVertex*, int> compiledRoots;
+
+        /// Buffer receiving the indexes of visited TPGVertex.
+        std::vector<int> trace;
+
+        /**
+         * \brief Write the C code for the given roots in the working
+         * directory.
+         *
+         * \param[in] roots the root TPGVertex whose reachable TPGTeam are
+         * generated.
+         * \throw std::runtime_error if the code can not be generated.
+         */
+        void generateCode(const std::vector<const TPG::TPGVertex*>& roots);
+
+        /// Unload the shared library, if any, and forget compiled roots.
+        void unload();
+
+        /**
+         * \brief Check that the data of each data source of the Environment
+         * is stored contiguously, as exposed by
+         * DataHandler::getContiguousData() for its native type.
+         */
+        bool areDataSourcesContiguous() const;
+
+        /**
+         * \brief Update the pointers to the data sources in the native code.
+         *
+         * The pointers are fetched before each inference since the storage
+         * of a DataHandler may be reallocated.
+         */
+        void updateDataSources();
+
+      public:
+        /**
+         * \brief Main constructor of the class.
+         *
+         * \param[in] env Environment in which the Program of the TPGGraph
+         *                will be executed.
+         * \param[in] graph the TPGGraph executed by the engine.
+         * \param[in] arch pointer to the Archive for storing recordings of
+         *                 the Program Execution. When an Archive is set, the
+         *                 TPGGraph is always interpreted.
+         * \param[in] compiler command used to call the C compiler. When
+         *                 empty, the CC environment variable is used, or "cc"
+         *                 if it is not set. Words separated by whitespace are
+         *                 passed as separate arguments, as in "ccache gcc".
+         */
+        TPGNativeExecutionEngine(const Environment& env,
+                                 const TPG::TPGGraph& graph,
+                                 Archive* arch = NULL,
+                                 const std::string& compiler = "");
+
+        /// Unload the native code and remove the generated files.
+        virtual ~TPGNativeExecutionEngine();
+
+        /**
+         * \brief Generate, compile and load the native code for the given
+         * roots.
+         *
+         * Any previously compiled code is discarded.
+         *
+         * \param[in] roots the root TPGVertex to compile. All TPGTeam
+         *                  reachable from these roots are compiled.
+         * \return true if the native code was loaded, false otherwise, in
+         * which case the TPGGraph will be interpreted.
+         */
+        bool compile(const std::vector<const TPG::TPGVertex*>& roots);
+
+        /**
+         * \brief Generate, compile and load the native code for all the
+         * roots of the TPGGraph.
+         *
+         * \return true if the native code was loaded, false otherwise.
+         */
+        bool compile();
+
+        /**
+         * \brief Check whether executions from the given root use native
+         * code.
+         *
+         * \param[in] root the root TPGVertex.
+         * \return true if the root was compiled and no Archive is set.
+         */
+        bool isNative(const TPG::TPGVertex& root) const;
+
+        /**
+         * \brief Inherited from TPGExecutionEngine.
+         *
+         * \throw std::runtime_error if the native inference visits more
+         * TPGVertex than the TPGGraph holds, which means that the TPGGraph
+         * contains a cycle. The interpreted execution would never end.
+         */
+        virtual const std::vector<const TPG::TPGVertex*> executeFromRoot(
+            const TPG::TPGVertex& root) override;
+    };
+} // namespace CodeGen
+
+#endif // TPG_NATIVE_EXECUTION_ENGINE_H
+
+#endif // CODE_GENERATION
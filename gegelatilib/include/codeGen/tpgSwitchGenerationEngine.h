@@ -49,10 +49,37 @@ namespace CodeGen {
      * Each program of the TPGGraph is represented by a C function.
      * All the functions are regrouped in a file. Another file holds
      * the required functions to iterate through the TPGGraph.
+     *
+     * In reentrant mode, the generated inference function is
+     * `int inferenceTPG(TPGContext* ctx)`, where the TPGContext holds the
+     * inputs and the registers used by the programs (see
+     * ProgramGenerationEngine). Since the generated code has no other
+     * global state, inferences with distinct TPGContext can run concurrently.
+     *
+     * In batch mode, the engine also generates a
+     * `void inferenceTPGBatch(const in_t* inputs, int n, int* actions)`
+     * function, storing in actions[i] the action returned by the TPG for the
+     * sample inputs[i]. Samples are processed in blocks of
+     * TPG_BATCH_SIZE samples. Within a block, teams reachable from the root
+     * are visited in topological order, and each program of a team is
+     * evaluated over all the samples of the block that reached the team
+     * with its batch function (see
+     * ProgramGenerationEngine::generateBatchProgram()). Teams reached by no
+     * sample of the block are skipped.
+     *
+     * In optimized mode, only the vertices reachable from the first root of
+     * the TPGGraph are generated, and the bids of the programs of each team
+     * are computed by a single function generated with
+     * ProgramGenerationEngine::generateTeamBids(), sharing identical
+     * computations between the programs of the team and folding lines
+     * computed from constants only.
      */
     class TPGSwitchGenerationEngine : public CodeGen::TPGGenerationEngine
     {
       protected:
+        /// Whether the generated code is optimized, see class description.
+        const bool optimized;
+
         /**
          * \brief function printing generic code in the main file.
          *
@@ -83,11 +110,22 @@ namespace CodeGen {
          *
          * \param[in] path to the folder in which the file are generated. If the
          * folder does not exist.
+         *
+         * \param[in] reentrant whether the generated code is reentrant.
+         * \param[in] batch whether the inferenceTPGBatch() function is
+         * generated.
+         * \param[in] optimized whether the generated code is optimized.
          */
         TPGSwitchGenerationEngine(const std::string& filename,
                                   const TPG::TPGGraph& tpg,
-                                  const std::string& path = "./")
-            : TPGGenerationEngine(filename, tpg, path){};
+                                  const std::string& path = "./",
+                                  bool reentrant = false, bool batch = false,
+                                  bool optimized = false)
+            : TPGGenerationEngine(filename, tpg, path, reentrant, batch),
+              optimized{optimized} {};
+
+        /// Whether the generated code is optimized.
+        bool isOptimized() const;
 
         /**
          * \brief destructor of the class.
@@ -145,6 +183,23 @@ namespace CodeGen {
          */
         virtual void generateAction(const TPG::TPGAction& action);
 
+        /**
+         * \brief Method for generating the batch inference function.
+         *
+         * The generated function is inferenceTPGBatch(). It must be
+         * generated after all the programs of the TPGGraph.
+         */
+        void generateBatchInference();
+
+        /**
+         * \brief Get the vertices for which code is generated.
+         *
+         * \return all the vertices of the TPGGraph, or only those reachable
+         * from its first root in optimized mode. Vertices are in the order of
+         * TPG::TPGGraph::getVertices().
+         */
+        std::vector<const TPG::TPGVertex*> getGeneratedVertices() const;
+
         /**
          * \brief Generate function name depending on the vertex type.
          *
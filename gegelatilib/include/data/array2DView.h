@@ -0,0 +1,196 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef ARRAY_2D_VIEW_H
+#define ARRAY_2D_VIEW_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Data {
+    /**
+     * \brief Non-owning, strided view on a 2D sub-array.
+     *
+     * This class is specialized only for 2D c-style array types, for example
+     * Array2DView<const double[2][3]>. It gives access to a window of a
+     * larger 2D array, without copying it. The view holds a pointer to the
+     * first element of the window, and the stride, in number of elements,
+     * between the beginning of two consecutive lines of the window.
+     *
+     * An Array2DView can be used as a parameter of a
+     * Instructions::LambdaInstruction, in place of a 2D c-style array, to
+     * let the Instruction access windows of a Data::Array2DWrapper without
+     * copying them. Lines of the window are accessed with the [] operator,
+     * so that the syntax for accessing an element is the same as with
+     * c-style arrays:
+     * \code{.cpp}
+     * auto sum = [](const Data::Array2DView<const double[2][2]> a) {
+     *    return a[0][0] + a[0][1] + a[1][0] + a[1][1];
+     * };
+     * \endcode
+     *
+     * \tparam T the 2D c-style array type of the window.
+     */
+    template <typename T> class Array2DView
+    {
+        static_assert(std::rank<T>::value == 2,
+                      "Template class Array2DView<T> can only be used with 2D "
+                      "c-style arrays.");
+    };
+
+    /// Specialization of Array2DView for 2D c-style arrays.
+    template <typename E, size_t H, size_t W> class Array2DView<E[H][W]>
+    {
+      public:
+        /// Type of the elements of the viewed array.
+        using ElementType = std::remove_const_t<E>;
+
+        /// c-style array type corresponding to the view.
+        using ArrayType = E[H][W];
+
+        /// Number of lines of the view.
+        static constexpr size_t height = H;
+
+        /// Number of columns of the view.
+        static constexpr size_t width = W;
+
+      protected:
+        /// Pointer to the first element of the window.
+        const ElementType* data;
+
+        /// Number of elements between the beginning of two consecutive lines.
+        size_t stride;
+
+      public:
+        /**
+         * \brief Constructor of the Array2DView.
+         *
+         * \param[in] data pointer to the first element of the window.
+         * \param[in] stride number of elements between the beginning of two
+         * consecutive lines. Default value corresponds to a contiguous array.
+         */
+        Array2DView(const ElementType* data, size_t stride = W)
+            : data{data}, stride{stride} {};
+
+        /// Get the number of elements between two consecutive lines.
+        size_t getStride() const
+        {
+            return this->stride;
+        }
+
+        /// Whether the lines of the window are contiguous in memory.
+        bool isContiguous() const
+        {
+            return this->stride == W;
+        }
+
+        /**
+         * \brief Get a pointer to the given line of the window.
+         *
+         * \param[in] h the index of the line (unchecked).
+         * \return a pointer to the first element of the line.
+         */
+        const ElementType* operator[](size_t h) const
+        {
+            return this->data + h * this->stride;
+        }
+
+        /**
+         * \brief Get the element at the given coordinates.
+         *
+         * \param[in] h the index of the line.
+         * \param[in] w the index of the column.
+         * \return a const reference to the element.
+         * \throws std::out_of_range if the coordinates exceed the window.
+         */
+        const ElementType& at(size_t h, size_t w) const
+        {
+            if (h >= H || w >= W) {
+                throw std::out_of_range(
+                    "Coordinates exceed the Array2DView dimensions.");
+            }
+            return this->data[h * this->stride + w];
+        }
+    };
+
+    /// Trait detecting whether a type is an Array2DView.
+    template <typename T> struct is_array_2D_view : std::false_type
+    {
+    };
+
+    /// Trait detecting whether a type is an Array2DView.
+    template <typename T>
+    struct is_array_2D_view<Array2DView<T>> : std::true_type
+    {
+    };
+
+    /// Trait detecting whether a type is an Array2DView (const version).
+    template <typename T>
+    struct is_array_2D_view<const Array2DView<T>> : std::true_type
+    {
+    };
+
+    /**
+     * \brief Trait giving the type with which an operand is requested to a
+     * DataHandler.
+     *
+     * For an Array2DView, this type is the corresponding 2D c-style array
+     * type. For all other types, it is the type itself.
+     */
+    template <typename T> struct operand_storage_type
+    {
+        /// Type with which the operand is requested.
+        using type = T;
+    };
+
+    /// Specialization of operand_storage_type for Array2DView.
+    template <typename T> struct operand_storage_type<Array2DView<T>>
+    {
+        /// Type with which the operand is requested.
+        using type = T;
+    };
+
+    /// Specialization of operand_storage_type for const Array2DView.
+    template <typename T> struct operand_storage_type<const Array2DView<T>>
+    {
+        /// Type with which the operand is requested.
+        using type = T;
+    };
+
+    /// Helper for operand_storage_type.
+    template <typename T>
+    using operand_storage_type_t = typename operand_storage_type<T>::type;
+} // namespace Data
+
+#endif // ARRAY_2D_VIEW_H
@@ -37,6 +37,8 @@
 #ifndef ARRAY_2D_WRAPPER_H
 #define ARRAY_2D_WRAPPER_H
 
+#include <algorithm>
+
 #include "data/arrayWrapper.h"
 #include "data/dataHandler.h"
 #include "data/demangle.h"
@@ -142,10 +144,31 @@ namespace Data {
         virtual std::vector<size_t> getAddressesAccessed(
             const std::type_info& type, const size_t address) const override;
 
-        /// Inherited from DataHandler
+        /**
+         * \brief Inherited from DataHandler.
+         *
+         * 2D arrays returned by this method are always copied in a
+         * contiguous memory owned by the returned UntypedSharedPtr. This copy
+         * is needed by Instruction requiring contiguous operands. The
+         * fetchDataAt() method should be preferred when possible, as it
+         * provides zero-copy strided views.
+         */
         virtual UntypedSharedPtr getDataAt(const std::type_info& type,
                                            const size_t address) const override;
 
+        /**
+         * \brief Inherited from DataHandler.
+         *
+         * Native types, 1D arrays, and 2D arrays spanning the full width of
+         * the Array2DWrapper are stored contiguously and are not copied. Other
+         * 2D arrays are pushed as strided views when the OperandBuffer allows
+         * it, and are copied line by line in the OperandBuffer scratch memory
+         * otherwise.
+         */
+        virtual void fetchDataAt(const std::type_info& type,
+                                 const size_t address,
+                                 OperandBuffer& operands) const override;
+
 #ifdef CODE_GENERATION
         /// Inherited from DataHandler
         virtual std::vector<size_t> getDimensionsSize() const override;
@@ -310,16 +333,15 @@ namespace Data {
         // a return value
         auto array = new T[arrayHeight * arrayWidth];
 
-        // Copy its content
+        // Copy its content line by line
         size_t addressH = address / (this->width - arrayWidth + 1);
         size_t addressW = address % (this->width - arrayWidth + 1);
-        size_t addressSrc = (addressH * this->width) + addressW;
-        size_t idxDst = 0;
+        const T* src =
+            this->containerPtr->data() + (addressH * this->width) + addressW;
         for (size_t idxHeight = 0; idxHeight < arrayHeight; idxHeight++) {
-            for (size_t idxWidth = 0; idxWidth < arrayWidth; idxWidth++) {
-                size_t idxSrc = (idxHeight * this->width) + idxWidth;
-                array[idxDst++] = this->containerPtr->at(addressSrc + idxSrc);
-            }
+            std::copy(src + idxHeight * this->width,
+                      src + idxHeight * this->width + arrayWidth,
+                      array + idxHeight * arrayWidth);
         }
 
         // Create the UntypedSharedPtr
@@ -328,6 +350,53 @@ namespace Data {
         return result;
     }
 
+    template <typename T>
+    void Array2DWrapper<T>::fetchDataAt(const std::type_info& type,
+                                        const size_t address,
+                                        OperandBuffer& operands) const
+    {
+#ifndef NDEBUG
+        // Throw exception in case of invalid arguments.
+        ArrayWrapper<T>::checkAddressAndType(type, address);
+#endif
+
+        const T* data = this->containerPtr->data();
+        if (type == typeid(T)) {
+            operands.push(data + address, type);
+            return;
+        }
+
+        size_t arrayHeight = 0;
+        size_t arrayWidth = 0;
+        this->getAddressSpace(type, &arrayHeight, &arrayWidth);
+
+        size_t addressH = address / (this->width - arrayWidth + 1);
+        size_t addressW = address % (this->width - arrayWidth + 1);
+        const T* src = data + (addressH * this->width) + addressW;
+
+        // Contiguous sub-array
+        if (arrayHeight == 1 || arrayWidth == this->width) {
+            operands.push(src, type);
+            return;
+        }
+
+        // Strided view on the sub-array
+        if (operands.isStridedAllowed()) {
+            operands.push(src, type, this->width);
+            return;
+        }
+
+        // Copy the sub-array line by line
+        T* array = static_cast<T*>(
+            operands.getScratch(arrayHeight * arrayWidth * sizeof(T)));
+        for (size_t idxHeight = 0; idxHeight < arrayHeight; idxHeight++) {
+            std::copy(src + idxHeight * this->width,
+                      src + idxHeight * this->width + arrayWidth,
+                      array + idxHeight * arrayWidth);
+        }
+        operands.push(array, type);
+    }
+
 #ifdef CODE_GENERATION
     template <class T>
     std::vector<size_t> Array2DWrapper<T>::getDimensionsSize() const
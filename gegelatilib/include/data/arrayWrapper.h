@@ -37,6 +37,7 @@
 #ifndef ARRAY_WRAPPER_H
 #define ARRAY_WRAPPER_H
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <regex>
@@ -59,7 +60,13 @@ namespace Data {
      * data, but possesses a pointer to them.
      *
      * Every time the data associated to the pointer is modified, the
-     * invalidateCachedHash method should be called.
+     * invalidateCachedHash method should be called. When only a few elements
+     * are modified, calling the markAddressModified method for each of them
+     * instead makes it possible for the modified addresses to be tracked
+     * with the isModifiedSince method, and for the hash to be updated
+     * incrementally: the hash is combined from the hashes of fixed-size blocks
+     * of elements, and only blocks containing modified addresses are hashed
+     * again.
      *
      * In addition to native data types T, this DataHandler can
      * also provide the following composite data type:
@@ -104,6 +111,80 @@ namespace Data {
          */
         std::vector<T>* containerPtr;
 
+        /**
+         * \brief Modification version of the ArrayWrapper.
+         *
+         * This version is incremented each time the data of the ArrayWrapper
+         * is modified.
+         */
+        uint64_t modificationVersion = 0;
+
+        /**
+         * \brief Last modification version at which all the addresses of the
+         * ArrayWrapper were modified.
+         */
+        uint64_t fullModificationVersion = 0;
+
+        /**
+         * \brief Last modification version at which each address of the
+         * ArrayWrapper was individually modified.
+         *
+         * This vector is allocated on the first call to markAddressModified.
+         */
+        std::vector<uint64_t> addressModificationVersions;
+
+        /// Number of elements in each block of the incremental hash.
+        static constexpr size_t HASH_BLOCK_SIZE = 64;
+
+        /**
+         * \brief Hash contribution of each block of HASH_BLOCK_SIZE elements.
+         *
+         * The hash of the ArrayWrapper is the xor of the hash of its id with
+         * the contributions of all blocks, so that only blocks containing
+         * addresses marked with markAddressModified need to be hashed again
+         * by the updateHash method.
+         */
+        mutable std::vector<size_t> blockHashes;
+
+        /// Indexes of the blocks whose hash contribution is outdated.
+        mutable std::vector<size_t> dirtyBlocks;
+
+        /// Flag for each block telling whether it is listed in dirtyBlocks.
+        mutable std::vector<bool> isBlockDirty;
+
+        /// When true, the contributions of all blocks are outdated.
+        mutable bool allBlocksDirty = true;
+
+        /// Xor of all the blockHashes.
+        mutable size_t combinedBlockHash = 0;
+
+        /**
+         * \brief Compute the hash contribution of a block of elements.
+         *
+         * The hash of each element is seeded with its address, so that the
+         * hash depends on the order of elements.
+         *
+         * \param[in] blockIdx the index of the block.
+         */
+        size_t computeBlockHash(size_t blockIdx) const;
+
+        /**
+         * \brief Copy the hash and the block hashes of another ArrayWrapper.
+         *
+         * This method shall only be called when the data of this
+         * ArrayWrapper and of the other one are identical, and when both
+         * share the same id.
+         *
+         * \param[in] other the ArrayWrapper whose hash is copied.
+         */
+        void copyHashState(const ArrayWrapper<T>& other);
+
+        /**
+         * \brief Mark all the addresses of the ArrayWrapper as modified, and
+         * invalidate its cached hash.
+         */
+        void markAllAddressesModified();
+
         /**
          * Check whether the given type of data can be accessed at the given
          * address. Throws exception otherwise.
@@ -181,9 +262,31 @@ namespace Data {
          * Each time the data pointed by the ArrayWrapper is modified, this
          * method should be called to ensure that the hash value of the
          * DataHandler is properly updated.
+         *
+         * All the addresses of the ArrayWrapper are considered modified.
          */
         void invalidateCachedHash();
 
+        /**
+         * \brief Mark a single element of the container as modified.
+         *
+         * This method invalidates the hash of the container, like the
+         * invalidateCachedHash method, but only the given address is
+         * considered modified by the isModifiedSince method.
+         *
+         * \param[in] address the modified address, in the native type T.
+         * \throws std::out_of_range if the address exceeds the number of
+         * elements of the ArrayWrapper.
+         */
+        void markAddressModified(const size_t address);
+
+        /// Inherited from DataHandler
+        virtual uint64_t getModificationVersion() const override;
+
+        /// Inherited from DataHandler
+        virtual bool isModifiedSince(const std::vector<size_t>& addresses,
+                                     uint64_t version) const override;
+
         /// Inherited from DataHandler. Does nothing.
         void resetData() override;
 
@@ -204,10 +307,29 @@ namespace Data {
         virtual UntypedSharedPtr getDataAt(const std::type_info& type,
                                            const size_t address) const override;
 
+        /**
+         * \brief Inherited from DataHandler.
+         *
+         * Native and array types are both stored contiguously in the
+         * ArrayWrapper, hence no copy is ever needed.
+         */
+        virtual void fetchDataAt(const std::type_info& type,
+                                 const size_t address,
+                                 OperandBuffer& operands) const override;
+
         /// Inherited from DataHandler
         virtual std::vector<size_t> getAddressesAccessed(
             const std::type_info& type, const size_t address) const override;
 
+        /**
+         * \brief Inherited from DataHandler.
+         *
+         * Returns the data of the wrapped vector for the native type T, and
+         * nullptr for other types or when no vector is wrapped.
+         */
+        virtual const void* getContiguousData(
+            const std::type_info& type) const override;
+
 #ifdef CODE_GENERATION
         /// Inherited from DataHandler
         virtual const std::type_info& getNativeType() const override;
@@ -363,15 +485,105 @@ namespace Data {
         return result;
     }
 
+    template <class T>
+    inline void ArrayWrapper<T>::fetchDataAt(const std::type_info& type,
+                                             const size_t address,
+                                             OperandBuffer& operands) const
+    {
+        if (this->containerPtr == nullptr) {
+            throw std::runtime_error("Null pointer access.");
+        }
+#ifndef NDEBUG
+        // Throw exception in case of invalid arguments.
+        checkAddressAndType(type, address);
+#endif
+
+        // Both native type and c-style arrays start at the given address.
+        operands.push(this->containerPtr->data() + address, type);
+    }
+
+    template <class T>
+    inline const void* ArrayWrapper<T>::getContiguousData(
+        const std::type_info& type) const
+    {
+        if (type != typeid(T) || this->containerPtr == nullptr) {
+            return nullptr;
+        }
+        return this->containerPtr->data();
+    }
+
     template <class T> size_t ArrayWrapper<T>::getLargestAddressSpace() const
     {
         // Currently, largest addres space is for the template Type T.
         return this->nbElements;
     }
 
+    template <class T> void ArrayWrapper<T>::markAllAddressesModified()
+    {
+        this->fullModificationVersion = ++this->modificationVersion;
+        this->invalidCachedHash = true;
+        this->allBlocksDirty = true;
+    }
+
     template <class T> void ArrayWrapper<T>::invalidateCachedHash()
     {
+        this->markAllAddressesModified();
+    }
+
+    template <class T>
+    void ArrayWrapper<T>::markAddressModified(const size_t address)
+    {
+        if (address >= this->nbElements) {
+            std::stringstream message;
+            message << "Modified address " << address
+                    << " exceeds the number of elements of the ArrayWrapper ("
+                    << this->nbElements << ").";
+            throw std::out_of_range(message.str());
+        }
+
+        if (this->addressModificationVersions.size() != this->nbElements) {
+            this->addressModificationVersions.resize(this->nbElements, 0);
+        }
+
+        this->addressModificationVersions[address] =
+            ++this->modificationVersion;
         this->invalidCachedHash = true;
+
+        // Only the block of the address needs to be hashed again.
+        if (!this->allBlocksDirty) {
+            const size_t blockIdx = address / HASH_BLOCK_SIZE;
+            if (!this->isBlockDirty[blockIdx]) {
+                this->isBlockDirty[blockIdx] = true;
+                this->dirtyBlocks.push_back(blockIdx);
+            }
+        }
+    }
+
+    template <class T>
+    uint64_t ArrayWrapper<T>::getModificationVersion() const
+    {
+        return this->modificationVersion;
+    }
+
+    template <class T>
+    bool ArrayWrapper<T>::isModifiedSince(const std::vector<size_t>& addresses,
+                                          uint64_t version) const
+    {
+        if (this->fullModificationVersion > version) {
+            return true;
+        }
+
+        // Addresses never marked individually were not modified since the
+        // last full modification.
+        const size_t nbTracked = this->addressModificationVersions.size();
+        for (size_t address : addresses) {
+            if (address < nbTracked &&
+                this->addressModificationVersions[address] > version) {
+                return true;
+            }
+        }
+
+        return false;
     }
 
     template <class T> void ArrayWrapper<T>::resetData()
@@ -385,7 +597,7 @@ namespace Data {
         // Null ptr case
         if (ptr == nullptr) {
             this->containerPtr = ptr;
-            this->invalidCachedHash = true;
+            this->markAllAddressesModified();
             return;
         }
 
@@ -401,7 +613,37 @@ namespace Data {
 
         // Else
         this->containerPtr = ptr;
-        this->invalidCachedHash = true;
+        this->markAllAddressesModified();
+    }
+
+    template <class T>
+    size_t ArrayWrapper<T>::computeBlockHash(size_t blockIdx) const
+    {
+        Data::WordHash<T> hasher;
+
+        const size_t begin = blockIdx * HASH_BLOCK_SIZE;
+        const size_t end = std::min(begin + HASH_BLOCK_SIZE, this->nbElements);
+        const T* data = this->containerPtr->data();
+        size_t result = 0;
+        for (size_t idx = begin; idx < end; idx++) {
+            // Seed with the address because otherwise, xor is commutative.
+            result ^= hasher((T)data[idx], Data::_FNV_offset_basis +
+                                               idx * Data::_Word_hash_prime);
+        }
+
+        return result;
+    }
+
+    template <class T>
+    void ArrayWrapper<T>::copyHashState(const ArrayWrapper<T>& other)
+    {
+        this->cachedHash = other.cachedHash;
+        this->invalidCachedHash = other.invalidCachedHash;
+        this->blockHashes = other.blockHashes;
+        this->dirtyBlocks = other.dirtyBlocks;
+        this->isBlockDirty = other.isBlockDirty;
+        this->allBlocksDirty = other.allBlocksDirty;
+        this->combinedBlockHash = other.combinedBlockHash;
     }
 
     template <class T> inline size_t ArrayWrapper<T>::updateHash() const
@@ -411,18 +653,35 @@ namespace Data {
             return this->cachedHash = 0;
         }
 
-        // reset
-        this->cachedHash = Data::Hash<size_t>()(this->id);
-
-        // hasher
-        Data::Hash<T> hasher;
-
-        for (T dataElement : *(this->containerPtr)) {
-            // Rotate by 1 because otherwise, xor is comutative.
-            this->cachedHash =
-                (this->cachedHash >> 1) | (this->cachedHash << 63);
-            this->cachedHash ^= hasher((T)dataElement);
+        if (this->allBlocksDirty) {
+            // Hash all blocks
+            const size_t nbBlocks =
+                (this->nbElements + HASH_BLOCK_SIZE - 1) / HASH_BLOCK_SIZE;
+            this->blockHashes.resize(nbBlocks);
+            this->isBlockDirty.assign(nbBlocks, false);
+            this->dirtyBlocks.clear();
+            this->combinedBlockHash = 0;
+            for (size_t blockIdx = 0; blockIdx < nbBlocks; blockIdx++) {
+                this->blockHashes[blockIdx] = this->computeBlockHash(blockIdx);
+                this->combinedBlockHash ^= this->blockHashes[blockIdx];
+            }
+            this->allBlocksDirty = false;
         }
+        else {
+            // Hash only modified blocks
+            for (size_t blockIdx : this->dirtyBlocks) {
+                const size_t blockHash = this->computeBlockHash(blockIdx);
+                this->combinedBlockHash ^=
+                    this->blockHashes[blockIdx] ^ blockHash;
+                this->blockHashes[blockIdx] = blockHash;
+                this->isBlockDirty[blockIdx] = false;
+            }
+            this->dirtyBlocks.clear();
+        }
+
+        // Combine with the hash of the id
+        this->cachedHash =
+            Data::Hash<size_t>()(this->id) ^ this->combinedBlockHash;
 
         // Validate the cached hash value
         this->invalidCachedHash = false;
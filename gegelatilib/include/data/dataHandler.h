@@ -38,11 +38,13 @@
 #ifndef DATA_HANDLER_H
 #define DATA_HANDLER_H
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <typeinfo>
 #include <vector>
 
+#include "data/operandBuffer.h"
 #include "data/untypedSharedPtr.h"
 
 namespace Data {
@@ -216,6 +218,84 @@ namespace Data {
         virtual UntypedSharedPtr getDataAt(const std::type_info& type,
                                            const size_t address) const = 0;
 
+        /**
+         * \brief Push a view on the data of the given type, from the given
+         * address, in an OperandBuffer.
+         *
+         * This method is the allocation-free counterpart of getDataAt(). When
+         * the requested data is stored contiguously in the DataHandler, a
+         * pointer to this data is pushed in the OperandBuffer. Otherwise, the
+         * data is copied in the scratch memory of the OperandBuffer.
+         *
+         * The default implementation relies on getDataAt() and pushes the
+         * returned UntypedSharedPtr in the OperandBuffer.
+         *
+         * \param[in] type the std::type_info of data retrieved.
+         * \param[in] address the location of the data to retrieve.
+         * \param[in,out] operands the OperandBuffer where the data is pushed.
+         * \throws std::invalid_argument if the given data type is not provided
+         * by the DataHandler.
+         * \throws std::out_of_range if the given address is invalid for the
+         * given data type, or if the OperandBuffer is full.
+         */
+        virtual void fetchDataAt(const std::type_info& type,
+                                 const size_t address,
+                                 OperandBuffer& operands) const;
+
+        /**
+         * \brief Get the current modification version of the DataHandler.
+         *
+         * DataHandler supporting the tracking of modified addresses increment
+         * their version each time their data is modified. Together with the
+         * isModifiedSince() method, this version makes it possible to check
+         * whether some addresses of a DataHandler were modified since a
+         * previous observation of its data.
+         *
+         * The default implementation does not track modifications and always
+         * returns 0.
+         *
+         * \return the current modification version of the DataHandler.
+         */
+        virtual uint64_t getModificationVersion() const;
+
+        /**
+         * \brief Get a pointer to the data of the DataHandler, if it is
+         * stored contiguously in memory.
+         *
+         * When a non-null pointer is returned, the data at each address of
+         * the given type is stored at the same offset from the returned
+         * pointer, and remains there until the DataHandler is modified or
+         * destroyed. This makes it possible to read the data directly in
+         * memory, for example from native code.
+         *
+         * The default implementation returns nullptr.
+         *
+         * \param[in] type the std::type_info of the data.
+         * \return a pointer to the data at address 0, or nullptr if the data
+         * of the given type is not stored contiguously.
+         */
+        virtual const void* getContiguousData(const std::type_info& type) const;
+
+        /**
+         * \brief Check whether any of the given addresses was modified since
+         * the given modification version of the DataHandler.
+         *
+         * Addresses are expressed in the native type of the DataHandler, as
+         * returned by the getAddressesAccessed() method.
+         *
+         * The default implementation does not track modifications and always
+         * returns true.
+         *
+         * \param[in] addresses the native addresses whose modification is
+         * checked.
+         * \param[in] version a value previously returned by the
+         * getModificationVersion() method of the same DataHandler.
+         * \return true if any of the given addresses may have been modified
+         * since the given version, false otherwise.
+         */
+        virtual bool isModifiedSince(const std::vector<size_t>& addresses,
+                                     uint64_t version) const;
+
         /**
          * \brief Get the set of addresses actually used when getting the given
          * type of data, at the given address.
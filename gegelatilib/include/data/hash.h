@@ -41,6 +41,8 @@
 #define HASH_H
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 namespace Data {
@@ -161,6 +163,101 @@ namespace Data {
             return _Hash_representation(_Null);
         }
     };
+
+    // WORD-AT-A-TIME HASH
+    // Not part of the MSVC implementation: hashes 8 bytes per multiplication
+    // instead of one byte for FNV-1a. Results differ from the FNV-1a ones.
+    inline constexpr uint64_t _Word_hash_prime = 0x9E3779B97F4A7C15ULL;
+
+    _NODISCARD inline uint64_t _Word_hash_mix(uint64_t _Word) noexcept
+    { // finalizer of splitmix64, each input bit affects all output bits
+        _Word ^= _Word >> 30;
+        _Word *= 0xBF58476D1CE4E5B9ULL;
+        _Word ^= _Word >> 27;
+        _Word *= 0x94D049BB133111EBULL;
+        _Word ^= _Word >> 31;
+        return _Word;
+    }
+
+    _NODISCARD inline size_t _Word_hash_append_bytes(
+        size_t _Val, const unsigned char* const _First,
+        const size_t _Count) noexcept
+    { // accumulate range [_First, _First + _Count) into partial hash _Val,
+      // one 64-bit word at a time
+        size_t _Idx = 0;
+        for (; _Idx + sizeof(uint64_t) <= _Count; _Idx += sizeof(uint64_t)) {
+            uint64_t _Word;
+            std::memcpy(&_Word, _First + _Idx, sizeof(uint64_t));
+            _Val = static_cast<size_t>((_Val ^ _Word) * _Word_hash_prime);
+            _Val ^= _Val >> 32;
+        }
+
+        // Remaining bytes, and the count to distinguish trailing zeros.
+        uint64_t _Tail = static_cast<uint64_t>(_Count) << 56;
+        std::memcpy(&_Tail, _First + _Idx, _Count - _Idx);
+        return static_cast<size_t>(_Word_hash_mix(_Val ^ _Tail));
+    }
+
+    template <class _Kty>
+    _NODISCARD size_t _Word_hash_representation(
+        const _Kty& _Keyval,
+        const size_t _Seed = _FNV_offset_basis) noexcept
+    { // bitwise hashes the representation of a key, one word at a time
+        static_assert(std::is_trivial_v<_Kty>,
+                      "Only trivial types can be directly hashed.");
+        if constexpr (sizeof(_Kty) <= sizeof(uint64_t)) {
+            uint64_t _Word = 0;
+            std::memcpy(&_Word, &_Keyval, sizeof(_Kty));
+            return static_cast<size_t>(_Word_hash_mix(_Word ^ _Seed));
+        }
+        else {
+            return _Word_hash_append_bytes(
+                _Seed, &reinterpret_cast<const unsigned char&>(_Keyval),
+                sizeof(_Kty));
+        }
+    }
+
+    // STRUCT TEMPLATE WordHash
+    template <class _Kty> struct WordHash
+    { // word-at-a-time hash functor for trivial types
+        using argument_type = _Kty;
+        using result_type = size_t;
+
+        _NODISCARD size_t operator()(
+            const _Kty& _Keyval,
+            const size_t _Seed = _FNV_offset_basis) const noexcept
+        {
+            return _Word_hash_representation(_Keyval, _Seed);
+        }
+    };
+
+    template <> struct WordHash<float>
+    {
+        using argument_type = float;
+        using result_type = size_t;
+
+        _NODISCARD size_t operator()(
+            const float _Keyval,
+            const size_t _Seed = _FNV_offset_basis) const noexcept
+        {
+            return _Word_hash_representation(_Keyval == 0.0F ? 0.0F : _Keyval,
+                                             _Seed); // map -0 to 0
+        }
+    };
+
+    template <> struct WordHash<double>
+    {
+        using argument_type = double;
+        using result_type = size_t;
+
+        _NODISCARD size_t operator()(
+            const double _Keyval,
+            const size_t _Seed = _FNV_offset_basis) const noexcept
+        {
+            return _Word_hash_representation(_Keyval == 0.0 ? 0.0 : _Keyval,
+                                             _Seed); // map -0 to 0
+        }
+    };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 } // namespace Data
 
@@ -0,0 +1,236 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef OPERAND_BUFFER_H
+#define OPERAND_BUFFER_H
+
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+#include "data/untypedSharedPtr.h"
+
+namespace Data {
+    /**
+     * \brief Fixed-capacity buffer of non-owning operand views.
+     *
+     * The OperandBuffer is used to pass operands from DataHandler instances to
+     * an Instruction without any dynamic allocation once the buffer is warm.
+     * Each operand is stored as a const pointer to the data, and the
+     * std::type_info with which the data was requested.
+     *
+     * The pointed data either belongs to the DataHandler providing it, or to
+     * a scratch memory owned by the OperandBuffer when the DataHandler needs
+     * to assemble the operand from non-contiguous data. In both cases, views
+     * are valid until the next call to clear() or until the DataHandler is
+     * modified.
+     *
+     * For DataHandler not supporting the allocation-free path, an
+     * UntypedSharedPtr may also be pushed in the buffer. A copy of this
+     * UntypedSharedPtr is kept in the buffer to keep the data alive.
+     */
+    class OperandBuffer
+    {
+      public:
+        /// Non-owning view on an operand.
+        struct Operand
+        {
+            /// Pointer to the operand data.
+            const void* data;
+
+            /// Type with which the operand was requested.
+            const std::type_info* type;
+
+            /// Number of elements between two consecutive lines of a 2D
+            /// array operand, or 0 if the operand is contiguous.
+            size_t stride;
+        };
+
+      protected:
+        /// Operand views, the size of this vector is the buffer capacity.
+        std::vector<Operand> operands;
+
+        /// Number of operands currently stored in the buffer.
+        size_t nbOperands;
+
+        /// Scratch memory associated to each operand slot.
+        std::vector<std::vector<unsigned char>> scratch;
+
+        /// UntypedSharedPtr kept alive for fallback operands.
+        std::vector<UntypedSharedPtr> keepAlive;
+
+        /// Whether 2D array operands may be pushed as strided views.
+        bool stridedAllowed;
+
+      public:
+        /// Default constructor is deleted.
+        OperandBuffer() = delete;
+
+        /**
+         * \brief Constructor of the OperandBuffer.
+         *
+         * \param[in] capacity the maximum number of operands that can be
+         * stored in the buffer. Typically, the maximum number of operands of
+         * the Instruction of an Environment.
+         */
+        explicit OperandBuffer(size_t capacity)
+            : operands(capacity, {nullptr, nullptr, 0}), nbOperands{0},
+              scratch(capacity), stridedAllowed{false}
+        {
+            this->keepAlive.reserve(capacity);
+        }
+
+        /// Get the maximum number of operands of the buffer.
+        size_t getCapacity() const
+        {
+            return this->operands.size();
+        }
+
+        /// Get the number of operands currently stored in the buffer.
+        size_t size() const
+        {
+            return this->nbOperands;
+        }
+
+        /**
+         * \brief Remove all operands from the buffer.
+         *
+         * Scratch memory is kept for future use.
+         */
+        void clear()
+        {
+            this->nbOperands = 0;
+            this->keepAlive.clear();
+        }
+
+        /**
+         * \brief Set whether 2D array operands may be pushed as strided
+         * views in the buffer.
+         *
+         * When strided views are not allowed, DataHandler must copy
+         * non-contiguous 2D arrays in the scratch memory of the buffer.
+         *
+         * \param[in] allowed true if the consumer of the operands supports
+         * strided views.
+         */
+        void setStridedAllowed(bool allowed)
+        {
+            this->stridedAllowed = allowed;
+        }
+
+        /// Whether 2D array operands may be pushed as strided views.
+        bool isStridedAllowed() const
+        {
+            return this->stridedAllowed;
+        }
+
+        /**
+         * \brief Get a scratch memory for the next pushed operand.
+         *
+         * The returned memory is owned by the OperandBuffer and remains
+         * allocated between clear() calls, so that it is re-allocated only if
+         * a larger size is requested.
+         *
+         * \param[in] nbBytes the number of bytes needed.
+         * \return a pointer to a memory of at least nbBytes bytes.
+         * \throws std::out_of_range if the buffer is full.
+         */
+        void* getScratch(size_t nbBytes)
+        {
+            if (this->nbOperands >= this->operands.size()) {
+                throw std::out_of_range("OperandBuffer capacity exceeded.");
+            }
+            std::vector<unsigned char>& mem = this->scratch[this->nbOperands];
+            if (mem.size() < nbBytes) {
+                mem.resize(nbBytes);
+            }
+            return mem.data();
+        }
+
+        /**
+         * \brief Push a non-owning view on an operand in the buffer.
+         *
+         * \param[in] data the pointer to the data.
+         * \param[in] type the type with which the data was requested.
+         * \param[in] stride the number of elements between two consecutive
+         * lines of a strided 2D array, or 0 for contiguous data.
+         * \throws std::out_of_range if the buffer is full.
+         */
+        void push(const void* data, const std::type_info& type,
+                  size_t stride = 0)
+        {
+            if (this->nbOperands >= this->operands.size()) {
+                throw std::out_of_range("OperandBuffer capacity exceeded.");
+            }
+            this->operands[this->nbOperands++] = {data, &type, stride};
+        }
+
+        /**
+         * \brief Push an operand stored in an UntypedSharedPtr.
+         *
+         * A copy of the UntypedSharedPtr is kept in the buffer until the next
+         * call to clear().
+         *
+         * \param[in] data the UntypedSharedPtr containing the data.
+         * \param[in] type the type with which the data was requested.
+         * \throws std::out_of_range if the buffer is full.
+         */
+        void push(const UntypedSharedPtr& data, const std::type_info& type)
+        {
+            this->push(data.getRawPointer(), type);
+            this->keepAlive.push_back(data);
+        }
+
+        /// Get the view on the operand at the given index (unchecked).
+        const Operand& operator[](size_t idx) const
+        {
+            return this->operands[idx];
+        }
+
+        /**
+         * \brief Get a typed pointer to the operand at the given index.
+         *
+         * No check is made on the type of the operand.
+         *
+         * \tparam T the type of the pointed data.
+         * \param[in] idx the index of the operand.
+         * \return a const pointer to the operand data.
+         */
+        template <typename T> const T* getPointer(size_t idx) const
+        {
+            return static_cast<const T*>(this->operands[idx].data);
+        }
+    };
+} // namespace Data
+
+#endif // OPERAND_BUFFER_H
@@ -71,6 +71,18 @@ namespace Data {
          */
         virtual size_t updateHash() const override;
 
+        /**
+         * \brief Check that the given type and address can be accessed.
+         *
+         * \param[in] type the std::type_info of data accessed.
+         * \param[in] address the location of the data accessed.
+         * \throws std::invalid_argument if the given data type is not provided
+         * by the PointerWrapper.
+         * \throws std::out_of_range if the given address is not 0.
+         */
+        void checkAddressAndType(const std::type_info& type,
+                                 const size_t address) const;
+
       public:
         /**
          *  \brief Constructor for the PointerWrapper class.
@@ -129,6 +141,11 @@ namespace Data {
         virtual UntypedSharedPtr getDataAt(const std::type_info& type,
                                            const size_t address) const override;
 
+        /// Inherited from DataHandler
+        virtual void fetchDataAt(const std::type_info& type,
+                                 const size_t address,
+                                 OperandBuffer& operands) const override;
+
         /// Inherited from DataHandler
         virtual std::vector<size_t> getAddressesAccessed(
             const std::type_info& type, const size_t address) const override;
@@ -151,14 +168,10 @@ namespace Data {
     {
         if (this->containerPtr != nullptr) {
 
-            // reset
+            // Same hash as the single element of an ArrayWrapper, to
+            // match the hash of PrimitiveTypeArray clones.
             this->cachedHash = Data::Hash<size_t>()(this->id);
-
-            // Rotate by 1 because otherwise, xor is comutative.
-            this->cachedHash =
-                (this->cachedHash >> 1) | (this->cachedHash << 63);
-
-            this->cachedHash ^= Data::Hash<T>()(*this->containerPtr);
+            this->cachedHash ^= Data::WordHash<T>()(*this->containerPtr);
             return this->cachedHash;
         }
         else {
@@ -216,15 +229,9 @@ namespace Data {
     }
 
     template <class T>
-    inline UntypedSharedPtr PointerWrapper<T>::getDataAt(
+    inline void PointerWrapper<T>::checkAddressAndType(
         const std::type_info& type, const size_t address) const
     {
-        if (this->containerPtr == nullptr) {
-            throw std::runtime_error("Null pointer access.");
-        }
-
-#ifndef NDEBUG
-        // Throw exception in case of invalid arguments.
         if (!this->canHandle(type)) {
             std::stringstream message;
             message << "Data type " << DEMANGLE_TYPEID_NAME(type.name())
@@ -240,6 +247,19 @@ namespace Data {
                     << ", address space size is 1.";
             throw std::out_of_range(message.str());
         }
+    }
+
+    template <class T>
+    inline UntypedSharedPtr PointerWrapper<T>::getDataAt(
+        const std::type_info& type, const size_t address) const
+    {
+        if (this->containerPtr == nullptr) {
+            throw std::runtime_error("Null pointer access.");
+        }
+
+#ifndef NDEBUG
+        // Throw exception in case of invalid arguments.
+        checkAddressAndType(type, address);
 #endif
 
         UntypedSharedPtr result(this->containerPtr,
@@ -247,6 +267,23 @@ namespace Data {
         return result;
     }
 
+    template <class T>
+    inline void PointerWrapper<T>::fetchDataAt(const std::type_info& type,
+                                               const size_t address,
+                                               OperandBuffer& operands) const
+    {
+        if (this->containerPtr == nullptr) {
+            throw std::runtime_error("Null pointer access.");
+        }
+
+#ifndef NDEBUG
+        // Throw exception in case of invalid arguments.
+        checkAddressAndType(type, address);
+#endif
+
+        operands.push(this->containerPtr, type);
+    }
+
     template <class T>
     inline std::vector<size_t> PointerWrapper<T>::getAddressesAccessed(
         const std::type_info& type, const size_t address) const
@@ -140,13 +140,17 @@ namespace Data {
     {
         // Set the pointer to the right data
         this->setPointer(&(this->data));
+
+        // Data is identical, so is the hash.
+        this->copyHashState(other);
     }
 
     template <class T>
     PrimitiveTypeArray<T>::PrimitiveTypeArray(const ArrayWrapper<T>& other)
         : ArrayWrapper<T>(other), data(this->nbElements)
     {
-        if (this->containerPtr != NULL) {
+        const bool copiedData = (this->containerPtr != NULL);
+        if (copiedData) {
             // Copy the data from the given ArrayWrapper
             for (size_t i = 0; i < this->nbElements; i++) {
                 // exploit the fact that the container pointer still points to
@@ -160,6 +164,11 @@ namespace Data {
 
         // Set the pointer to the right data
         this->setPointer(&(this->data));
+
+        // Data is identical, so is the hash.
+        if (copiedData) {
+            this->copyHashState(other);
+        }
     }
 
     template <class T>
@@ -193,7 +202,7 @@ namespace Data {
         }
 
         // Invalidate the cached hash
-        this->invalidCachedHash = true;
+        this->markAllAddressesModified();
     }
 
     template <class T>
@@ -208,7 +217,7 @@ namespace Data {
         this->data.at(address) = value;
 
         // Invalidate the cached hash.
-        this->invalidCachedHash = true;
+        this->markAddressModified(address);
     }
     template <class T>
     PrimitiveTypeArray<T>& PrimitiveTypeArray<T>::operator=(
@@ -228,6 +237,9 @@ namespace Data {
             for (auto i = 0; i < this->nbElements; i++) {
                 this->data.at(i) = other.data.at(i);
             }
+
+            // Invalidate the cached hash
+            this->markAllAddressesModified();
         }
         return *this;
     }
@@ -82,6 +82,8 @@ namespace Data {
             virtual const std::type_info& getType() const = 0;
             /// Polymorphic getPtrType() function.
             virtual const std::type_info& getPtrType() const = 0;
+            /// Polymorphic getRawPointer() function.
+            virtual const void* getRawPointer() const = 0;
         };
 
         /**
@@ -124,6 +126,12 @@ namespace Data {
                 return typeid(sharedPtr.get());
             }
 
+            /// Polymorphic getRawPointer() function.
+            const void* getRawPointer() const override
+            {
+                return sharedPtr.get();
+            }
+
             /// std::shared_ptr of the UntypedSharedPtr
             std::shared_ptr<ELEM_TYPE> sharedPtr;
         };
@@ -259,6 +267,21 @@ namespace Data {
             return sharedPtrContainer->getPtrType();
         }
 
+        /**
+         * \brief Get the raw address of the data stored in the
+         * UntypedSharedPtr.
+         *
+         * Contrary to getSharedPointer(), this method performs no type check
+         * and does not copy the std::shared_ptr. The returned pointer remains
+         * valid as long as a copy of the UntypedSharedPtr exists.
+         *
+         * \return a const pointer to the stored data, without its type.
+         */
+        const void* getRawPointer() const
+        {
+            return sharedPtrContainer->getRawPointer();
+        }
+
         /**
          * \brief Get the shared_ptr store in the UntypedSharedPtr.
          *
@@ -46,14 +46,17 @@
 #ifndef GEGELATI_H
 #define GEGELATI_H
 
+#include <util/threadPool.h>
 #include <util/timestamp.h>
 
+#include <data/array2DView.h>
 #include <data/array2DWrapper.h>
 #include <data/arrayWrapper.h>
 #include <data/constant.h>
 #include <data/constantHandler.h>
 #include <data/dataHandler.h>
 #include <data/hash.h>
+#include <data/operandBuffer.h>
 #include <data/pointerWrapper.h>
 #include <data/primitiveTypeArray.h>
 #include <data/primitiveTypeArray2D.h>
@@ -64,6 +67,7 @@
 #include <file/tpgGraphDotImporter.h>
 
 #include <instructions/addPrimitiveType.h>
+#include <instructions/doubleOperationInstruction.h>
 #include <instructions/instruction.h>
 #include <instructions/lambdaInstruction.h>
 #include <instructions/multByConstant.h>
@@ -93,22 +97,31 @@
 
 #include <mutator/lineMutator.h>
 #include <mutator/mutationParameters.h>
+#include <mutator/philoxEngine.h>
 #include <mutator/programMutator.h>
 #include <mutator/rng.h>
 #include <mutator/tpgMutator.h>
 
+#include <program/compiledProgram.h>
+#include <program/doubleOperation.h>
+#include <program/laneEvaluator.h>
 #include <program/line.h>
+#include <program/nativeProgram.h>
 #include <program/program.h>
 #include <program/programEngine.h>
 #include <program/programExecutionEngine.h>
 
+#include <tpg/policyFingerprint.h>
 #include <tpg/policyStats.h>
 #include <tpg/tpgAbstractEngine.h>
 #include <tpg/tpgAction.h>
+#include <tpg/tpgArenaFactory.h>
 #include <tpg/tpgEdge.h>
 #include <tpg/tpgExecutionEngine.h>
 #include <tpg/tpgFactory.h>
 #include <tpg/tpgGraph.h>
+#include <tpg/tpgGraphSnapshot.h>
+#include <tpg/tpgSnapshotExecutionEngine.h>
 #include <tpg/tpgTeam.h>
 #include <tpg/tpgVertex.h>
 
@@ -124,6 +137,7 @@
 #include <codeGen/programGenerationEngine.h>
 #include <codeGen/tpgGenerationEngine.h>
 #include <codeGen/tpgGenerationEngineFactory.h>
+#include <codeGen/tpgNativeExecutionEngine.h>
 #include <codeGen/tpgStackGenerationEngine.h>
 #include <codeGen/tpgSwitchGenerationEngine.h>
 #endif
@@ -44,6 +44,7 @@
 
 #include "data/untypedSharedPtr.h"
 #include "instructions/instruction.h"
+#include "program/doubleOperation.h"
 
 namespace Instructions {
 
@@ -80,6 +81,16 @@ namespace Instructions {
         virtual double execute(
             const std::vector<Data::UntypedSharedPtr>& args) const override;
 
+        /// Inherited from Instruction
+        bool supportsOperandBuffer() const override;
+
+        /// Inherited from Instruction
+        double execute(const Data::OperandBuffer& args) const override;
+
+        /// Inherited from Instruction
+        bool getDoubleOperation(
+            Program::DoubleOperation& operation) const override;
+
       private:
         /**
          * \brief Function call in constructor to setup the operand
@@ -108,6 +119,37 @@ namespace Instructions {
                (double)*(args.at(1).getSharedPointer<const T>());
     }
 
+    template <class T> bool AddPrimitiveType<T>::supportsOperandBuffer() const
+    {
+        return true;
+    }
+
+    template <class T>
+    double AddPrimitiveType<T>::execute(const Data::OperandBuffer& args) const
+    {
+#ifndef NDEBUG
+        if (Instruction::execute(args) != 1.0) {
+            return 0.0;
+        }
+#endif
+
+        return *(args.getPointer<T>(0)) + (double)*(args.getPointer<T>(1));
+    }
+
+    template <class T>
+    bool AddPrimitiveType<T>::getDoubleOperation(
+        Program::DoubleOperation& operation) const
+    {
+        if constexpr (std::is_same<T, double>::value) {
+            operation = {
+                Program::DoubleOperation::Opcode::ADD, nullptr, {0, 1}, 2};
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
 #ifdef CODE_GENERATION
     template <class T>
     AddPrimitiveType<T>::AddPrimitiveType(const std::string& printTemplate)
@@ -0,0 +1,136 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef DOUBLE_OPERATION_INSTRUCTION_H
+#define DOUBLE_OPERATION_INSTRUCTION_H
+
+#include <string>
+#include <vector>
+
+#include "data/untypedSharedPtr.h"
+#include "instructions/instruction.h"
+#include "program/doubleOperation.h"
+
+namespace Instructions {
+
+    /**
+     * \brief Instruction performing a single Program::DoubleOperation on
+     * double operands.
+     *
+     * The Instruction declares its operation with getDoubleOperation(), so
+     * that the Program::LaneEvaluator and the Program::NativeProgram can
+     * execute it without the interpreter, whatever its print template.
+     * Binary operations use the two operands of the Instruction in order, and
+     * the SQRT and CALL operations use its single operand.
+     */
+    class DoubleOperationInstruction : public Instruction
+    {
+#ifdef CODE_GENERATION
+      public:
+        /**
+         * \brief Constructor for an arithmetic operation, so it can be used
+         * during the code gen.
+         *
+         * \param[in] opcode the ADD, SUB, MUL, DIV or SQRT operation performed
+         * by the Instruction.
+         * \param[in] printTemplate std::string use at the generation. Check
+         * Instructions::Instruction for more details.
+         * \throw std::invalid_argument if the opcode is CALL.
+         */
+        DoubleOperationInstruction(Program::DoubleOperation::Opcode opcode,
+                                   const std::string& printTemplate = "");
+
+        /**
+         * \brief Constructor for a CALL operation, so it can be used during
+         * the code gen.
+         *
+         * \param[in] function the function called by the Instruction.
+         * \param[in] printTemplate std::string use at the generation. Check
+         * Instructions::Instruction for more details.
+         * \throw std::invalid_argument if the function is a nullptr.
+         */
+        DoubleOperationInstruction(double (*function)(double),
+                                   const std::string& printTemplate = "");
+#endif // CODE_GENERATION
+
+      public:
+#ifndef CODE_GENERATION
+        /**
+         * \brief Constructor for an arithmetic operation.
+         *
+         * \param[in] opcode the ADD, SUB, MUL, DIV or SQRT operation performed
+         * by the Instruction.
+         * \throw std::invalid_argument if the opcode is CALL.
+         */
+        DoubleOperationInstruction(Program::DoubleOperation::Opcode opcode);
+
+        /**
+         * \brief Constructor for a CALL operation.
+         *
+         * \param[in] function the function called by the Instruction.
+         * \throw std::invalid_argument if the function is a nullptr.
+         */
+        DoubleOperationInstruction(double (*function)(double));
+#endif // CODE_GENERATION
+
+        /// Inherited from Instruction
+        virtual double execute(
+            const std::vector<Data::UntypedSharedPtr>& args) const override;
+
+        /// Inherited from Instruction
+        bool supportsOperandBuffer() const override;
+
+        /// Inherited from Instruction
+        double execute(const Data::OperandBuffer& args) const override;
+
+        /// Inherited from Instruction
+        bool getDoubleOperation(
+            Program::DoubleOperation& operation) const override;
+
+      private:
+        /// Operation performed by the Instruction.
+        Program::DoubleOperation operation;
+
+        /**
+         * \brief Function call in constructors to set up the operation and
+         * the operands of the instruction.
+         *
+         * \param[in] opcode the operation performed by the Instruction.
+         * \param[in] function the function called by a CALL operation.
+         */
+        void setUpOperation(Program::DoubleOperation::Opcode opcode,
+                            double (*function)(double));
+    };
+} // namespace Instructions
+
+#endif
@@ -43,8 +43,13 @@
 #include <typeinfo>
 #include <vector>
 
+#include "data/operandBuffer.h"
 #include "data/untypedSharedPtr.h"
 
+namespace Program {
+    struct DoubleOperation;
+} // namespace Program
+
 namespace Instructions {
     /**
      * \brief This abstract class is the base class for any instruction to be
@@ -194,6 +199,68 @@ namespace Instructions {
         virtual double execute(
             const std::vector<Data::UntypedSharedPtr>& args) const = 0;
 
+        /**
+         * \brief Check if a given OperandBuffer contains elements whose types
+         * corresponds to the types of the Instruction operands.
+         *
+         * \param[in] arguments the OperandBuffer whose types are checked.
+         */
+        virtual bool checkOperandTypes(
+            const Data::OperandBuffer& arguments) const;
+
+        /**
+         * \brief Whether the Instruction can be executed with an
+         * OperandBuffer.
+         *
+         * Derived class overriding the execute method for an OperandBuffer
+         * must also override this method to return true. Otherwise, the
+         * operands are fetched and passed as UntypedSharedPtr.
+         *
+         * \return false in the default implementation.
+         */
+        virtual bool supportsOperandBuffer() const;
+
+        /**
+         * \brief Whether the Instruction accepts 2D array operands given as
+         * strided views in an OperandBuffer.
+         *
+         * When this method returns false, 2D array operands are always copied
+         * in a contiguous memory before being passed to the Instruction.
+         *
+         * \return false in the default implementation.
+         */
+        virtual bool supportsStridedOperands() const;
+
+        /**
+         * \brief Execute the Instruction for the operands of the given
+         * OperandBuffer.
+         *
+         * This method is the allocation-free counterpart of the execute method
+         * for a vector of UntypedSharedPtr. It is used only if
+         * supportsOperandBuffer() returns true.
+         *
+         * \param[in] args the OperandBuffer passed to the Instruction.
+         * \return the default implementation of the Instruction class returns
+         * 0.0 if the given arguments are not valid. Otherwise, 1.0 is
+         * returned.
+         */
+        virtual double execute(const Data::OperandBuffer& args) const;
+
+        /**
+         * \brief Get the scalar double operation performed by the Instruction.
+         *
+         * Derived class whose execution only consists of a single
+         * Program::DoubleOperation on double operands may override this method
+         * to declare it. The declared operation is checked against the
+         * execution of the Instruction by Program::DoubleOperation::identify()
+         * before being used in place of the execute method.
+         *
+         * \param[out] operation the operation performed by the Instruction.
+         * \return false in the default implementation.
+         */
+        virtual bool getDoubleOperation(
+            Program::DoubleOperation& operation) const;
+
       protected:
 #ifndef CODE_GENERATION
         /**
@@ -41,6 +41,7 @@
 #include <functional>
 #include <typeinfo>
 
+#include "data/array2DView.h"
 #include "data/untypedSharedPtr.h"
 #include "instructions/instruction.h"
 
@@ -50,8 +51,13 @@ namespace Instructions {
      * \brief Template instruction for simplifying the creation of an
      * Instruction from a c++ lambda function.
      *
-     * Template parameters First and Rest can be any primitive type, class or
-     * const c-style 1D and 2D array.
+     * Template parameters First and Rest can be any primitive type, class,
+     * const c-style 1D and 2D array, or Data::Array2DView of a const c-style
+     * 2D array.
+     *
+     * When no template parameter is a c-style 2D array, the Instruction
+     * supports strided operands and 2D arrays are accessed through
+     * Data::Array2DView without being copied.
      *
      * Each template parameter corresponds to an argument of the function given
      * to the LambdaInstruction constructor, specifying its type.
@@ -118,12 +124,14 @@ namespace Instructions {
             const std::vector<std::reference_wrapper<const std::type_info>>
                 expectedTypes{
                     // First
-                    (!std::is_array<First>::value)
-                        ? typeid(First)
-                        : typeid(std::remove_all_extents_t<First>[]),
-                    (!std::is_array<Rest>::value)
-                        ? typeid(Rest)
-                        : typeid(std::remove_all_extents_t<Rest>[])...};
+                    (!std::is_array<Data::operand_storage_type_t<First>>::value)
+                        ? typeid(Data::operand_storage_type_t<First>)
+                        : typeid(std::remove_all_extents_t<
+                                 Data::operand_storage_type_t<First>>[]),
+                    (!std::is_array<Data::operand_storage_type_t<Rest>>::value)
+                        ? typeid(Data::operand_storage_type_t<Rest>)
+                        : typeid(std::remove_all_extents_t<
+                                 Data::operand_storage_type_t<Rest>>[])...};
 
             for (auto idx = 0; idx < arguments.size(); idx++) {
                 // Argument Type
@@ -152,6 +160,33 @@ namespace Instructions {
             return result;
         };
 
+        using Instruction::checkOperandTypes;
+
+        /// Inherited from Instruction
+        virtual bool supportsOperandBuffer() const override
+        {
+            return true;
+        }
+
+        /// Inherited from Instruction
+        virtual bool supportsStridedOperands() const override
+        {
+            // c-style 2D arrays require a contiguous memory.
+            return !((std::rank<First>::value >= 2) || ... ||
+                     (std::rank<Rest>::value >= 2));
+        }
+
+        /// Inherited from Instruction
+        virtual double execute(const Data::OperandBuffer& args) const override
+        {
+#ifndef NDEBUG
+            if (Instruction::execute(args) != 1.0) {
+                return 0.0;
+            }
+#endif
+            return doExecution(args, std::index_sequence_for<Rest...>{});
+        };
+
       private:
         /**
          * \brief Template function to handle variadic parameter pack expansion.
@@ -199,7 +234,16 @@ namespace Instructions {
         constexpr auto getDataFromUntypedSharedPtr(
             const std::vector<Data::UntypedSharedPtr>& args, size_t idx) const
         {
-            if constexpr (!std::is_array<T>::value) {
+            if constexpr (Data::is_array_2D_view<T>::value) {
+                // Copied data is always contiguous.
+                using VIEW_TYPE = std::remove_const_t<T>;
+                return VIEW_TYPE(
+                    args.at(idx)
+                        .getSharedPointer<
+                            const typename VIEW_TYPE::ElementType[]>()
+                        .get());
+            }
+            else if constexpr (!std::is_array<T>::value) {
                 return *(args.at(idx).getSharedPointer<const T>());
             }
             else {
@@ -211,11 +255,64 @@ namespace Instructions {
             };
         };
 
+        /**
+         * \brief Counterpart of doExecution for an OperandBuffer.
+         *
+         * \param[in] args The argument for the func execution, stored in an
+         * OperandBuffer.
+         * \tparam I the std::index_sequence used to access args.
+         */
+        template <size_t... I>
+        double doExecution(const Data::OperandBuffer& args,
+                           std::index_sequence<I...>) const
+        {
+            return this->func(getDataFromOperandBuffer<First>(args, 0),
+                              getDataFromOperandBuffer<Rest>(args, I + 1)...);
+        }
+
+        /**
+         * \brief Counterpart of getDataFromUntypedSharedPtr for an
+         * OperandBuffer.
+         *
+         * Template parameter T is the Type of the retrieved argument.
+         *
+         * \param[in] args the OperandBuffer of all arguments.
+         * \param[in] idx the current index in the args list.
+         * \return the appropriate argument for this->func.
+         */
+        template <typename T,
+                  typename MINUS_EXTENT = typename std::remove_extent<T>::type,
+                  typename RETURN_TYPE = typename std::conditional<
+                      !std::is_array<MINUS_EXTENT>::value,
+                      typename std::remove_all_extents<T>::type*,
+                      MINUS_EXTENT*>::type>
+        constexpr auto getDataFromOperandBuffer(const Data::OperandBuffer& args,
+                                                size_t idx) const
+        {
+            if constexpr (Data::is_array_2D_view<T>::value) {
+                using VIEW_TYPE = std::remove_const_t<T>;
+                const size_t stride = args[idx].stride;
+                return VIEW_TYPE(
+                    args.getPointer<typename VIEW_TYPE::ElementType>(idx),
+                    (stride != 0) ? stride : VIEW_TYPE::width);
+            }
+            else if constexpr (!std::is_array<T>::value) {
+                return *(args.getPointer<T>(idx));
+            }
+            else {
+                return (RETURN_TYPE)args
+                    .getPointer<std::remove_all_extents_t<T>>(idx);
+            };
+        };
+
         void setUpOperand()
         {
-            this->operandTypes.push_back(typeid(First));
+            this->operandTypes.push_back(
+                typeid(Data::operand_storage_type_t<First>));
             // Fold expression to push all other types
-            (this->operandTypes.push_back(typeid(Rest)), ...);
+            (this->operandTypes.push_back(
+                 typeid(Data::operand_storage_type_t<Rest>)),
+             ...);
         }
     };
 }; // namespace Instructions
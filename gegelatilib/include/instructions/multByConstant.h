@@ -80,6 +80,12 @@ namespace Instructions {
         double execute(
             const std::vector<Data::UntypedSharedPtr>& args) const override;
 
+        /// Inherited from Instruction
+        bool supportsOperandBuffer() const override;
+
+        /// Inherited from Instruction
+        double execute(const Data::OperandBuffer& args) const override;
+
       private:
         /**
          * \brief Function call in constructor to setup the operand
@@ -118,6 +124,25 @@ namespace Instructions {
                (double)constantValue;
     }
 
+    template <class T> bool MultByConstant<T>::supportsOperandBuffer() const
+    {
+        return true;
+    }
+
+    template <class T>
+    double MultByConstant<T>::execute(const Data::OperandBuffer& args) const
+    {
+#ifndef NDEBUG
+        if (Instruction::execute(args) != 1.0) {
+            return 0.0;
+        }
+#endif
+
+        const Data::Constant constantValue =
+            *(args.getPointer<Data::Constant>(1));
+        return *(args.getPointer<T>(0)) * (double)constantValue;
+    }
+
     template <class T> void MultByConstant<T>::setUpOperand()
     {
         this->operandTypes.push_back(typeid(T));
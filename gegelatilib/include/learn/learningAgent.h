@@ -40,7 +40,9 @@
 #define LEARNING_AGENT_H
 
 #include <map>
+#include <mutex>
 #include <queue>
+#include <set>
 
 #include "archive.h"
 #include "environment.h"
@@ -49,6 +51,7 @@
 #include "mutator/mutationParameters.h"
 #include "tpg/tpgExecutionEngine.h"
 #include "tpg/tpgGraph.h"
+#include "util/threadPool.h"
 
 #include "learn/evaluationResult.h"
 #include "learn/job.h"
@@ -99,9 +102,47 @@ namespace Learn {
         std::map<const TPG::TPGVertex*, std::shared_ptr<EvaluationResult>>
             resultsPerRoot;
 
+        /**
+         * \brief Map associating the TPG::PolicyFingerprint of evaluated
+         * policies and their evaluation seed to their EvaluationResult.
+         *
+         * This map is only filled when the LearningEnvironment is
+         * deterministic, and is used by the evaluateJob() method to skip the
+         * evaluation of policies identical to an already evaluated one.
+         * Since evaluateJob() may be called concurrently, accesses to this map
+         * are protected by the resultsPerFingerprintMutex.
+         */
+        mutable std::map<std::pair<uint64_t, uint64_t>,
+                         std::shared_ptr<const EvaluationResult>>
+            resultsPerFingerprint;
+
+        /**
+         * \brief Keys of the resultsPerFingerprint map used by each evaluated
+         * root.
+         *
+         * Filled by the evaluateJob() method, under the
+         * resultsPerFingerprintMutex, and used by the
+         * pruneResultsPerFingerprint() method to keep only the results of
+         * surviving roots.
+         */
+        mutable std::set<std::pair<const TPG::TPGVertex*,
+                                   std::pair<uint64_t, uint64_t>>>
+            fingerprintKeysPerRoot;
+
+        /// Mutex protecting accesses to the resultsPerFingerprint map.
+        mutable std::mutex resultsPerFingerprintMutex;
+
         /// Random Number Generator for this Learning Agent
         Mutator::RNG rng;
 
+        /**
+         * \brief Number of the generation being trained.
+         *
+         * Used to identify the RNG streams of the jobs when the
+         * LearningParameters::counterBasedRNG option is set.
+         */
+        uint64_t currentGeneration = 0;
+
         /// Control the maximum number of threads when running in parallel.
         uint64_t maxNbThreads = 1;
 
@@ -118,6 +159,45 @@ namespace Learn {
         /// generation
         double bestScoreLastGen = 0.0;
 
+        /**
+         * \brief Get the Util::ThreadPool used for parallel computations of
+         * the LearningAgent.
+         *
+         * The default LearningAgent is sequential and has no ThreadPool.
+         *
+         * \return a pointer to the ThreadPool, or nullptr when computations
+         * are sequential.
+         */
+        virtual Util::ThreadPool* getThreadPool();
+
+        /**
+         * \brief Get the evaluation seed associated to the
+         * TPG::PolicyFingerprint of a policy in the resultsPerFingerprint map.
+         *
+         * Since the score of a policy in a deterministic LearningEnvironment
+         * does not depend on the seed given to its reset() method, this seed
+         * only depends on the LearningMode and on the LearningParameters
+         * controlling the length of an evaluation.
+         *
+         * \param[in] mode the LearningMode of the evaluation.
+         * \return the evaluation seed.
+         */
+        uint64_t getEvaluationSeed(LearningMode mode) const;
+
+        /**
+         * \brief Get the seed of the Archive for a Job in TRAINING mode.
+         *
+         * With the mt19937_64 engine, the seed is drawn from the RNG of the
+         * LearningAgent, hence Jobs must be created in a fixed order. With
+         * the counter-based PhiloxEngine, the seed is drawn from an
+         * independent stream identified by the current generation and the
+         * index of the Job, without modifying the RNG of the LearningAgent.
+         *
+         * \param[in] jobIdx the index of the Job in the generation.
+         * \return the seed of the Archive for the Job.
+         */
+        uint64_t getJobArchiveSeed(uint64_t jobIdx);
+
       public:
         /**
          * \brief Constructor for LearningAgent.
@@ -352,13 +432,27 @@ namespace Learn {
         /**
          * \brief This method resets the previous registered scores per root.
          *
-         * Resets resultsPerRoot so that, in the next training,
+         * Resets resultsPerRoot and the results stored for the fingerprints
+         * of policies so that, in the next training,
          * the current roots will be considered as if they had never
          * been tested. To use for example when there is a scoring policy
          * change.
          */
         void forgetPreviousResults();
 
+        /**
+         * \brief Remove from the results stored for the fingerprints of
+         * policies those that are not used by a root of the TPGGraph.
+         *
+         * This method is called by trainOneGeneration() after the decimation
+         * of the worst roots, so that the number of stored results stays
+         * bounded by the number of roots of the TPGGraph over the training.
+         */
+        void pruneResultsPerFingerprint();
+
+        /// Get the number of results stored for the fingerprints of policies.
+        size_t getNbResultsPerFingerprint() const;
+
         /**
          * \brief This method update the best score reached at the last
          * generation trained.
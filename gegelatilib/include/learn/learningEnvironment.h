@@ -123,6 +123,20 @@ namespace Learn {
          */
         virtual bool isCopyable() const;
 
+        /**
+         * \brief Is the score of a policy only determined by the policy.
+         *
+         * A deterministic LearningEnvironment always gives the same score to
+         * policies with identical behaviors, evaluated in the same
+         * LearningMode, whatever the seed and generation number given to the
+         * reset() method. The LearningAgent may then reuse the results of a
+         * policy for any other policy with the same TPG::PolicyFingerprint.
+         *
+         * \return true if the LearningEnvironment is deterministic. Default
+         * implementation returns false.
+         */
+        virtual bool isDeterministic() const;
+
         /**
          * \brief Get the number of actions available for this
          * LearningEnvironment.
@@ -197,6 +197,26 @@ namespace Learn {
         /// Boolean set to true if the user wants a validation after each
         /// training, and false otherwise
         bool doValidation = false;
+
+        /// JSon comment
+        inline static const std::string counterBasedRNGComment =
+            "// Boolean used to select the counter-based Philox random number "
+            "generator\n"
+            "// instead of the mt19937_64 one. Random numbers of each job and "
+            "of each\n"
+            "// mutated program are then drawn from independent streams.\n"
+            "// \"counterBasedRNG\" : false, // Default value";
+        /**
+         * \brief Boolean set to true to use the counter-based PhiloxEngine in
+         * the RNG of the LearningAgent.
+         *
+         * With the PhiloxEngine, the archive seed of each Job and the RNG of
+         * each mutated Program are derived from independent streams, with
+         * Mutator::RNG::getStream(), instead of being drawn sequentially from
+         * the RNG of the LearningAgent. Trainings with and without this
+         * option are not comparable.
+         */
+        bool counterBasedRNG = false;
     } LearningParameters;
 }; // namespace Learn
 
@@ -38,12 +38,12 @@
 #ifndef PARALLEL_LEARNING_AGENT
 #define PARALLEL_LEARNING_AGENT
 
-#include <mutex>
-#include <queue>
-#include <thread>
+#include <memory>
+#include <vector>
 
 #include "instructions/set.h"
 #include "tpg/tpgExecutionEngine.h"
+#include "util/threadPool.h"
 
 #include "learn/evaluationResult.h"
 #include "learn/job.h"
@@ -84,7 +84,11 @@ namespace Learn {
 
         /**
          * \brief Subfunction of evaluateAllRootsInParallel which handles the
-         * creation of threads, their execution and junction.
+         * distribution of jobs on the ThreadPool.
+         *
+         * Each job stores its results in a slot of its own, so no lock is
+         * needed during the evaluation. The output maps are filled once all
+         * jobs are completed.
          *
          * @param[in] generationNumber the integer number of the current
          * generation.
@@ -127,35 +131,62 @@ namespace Learn {
             std::map<uint64_t, Archive*>& archiveMap);
 
         /**
-         * \brief Function implementing the behavior of slave threads during
-         * parallel evaluation of roots.
+         * \brief Structure gathering what a thread needs to evaluate jobs.
          *
-         * \param[in] generationNumber the integer number of the current
-         * generation. \param[in] mode the LearningMode to use during the policy
-         * evaluation. \param[in,out] jobsToProcess Ordered list of jobs of
-         * TPGVertex to process, stored as a pair with an id filling the
-         * archiveMap. The jobs are groups of roots that shall be agents in the
-         * same simulation, there is only 1 root if there is no adversarial
-         * (e.g. if the environmnent is not multiplayer).
-         * \param[in] rootsToProcessMutex Mutex protecting the
-         * rootsToProcess \param[in] resultsPerRootMap Map to store the
-         * resulting score of evaluated roots. \param[in] resultsPerRootMapMutex
-         * Mutex protecting the results. \param[in,out] archiveMap Map
-         * storing the exhaustiveArchive to be merged. \param[in]
-         * archiveMapMutex Mutex protecting the archiveMap.
-         * \param[in] useMainEnvironment Boolean that is true if we use the
-         * declared LearningEnvironment, otherwise the method will clone it.
+         * Members are declared in the order of their dependencies so that the
+         * TPGExecutionEngine is destroyed before the Environment, and the
+         * Environment before the LearningEnvironment.
          */
-        void slaveEvalJobThread(
-            uint64_t generationNumber, LearningMode mode,
-            std::queue<std::shared_ptr<Learn::Job>>& jobsToProcess,
-            std::mutex& rootsToProcessMutex,
-            std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-                                         std::shared_ptr<Job>>>&
-                resultsPerRootMap,
-            std::mutex& resultsPerRootMapMutex,
-            std::map<uint64_t, Archive*>& archiveMap,
-            std::mutex& archiveMapMutex, bool useMainEnvironment);
+        struct EvaluationContext
+        {
+            /// Clone of the LearningEnvironment owned by the context, if any.
+            std::unique_ptr<LearningEnvironment> ownedLearningEnvironment;
+
+            /// LearningEnvironment used for the evaluation of jobs.
+            LearningEnvironment* learningEnvironment = nullptr;
+
+            /// Environment built on the data sources of learningEnvironment.
+            std::unique_ptr<Environment> environment;
+
+            /// TPGExecutionEngine used for the evaluation of jobs.
+            std::unique_ptr<TPG::TPGExecutionEngine> tee;
+        };
+
+        /// ThreadPool used for all parallel computations of the agent.
+        std::unique_ptr<Util::ThreadPool> threadPool;
+
+        /**
+         * \brief EvaluationContext of each thread of the threadPool.
+         *
+         * Contexts are created lazily by their thread and kept alive from one
+         * generation to the next, so that the LearningEnvironment is not
+         * cloned again at each generation. They are discarded by
+         * resyncEvaluationContexts() and when the number of threads changes.
+         */
+        std::vector<EvaluationContext> evaluationContexts;
+
+        /**
+         * \brief Initialize an EvaluationContext.
+         *
+         * \param[out] context the EvaluationContext to initialize.
+         * \param[in] useMainEnvironment Boolean that is true if the declared
+         * LearningEnvironment is used, otherwise it is cloned.
+         */
+        void initEvaluationContext(EvaluationContext& context,
+                                   bool useMainEnvironment);
+
+        /**
+         * \brief Get the ThreadPool of the ParallelLearningAgent.
+         *
+         * The ThreadPool is created at the first call, and re-created if the
+         * maxNbThreads of the agent has changed since then.
+         *
+         * With a maxNbThreads lower than 2, the ThreadPool has no worker
+         * thread and executes all jobs in the calling thread.
+         *
+         * \return a pointer to the ThreadPool.
+         */
+        virtual Util::ThreadPool* getThreadPool() override;
 
         /**
          * \brief Method to merge several Archive created in parallel
@@ -212,6 +243,18 @@ namespace Learn {
          */
         std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
         evaluateAllRoots(uint64_t generationNumber, LearningMode mode) override;
+
+        /**
+         * \brief Discard the EvaluationContext kept by the threads.
+         *
+         * Clones of the LearningEnvironment, and the TPGExecutionEngine
+         * associated to them, are kept alive for the lifetime of the
+         * ParallelLearningAgent. This method must be called whenever the state
+         * of the main LearningEnvironment is modified in a way that must be
+         * reflected in its clones. New clones are created at the next
+         * evaluation of roots.
+         */
+        void resyncEvaluationContexts();
     };
 } // namespace Learn
 #endif
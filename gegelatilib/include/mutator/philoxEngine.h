@@ -0,0 +1,207 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef PHILOX_ENGINE_H
+#define PHILOX_ENGINE_H
+
+#include <array>
+#include <cstdint>
+
+namespace Mutator {
+
+    /**
+     * \brief Counter-based Philox4x32-10 random number engine.
+     *
+     * Contrary to the mt19937_64 engine, whose 2.5KB state must be advanced
+     * sequentially, each output of the Philox engine is a bijective function
+     * of a 64-bit key and a 128-bit counter. The counter is split into a
+     * 64-bit stream identifier and a 64-bit position in the stream, so that
+     * independent streams are obtained in O(1) from a key and a stream
+     * identifier, and copies of the engine are cheap.
+     *
+     * Random numbers are generated by blocks of 128 bits, each block
+     * providing two 64-bit outputs.
+     *
+     * This class satisfies the requirements of UniformRandomBitGenerator, and
+     * can hence be used with the distributions of deterministicRandom.h.
+     *
+     * Reference: J. K. Salmon et al., "Parallel random numbers: as easy as 1,
+     * 2, 3", SC'11.
+     */
+    class PhiloxEngine
+    {
+      public:
+        /// Type of the generated random numbers.
+        using result_type = uint64_t;
+
+        /// Smallest value generated by the engine.
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        /// Largest value generated by the engine.
+        static constexpr result_type max()
+        {
+            return UINT64_MAX;
+        }
+
+        /**
+         * \brief Constructor of the engine.
+         *
+         * \param[in] key the key, or seed, of the engine.
+         * \param[in] stream the identifier of the stream.
+         */
+        explicit PhiloxEngine(uint64_t key = 0, uint64_t stream = 0)
+        {
+            this->seed(key, stream);
+        }
+
+        /**
+         * \brief Reset the engine at the beginning of a stream.
+         *
+         * \param[in] key the key, or seed, of the engine.
+         * \param[in] stream the identifier of the stream.
+         */
+        void seed(uint64_t key, uint64_t stream = 0)
+        {
+            this->key = key;
+            this->stream = stream;
+            this->position = 0;
+        }
+
+        /// Get the next random number of the stream.
+        result_type operator()()
+        {
+            if ((this->position & 1) == 0) {
+                this->generateBuffer();
+            }
+            return this->buffer[this->position++ & 1];
+        }
+
+        /**
+         * \brief Advance the engine by the given number of outputs, in O(1).
+         *
+         * \param[in] n the number of skipped outputs.
+         */
+        void discard(uint64_t n)
+        {
+            this->position += n;
+            if ((this->position & 1) == 1) {
+                this->generateBuffer();
+            }
+        }
+
+        /// Get the key of the engine.
+        uint64_t getKey() const
+        {
+            return this->key;
+        }
+
+        /// Get the stream identifier of the engine.
+        uint64_t getStream() const
+        {
+            return this->stream;
+        }
+
+        /// Get the number of outputs generated since the beginning of the
+        /// stream.
+        uint64_t getPosition() const
+        {
+            return this->position;
+        }
+
+        /**
+         * \brief Apply the Philox4x32-10 bijection on a counter.
+         *
+         * \param[in] counter the four 32-bit words of the counter.
+         * \param[in] key the two 32-bit words of the key.
+         * \return the four 32-bit random words.
+         */
+        static std::array<uint32_t, 4> generateBlock(
+            std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key)
+        {
+            for (int round = 0; round < 10; round++) {
+                const uint64_t product0 = (uint64_t)0xD2511F53 * counter[0];
+                const uint64_t product1 = (uint64_t)0xCD9E8D57 * counter[2];
+                counter = {(uint32_t)(product1 >> 32) ^ counter[1] ^ key[0],
+                           (uint32_t)product1,
+                           (uint32_t)(product0 >> 32) ^ counter[3] ^ key[1],
+                           (uint32_t)product0};
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+            return counter;
+        }
+
+        /// Two engines are equal if they will generate the same numbers.
+        bool operator==(const PhiloxEngine& other) const
+        {
+            return this->key == other.key && this->stream == other.stream &&
+                   this->position == other.position;
+        }
+
+        /// Two engines are different if they generate different numbers.
+        bool operator!=(const PhiloxEngine& other) const
+        {
+            return !(*this == other);
+        }
+
+      protected:
+        /// Key of the engine.
+        uint64_t key;
+
+        /// Stream identifier, used as the upper half of the counter.
+        uint64_t stream;
+
+        /// Number of outputs generated in the stream.
+        uint64_t position;
+
+        /// Outputs of the block containing the current position.
+        std::array<uint64_t, 2> buffer;
+
+        /// Fill the buffer with the block of the current position.
+        void generateBuffer()
+        {
+            const uint64_t blockIdx = this->position >> 1;
+            std::array<uint32_t, 4> block = generateBlock(
+                {(uint32_t)blockIdx, (uint32_t)(blockIdx >> 32),
+                 (uint32_t)this->stream, (uint32_t)(this->stream >> 32)},
+                {(uint32_t)this->key, (uint32_t)(this->key >> 32)});
+            this->buffer[0] = ((uint64_t)block[1] << 32) | block[0];
+            this->buffer[1] = ((uint64_t)block[3] << 32) | block[2];
+        }
+    };
+} // namespace Mutator
+
+#endif // !PHILOX_ENGINE_H
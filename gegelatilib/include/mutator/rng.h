@@ -39,28 +39,61 @@
 #include <memory>
 #include <random>
 
+#include "mutator/philoxEngine.h"
+
 namespace Mutator {
 
     /**
      * Class containing the (pseudo) Random Number Generator facilities to be
      * used in the TPG framework.
      *
-     * This class currently provides a wrapper around the mt19937_64 engine
-     * and all methods generating random numbers adopt a uniform distribution.
+     * This class provides a wrapper around either the mt19937_64 engine or
+     * the counter-based PhiloxEngine, and all methods generating random
+     * numbers adopt a uniform distribution.
+     *
+     * With both engines, the getStream() method derives, in O(1) and from the
+     * seed of the RNG only, an independent RNG for any (generation, index,
+     * purpose) tuple. With the PhiloxEngine, derived streams share the key of
+     * the RNG and copying an RNG does not allocate any memory.
      */
     class RNG
     {
+      public:
+        /// Random number engines supported by the RNG class.
+        enum class EngineType
+        {
+            MT19937_64,
+            PHILOX_4X32
+        };
+
       protected:
+        /// Type of engine used by the RNG.
+        EngineType engineType;
+
+        /// Seed given at construction or with setSeed.
+        uint64_t seed;
+
         /// Mersenne twister MT19937 engine used for Random Number generation.
+        /// Null pointer when the PhiloxEngine is used.
         std::unique_ptr<std::mt19937_64> engine;
 
+        /// Counter-based engine used for Random Number generation when the
+        /// engineType is PHILOX_4X32.
+        PhiloxEngine counterEngine;
+
       public:
         /**
          * \brief Default seeding constructor for RNG.
          *
          * \param[in] seed the seed for the engine.
+         * \param[in] type the type of engine used by the RNG.
          */
-        RNG(uint64_t seed = 0) : engine(std::make_unique<std::mt19937_64>(seed))
+        RNG(uint64_t seed = 0, EngineType type = EngineType::MT19937_64)
+            : engineType{type}, seed{seed},
+              engine((type == EngineType::MT19937_64)
+                         ? std::make_unique<std::mt19937_64>(seed)
+                         : nullptr),
+              counterEngine(seed)
         {
         }
 
@@ -71,17 +104,52 @@ namespace Mutator {
          * \param[in] other the RNG to copy.
          */
         RNG(const RNG& other)
-            : engine(std::make_unique<std::mt19937_64>(*(other.engine)))
+            : engineType{other.engineType}, seed{other.seed},
+              engine((other.engine != nullptr)
+                         ? std::make_unique<std::mt19937_64>(*(other.engine))
+                         : nullptr),
+              counterEngine(other.counterEngine)
         {
         }
 
         /**
          * \brief Set the seed of the random number generator.
          *
+         * The type of engine is kept.
+         *
          * \param[in] seed integer value for generating random numbers.
          */
         void setSeed(uint64_t seed);
 
+        /**
+         * \brief Change the type of engine of the RNG.
+         *
+         * The engine is reset with the seed of the RNG.
+         *
+         * \param[in] type the new type of engine.
+         */
+        void setEngineType(EngineType type);
+
+        /// Get the type of engine used by the RNG.
+        EngineType getEngineType() const;
+
+        /**
+         * \brief Get an independent RNG for the given tuple.
+         *
+         * The returned RNG uses the same type of engine, and only depends on
+         * the seed of this RNG and on the given tuple, not on the numbers
+         * already drawn from this RNG. Hence, streams can be created in any
+         * order, and in parallel.
+         *
+         * \param[in] generation the generation for which the stream is used.
+         * \param[in] index the index, e.g. of a root or a job, within the
+         * generation.
+         * \param[in] purpose an identifier of the use of the stream.
+         * \return the RNG of the stream.
+         */
+        RNG getStream(uint64_t generation, uint64_t index,
+                      uint64_t purpose) const;
+
         /**
          * \brief Get a pseudo random int number between two bounds (included).
          *
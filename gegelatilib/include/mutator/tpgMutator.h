@@ -38,10 +38,12 @@
 #define TPG_MUTATOR_H
 
 #include <thread>
+#include <vector>
 
 #include "archive.h"
 #include "mutator/mutationParameters.h"
 #include "tpg/tpgGraph.h"
+#include "util/threadPool.h"
 
 namespace Mutator {
     namespace TPGMutator {
@@ -209,6 +211,73 @@ namespace Mutator {
             std::list<std::shared_ptr<Program::Program>>& newPrograms,
             const Mutator::MutationParameters& params, Mutator::RNG& rng);
 
+        /**
+         * \brief Outgoing TPGEdge of a new TPGTeam, mutated before the
+         * insertion of the TPGTeam in the TPGGraph.
+         *
+         * Each edge is described by its destination TPGVertex and by its
+         * Program. A TeamMutation is built without modifying the TPGGraph,
+         * which makes it possible to prepare the mutation of several TPGTeam
+         * in parallel and to commit them later in a deterministic order.
+         */
+        struct TeamMutation
+        {
+            /// Destination and Program of each outgoing TPGEdge, in order.
+            std::vector<std::pair<const TPG::TPGVertex*,
+                                  std::shared_ptr<Program::Program>>>
+                edges;
+
+            /// Whether the Program of each edge is a new copy whose behavior
+            /// must be mutated.
+            std::vector<bool> isNewProgram;
+        };
+
+        /**
+         * \brief Prepares the mutation of a clone of a root TPGTeam without
+         * modifying the TPGGraph.
+         *
+         * This function applies the same successive mutations as
+         * mutateTPGTeam on a copy of the outgoing TPGEdge of the cloned
+         * TPGTeam, with the same probabilities. Copies of the mutated
+         * Program are created with the TPGFactory of the TPGGraph, but their
+         * behavior is not mutated.
+         *
+         * Since the TPGGraph is only read, this function can be called
+         * concurrently by several threads, as long as the TPGGraph is not
+         * modified in the meantime.
+         *
+         * \param[in] graph the TPGGraph containing the cloned TPGTeam.
+         * \param[in] clonedTeam the TPGTeam whose outgoing TPGEdge are copied.
+         * \param[in] preExistingTeams the TPGTeam candidates for destination.
+         * \param[in] preExistingActions the TPGAction candidates for
+         *            destination.
+         * \param[in] preExistingEdges the TPGEdge candidates for cloning.
+         * \param[in] params Probability parameters for the mutation.
+         * \param[in] rng Random Number Generator used in the mutation process.
+         * \return the TeamMutation describing the new TPGTeam.
+         */
+        TeamMutation prepareTeamMutation(
+            const TPG::TPGGraph& graph, const TPG::TPGTeam& clonedTeam,
+            const std::vector<const TPG::TPGTeam*>& preExistingTeams,
+            const std::vector<const TPG::TPGAction*>& preExistingActions,
+            const std::vector<TPG::TPGEdge*>& preExistingEdges,
+            const Mutator::MutationParameters& params, Mutator::RNG& rng);
+
+        /**
+         * \brief Add the TPGTeam described by a TeamMutation to the TPGGraph.
+         *
+         * \param[in,out] graph the TPGGraph where the new TPGTeam and its
+         *                outgoing TPGEdge are added.
+         * \param[in] mutation the TeamMutation describing the new TPGTeam.
+         * \param[in,out] newPrograms List where the new Program of the
+         *                TeamMutation are appended, in the order of the
+         *                outgoing TPGEdge.
+         * \return a reference to the new TPGTeam.
+         */
+        const TPG::TPGTeam& commitTeamMutation(
+            TPG::TPGGraph& graph, const TeamMutation& mutation,
+            std::list<std::shared_ptr<Program::Program>>& newPrograms);
+
         /**
          * \brief Mutate the behavior of a Program and ensure its unicity
          * against the given Archive.
@@ -233,15 +302,22 @@ namespace Mutator {
          *           -`n > 1`: Set the number of threads explicitly.
          * \param[in] newPrograms List of new Program to mutate.
          * \param[in] rng Random Number Generator used in the mutation process.
+         * When it uses the PhiloxEngine, each Program is mutated with an
+         * independent stream of this RNG, created by the thread mutating it.
          * \param[in] params Probability parameters for the mutation.
          * \param[in] archive Archive used to assess the uniqueness of the
          * mutated Program behavior.
+         * \param[in] threadPool Optional persistent Util::ThreadPool used for
+         * the parallel execution. When nullptr, a temporary ThreadPool with
+         * maxNbThreads threads is created if parallelism is used. When given,
+         * the number of threads of the ThreadPool is used instead of
+         * maxNbThreads.
          */
         void mutateNewProgramBehaviors(
             const uint64_t& maxNbThreads,
             std::list<std::shared_ptr<Program::Program>>& newPrograms,
             Mutator::RNG& rng, const Mutator::MutationParameters& params,
-            const Archive& archive);
+            const Archive& archive, Util::ThreadPool* threadPool = nullptr);
 
         /**
          * \brief Create new root TPGTeam within the TPGGraph.
@@ -259,6 +335,12 @@ namespace Mutator {
          * If the given TPGGraph already has more root TPGVertex than the
          * targetted number of root teams, nothing happens.
          *
+         * When the rng uses the PhiloxEngine, the mutation of the new TPGTeam
+         * is prepared in parallel with prepareTeamMutation, each TPGTeam
+         * using an independent stream of the rng. The TPGTeam are then
+         * committed in the TPGGraph in the order of their index, so that the
+         * resulting TPGGraph does not depend on the number of threads.
+         *
          * \param[in,out] graph the TPGGraph to mutate.
          * \param[in] archive Archive used to assess the uniqueness of the
          *            mutated Program behavior.
@@ -272,12 +354,15 @@ namespace Mutator {
          *               std::thread::hardware_concurrency().
          *   - `0` and `1`: Do not use parallelism.
          *   - `n > 1`: Set the number of threads explicitly.
+         * \param[in] threadPool Optional persistent Util::ThreadPool, see
+         * mutateNewProgramBehaviors.
          */
         void populateTPG(
             TPG::TPGGraph& graph, const Archive& archive,
             const Mutator::MutationParameters& params, Mutator::RNG& rng,
             uint64_t nbActions,
-            uint64_t maxNbThreads = std::thread::hardware_concurrency());
+            uint64_t maxNbThreads = std::thread::hardware_concurrency(),
+            Util::ThreadPool* threadPool = nullptr);
     }; // namespace TPGMutator
 };     // namespace Mutator
 
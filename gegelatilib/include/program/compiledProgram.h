@@ -0,0 +1,148 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef COMPILED_PROGRAM_H
+#define COMPILED_PROGRAM_H
+
+#include <cstdint>
+#include <typeinfo>
+#include <vector>
+
+#include "instructions/instruction.h"
+#include "program/program.h"
+
+namespace Program {
+    /**
+     * \brief Flat, intron-free representation of a Program ready for
+     * execution.
+     *
+     * When compiling a Program, all its non-intron lines are translated into
+     * a contiguous sequence of CompiledLine, where the Instruction of each
+     * line is already fetched from the Environment Instruction::Set, and
+     * where the location of each operand is already scaled with the address
+     * space of its DataHandler.
+     *
+     * Executing a CompiledProgram with the
+     * ProgramExecutionEngine::executeCompiledProgram() method produces
+     * results identical to those of ProgramExecutionEngine::executeProgram()
+     * while avoiding the per-line lookups of the interpreter.
+     *
+     * A CompiledProgram keeps a reference to the Program it was built from,
+     * and must be rebuilt whenever this Program (or its introns) is modified.
+     */
+    class CompiledProgram
+    {
+      public:
+        /// Operand of a CompiledLine, resolved at compilation time.
+        struct CompiledOperand
+        {
+            /// Index of the data source in the ProgramEngine data sources
+            /// (registers, constants, environment data sources).
+            uint64_t dataSourceIndex;
+
+            /// Location of the operand, already scaled to the address space
+            /// of the data source for the operand type.
+            uint64_t location;
+
+            /// Data type of the operand, as required by the Instruction.
+            const std::type_info* type;
+        };
+
+        /// Non-intron Line of a Program, resolved at compilation time.
+        struct CompiledLine
+        {
+            /// Instruction executed by the line.
+            const Instructions::Instruction* instruction;
+
+            /// Index of the destination register.
+            uint64_t destinationIndex;
+
+            /// Index of the first operand of the line in the operands
+            /// vector of the CompiledProgram.
+            uint64_t firstOperand;
+
+            /// Number of operands of the line.
+            uint64_t nbOperands;
+
+            /**
+             * \brief Whether the line could be resolved at compilation time.
+             *
+             * Lines that could not be resolved are those for which the
+             * interpreter would throw an std::out_of_range exception.
+             */
+            bool valid;
+        };
+
+      protected:
+        /// Program from which the CompiledProgram was built.
+        const Program* program;
+
+        /// Compiled lines, in execution order.
+        std::vector<CompiledLine> lines;
+
+        /// Operands of all compiled lines, stored contiguously.
+        std::vector<CompiledOperand> operands;
+
+        /// Maximum number of operands of a CompiledLine.
+        uint64_t maxNbOperands;
+
+      public:
+        /// Default constructor is deleted.
+        CompiledProgram() = delete;
+
+        /**
+         * \brief Build the CompiledProgram of the given Program.
+         *
+         * Introns of the Program are expected to be identified, using
+         * Program::identifyIntrons(), before the compilation. Intron lines
+         * are not part of the CompiledProgram.
+         *
+         * \param[in] prog the Program to compile.
+         */
+        explicit CompiledProgram(const Program& prog);
+
+        /// Get the Program from which the CompiledProgram was built.
+        const Program& getProgram() const;
+
+        /// Get the compiled lines of the CompiledProgram.
+        const std::vector<CompiledLine>& getLines() const;
+
+        /// Get the operands of all compiled lines of the CompiledProgram.
+        const std::vector<CompiledOperand>& getOperands() const;
+
+        /// Get the maximum number of operands of a CompiledLine.
+        uint64_t getMaxNbOperands() const;
+    };
+} // namespace Program
+
+#endif // COMPILED_PROGRAM_H
@@ -0,0 +1,109 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef DOUBLE_OPERATION_H
+#define DOUBLE_OPERATION_H
+
+#include <cstdint>
+
+#include "instructions/instruction.h"
+
+namespace Program {
+    /**
+     * \brief Scalar double operation performed by an Instruction.
+     *
+     * Some Instruction only manipulate double operands with a single
+     * arithmetic operation or a call to a function of the standard C library.
+     * Knowing this operation makes it possible to execute these Instruction
+     * without the type-erased operands of the interpreter, for example in
+     * native code (see NativeProgram) or in SIMD lanes (see LaneEvaluator).
+     *
+     * The operation of an Instruction is never guessed from its print
+     * template: it must be declared by the Instruction with
+     * Instructions::Instruction::getDoubleOperation(), as done by
+     * Instructions::AddPrimitiveType<double> and
+     * Instructions::DoubleOperationInstruction.
+     */
+    struct DoubleOperation
+    {
+        /// Operations performed on the operands.
+        enum class Opcode
+        {
+            ADD,
+            SUB,
+            MUL,
+            DIV,
+            SQRT,
+            CALL
+        };
+
+        /// Operation performed on the operands.
+        Opcode opcode;
+
+        /// Function called by a CALL operation.
+        double (*function)(double);
+
+        /// Index of the Instruction operands used as first and second
+        /// operands of the operation.
+        uint64_t operands[2];
+
+        /// Number of operands of the operation.
+        uint64_t nbOperands;
+
+        /**
+         * \brief Execute the operation.
+         *
+         * \param[in] arguments the values of the operands of the Instruction
+         * performing the operation.
+         * \return the result of the operation.
+         */
+        double execute(const double* arguments) const;
+
+        /**
+         * \brief Identify the operation performed by an Instruction.
+         *
+         * The operation declared by the Instruction is accepted only if all
+         * the operands of the Instruction are double, and if the execution of
+         * the Instruction on probe operands gives the same results as the
+         * execution of the declared operation.
+         *
+         * \param[in] instruction the Instruction to identify.
+         * \param[out] operation the operation of the Instruction.
+         * \return true if the operation of the Instruction was identified.
+         */
+        static bool identify(const Instructions::Instruction& instruction,
+                             DoubleOperation& operation);
+    };
+} // namespace Program
+
+#endif // DOUBLE_OPERATION_H
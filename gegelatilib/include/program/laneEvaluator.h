@@ -0,0 +1,217 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef LANE_EVALUATOR_H
+#define LANE_EVALUATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "data/dataHandler.h"
+#include "data/operandBuffer.h"
+#include "program/program.h"
+
+namespace Program {
+    /**
+     * \brief Evaluation of several Program at once in SIMD lanes.
+     *
+     * When all the non-intron lines of a set of Program are identified by
+     * DoubleOperation and only read double operands from the registers and
+     * from the data sources of the Environment, the Program are evaluated
+     * together: each Program is assigned to a lane of a SIMD register, and
+     * each step executes one line of each Program. Operands of all lanes are
+     * gathered from the registers and from the data read by the Program,
+     * every arithmetic operation is computed on all lanes, and the result of
+     * the operation of each lane is kept. Calls to a function of the
+     * standard C library are executed lane by lane.
+     *
+     * Lanes are 4 doubles wide with AVX2 and 8 doubles wide with AVX-512.
+     * The scalar InstructionSet executes the same steps with one lane, and
+     * is the fallback on platforms without these instruction sets.
+     *
+     * Since all operations are IEEE-754 operations executed in the order of
+     * the lines, the results are identical, bit for bit, to those of the
+     * ProgramExecutionEngine.
+     *
+     * The LaneEvaluator keeps pointers to the Program it was built from, and
+     * must be rebuilt whenever one of these Program (or its introns) is
+     * modified.
+     */
+    class LaneEvaluator
+    {
+      public:
+        /// Instruction sets used for the evaluation.
+        enum class InstructionSet
+        {
+            /// Portable evaluation with one lane.
+            SCALAR,
+            /// Evaluation with 4 lanes of AVX2 registers.
+            AVX2,
+            /// Evaluation with 8 lanes of AVX-512 registers.
+            AVX512
+        };
+
+        /// Location of data read by the Program.
+        struct Input
+        {
+            /// Index of the data source in the data sources of the
+            /// Environment.
+            uint64_t dataSourceIndex;
+
+            /// Scaled location of the double in the data source.
+            uint64_t location;
+        };
+
+      protected:
+        /// InstructionSet used for the evaluation.
+        InstructionSet instructionSet;
+
+        /// Number of lanes of the InstructionSet.
+        size_t nbLanes;
+
+        /// Number of evaluated Program.
+        size_t nbPrograms;
+
+        /// Number of registers of each Program.
+        size_t nbRegisters;
+
+        /// Whether the Program can be evaluated in lanes.
+        bool evaluable;
+
+        /// Index of the Program evaluated in each lane, by group.
+        std::vector<size_t> order;
+
+        /// Data read by the Program, each location being read once.
+        std::vector<Input> inputs;
+
+        /**
+         * \brief DoubleOperation::Opcode of the operations of all steps.
+         *
+         * Operations are stored by groups of nbLanes Program, then by step,
+         * then by lane. The operands and destination of each operation are
+         * stored with the same index in firstOperands, secondOperands and
+         * destinations, and the function called by CALL operations in
+         * functions. Lanes without line to execute during a step write in a
+         * dummy location of the memory.
+         */
+        std::vector<int64_t> opcodes;
+
+        /// Index in the memory of the first operand of each operation.
+        std::vector<int64_t> firstOperands;
+
+        /// Index in the memory of the second operand of each operation.
+        std::vector<int64_t> secondOperands;
+
+        /// Index in the memory of the destination of each operation.
+        std::vector<int64_t> destinations;
+
+        /// Function called by each CALL operation.
+        std::vector<double (*)(double)> functions;
+
+        /// Number of steps of each group of nbLanes Program.
+        std::vector<size_t> nbSteps;
+
+        /// Bit mask of the DoubleOperation::Opcode executed during each step.
+        std::vector<uint8_t> stepOpcodes;
+
+        /**
+         * \brief Memory of the evaluator.
+         *
+         * The memory holds the registers of the Program of a group,
+         * interleaved so that the registers with the same index of all lanes
+         * are contiguous, followed by the values of the inputs, followed by
+         * the dummy location.
+         */
+        std::vector<double> memory;
+
+        /// Buffer used to fetch the values of the inputs.
+        Data::OperandBuffer operandBuffer;
+
+      public:
+        /// Default constructor is deleted.
+        LaneEvaluator() = delete;
+
+        /**
+         * \brief Prepare the evaluation of the given Program.
+         *
+         * Introns of the Program are expected to be identified. All Program
+         * must share the same Environment. If one of the Program cannot be
+         * evaluated in lanes, the LaneEvaluator is still built, but
+         * isEvaluable() returns false.
+         *
+         * \param[in] programs the Program to evaluate.
+         * \param[in] instructionSet the InstructionSet used for the
+         * evaluation.
+         * \throw std::invalid_argument if the instructionSet is not supported
+         * on the current platform.
+         */
+        LaneEvaluator(const std::vector<const Program*>& programs,
+                      InstructionSet instructionSet = getBestInstructionSet());
+
+        /**
+         * \brief Whether an InstructionSet can be used on the current
+         * platform.
+         *
+         * \param[in] instructionSet the InstructionSet to check.
+         * \return true if the library and the processor support it.
+         */
+        static bool isSupported(InstructionSet instructionSet);
+
+        /// Get the widest InstructionSet supported on the current platform.
+        static InstructionSet getBestInstructionSet();
+
+        /// Get the InstructionSet used for the evaluation.
+        InstructionSet getInstructionSet() const;
+
+        /// Whether the Program can be evaluated in lanes.
+        bool isEvaluable() const;
+
+        /**
+         * \brief Evaluate all the Program.
+         *
+         * \param[in] dataSources the data sources of the Environment of the
+         * Program, without registers and constants.
+         * \param[out] results array receiving the value of register 0 at the
+         * end of each Program, in the order given to the constructor.
+         * \throw std::runtime_error if the Program are not evaluable.
+         */
+        void evaluate(
+            const std::vector<std::reference_wrapper<const Data::DataHandler>>&
+                dataSources,
+            double* results);
+    };
+} // namespace Program
+
+#endif // LANE_EVALUATOR_H
@@ -38,6 +38,7 @@
 #define LINE_H
 
 #include "environment.h"
+#include <algorithm>
 #include <cstring>
 
 namespace Program {
@@ -46,6 +47,8 @@ namespace Program {
      */
     class Line
     {
+        /// Program allocates its Line and their operands contiguously.
+        friend class Program;
 
       protected:
         /// Environment within which the Program will be executed.
@@ -62,9 +65,56 @@ namespace Program {
         /// DataHandlers of the Environment, and a location within it.)
         std::pair<uint64_t, uint64_t>* const operands;
 
+        /// Whether the operands array was allocated by the Line, and must be
+        /// freed on its destruction.
+        const bool ownsOperands;
+
         /// Delete the default constructor.
         Line() = delete;
 
+        /**
+         * \brief Constructor for a Line whose operands are stored in a
+         * memory provided by the caller.
+         *
+         * This constructor is used by the Program to store its Line and
+         * their operands contiguously. The operands are zero-filled.
+         *
+         * \param[in] env the const reference to the Environment for this
+         * Program::Line.
+         * \param[in] operandStorage memory for storing
+         * env.getMaxNbOperands() operands. This memory is not freed by the
+         * Line.
+         */
+        Line(const Environment& env,
+             std::pair<uint64_t, uint64_t>* operandStorage)
+            : environment{env}, instructionIndex{0}, destinationIndex{0},
+              operands{operandStorage}, ownsOperands{false}
+        {
+            for (auto idx = 0; idx < this->environment.getMaxNbOperands();
+                 idx++) {
+                this->operands[idx] = {0, 0};
+            }
+        };
+
+        /**
+         * \brief Copy constructor for a Line whose operands are stored in a
+         * memory provided by the caller.
+         *
+         * \param[in] other a const reference to the copied Line.
+         * \param[in] operandStorage memory for storing
+         * other.getEnvironment().getMaxNbOperands() operands. This memory is
+         * not freed by the Line.
+         */
+        Line(const Line& other, std::pair<uint64_t, uint64_t>* operandStorage)
+            : environment{other.environment},
+              instructionIndex{other.instructionIndex},
+              destinationIndex{other.destinationIndex},
+              operands{operandStorage}, ownsOperands{false}
+        {
+            std::copy_n(other.operands, this->environment.getMaxNbOperands(),
+                        this->operands);
+        };
+
       public:
         /**
          * \brief Constructor for a Line of a program.
@@ -78,7 +128,8 @@ namespace Program {
             : environment{env}, instructionIndex{0}, destinationIndex{0},
               operands{(std::pair<uint64_t, uint64_t>*)calloc(
                   env.getMaxNbOperands(),
-                  sizeof(std::pair<uint64_t, uint64_t>))} {};
+                  sizeof(std::pair<uint64_t, uint64_t>))},
+              ownsOperands{true} {};
 
         /**
          * \brief Copy constructor of a Line performing a deep copy.
@@ -94,7 +145,8 @@ namespace Program {
               destinationIndex{other.destinationIndex},
               operands{(std::pair<uint64_t, uint64_t>*)calloc(
                   other.environment.getMaxNbOperands(),
-                  sizeof(std::pair<uint64_t, uint64_t>))}
+                  sizeof(std::pair<uint64_t, uint64_t>))},
+              ownsOperands{true}
         {
             // Check needed to avoid compilation warnings
             if (this->operands != NULL) {
@@ -121,7 +173,9 @@ namespace Program {
          */
         ~Line()
         {
-            free((void*)this->operands);
+            if (this->ownsOperands) {
+                free((void*)this->operands);
+            }
         }
 
         /**
@@ -0,0 +1,170 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef NATIVE_PROGRAM_H
+#define NATIVE_PROGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "instructions/instruction.h"
+#include "program/compiledProgram.h"
+
+namespace Program {
+    /**
+     * \brief x86-64 machine code translation of a CompiledProgram.
+     *
+     * When all the lines of a CompiledProgram only manipulate double
+     * operands with Instruction known to the class, the lines are translated
+     * into a function of scalar SSE2 instructions, written directly in an
+     * executable memory buffer. No compiler is involved in this translation.
+     *
+     * The Instruction known to the class are those whose operation is
+     * identified by DoubleOperation::identify(): the operation must be
+     * declared by the Instruction, and is checked against its execution. The
+     * print template of an Instruction is never used to guess its operation.
+     *
+     * Programs with other Instruction, with invalid lines, or with operands
+     * that are not double, are not translated: isNative() returns false and
+     * the CompiledProgram must be executed with the interpreter. The
+     * translation is only available on x86-64 System V platforms (see
+     * isPlatformSupported()).
+     *
+     * The NativeProgram keeps a reference to the CompiledProgram it was
+     * built from, and must be rebuilt whenever this CompiledProgram is.
+     */
+    class NativeProgram
+    {
+      public:
+        /// Range of locations read by the native code in a data source.
+        struct DataSourceRange
+        {
+            /// Index of the data source in the ProgramEngine data sources
+            /// (registers, constants, environment data sources).
+            uint64_t dataSourceIndex;
+
+            /// Smallest scaled location read in the data source.
+            uint64_t minLocation;
+
+            /// Largest scaled location read in the data source.
+            uint64_t maxLocation;
+        };
+
+        /**
+         * \brief Signature of the native code.
+         *
+         * The first argument points to the registers, and the second to an
+         * array with, for each DataSourceRange, a pointer to the double at
+         * its minLocation. The returned value is the content of register 0.
+         */
+        typedef double (*Function)(double* registers,
+                                   const double* const* dataSources);
+
+      protected:
+        /// CompiledProgram from which the NativeProgram was built.
+        const CompiledProgram* compiled;
+
+        /// Ranges of data source locations read by the native code.
+        std::vector<DataSourceRange> dataSources;
+
+        /// Executable memory holding the native code, if any.
+        void* code;
+
+        /// Size of the memory mapping holding the native code.
+        size_t codeSize;
+
+      public:
+        /// Default constructor is deleted.
+        NativeProgram() = delete;
+
+        /// Copy constructor is deleted: the native code is owned.
+        NativeProgram(const NativeProgram&) = delete;
+
+        /// Copy assignment is deleted: the native code is owned.
+        NativeProgram& operator=(const NativeProgram&) = delete;
+
+        /**
+         * \brief Translate the given CompiledProgram into native code.
+         *
+         * If the CompiledProgram cannot be translated, the NativeProgram is
+         * still built, but isNative() returns false.
+         *
+         * \param[in] compiled the CompiledProgram to translate.
+         */
+        explicit NativeProgram(const CompiledProgram& compiled);
+
+        /// Destructor releasing the native code.
+        ~NativeProgram();
+
+        /// Whether native code can be produced on the current platform.
+        static bool isPlatformSupported();
+
+        /**
+         * \brief Whether the given Instruction can be translated into native
+         * code.
+         *
+         * \param[in] instruction the Instruction to check.
+         * \return true if the platform is supported and if the Instruction
+         * is one of those known to the class.
+         */
+        static bool isInstructionSupported(
+            const Instructions::Instruction& instruction);
+
+        /// Whether the CompiledProgram was translated into native code.
+        bool isNative() const;
+
+        /// Get the CompiledProgram from which the NativeProgram was built.
+        const CompiledProgram& getCompiledProgram() const;
+
+        /// Get the ranges of data source locations read by the native code.
+        const std::vector<DataSourceRange>& getDataSources() const;
+
+        /**
+         * \brief Execute the native code.
+         *
+         * Registers are not reset by this method.
+         *
+         * \param[in,out] registers the registers of the Program.
+         * \param[in] dataSources pointer to the double at the minLocation of
+         * each DataSourceRange, in the order of getDataSources(). The
+         * locations of each range must be contiguous in memory.
+         * \return the content of register 0 at the end of the execution.
+         * \throw std::runtime_error if the NativeProgram is not native.
+         */
+        double execute(double* registers,
+                       const double* const* dataSources) const;
+    };
+} // namespace Program
+
+#endif // NATIVE_PROGRAM_H
@@ -38,6 +38,7 @@
 #define PROGRAM_H
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "data/constantHandler.h"
@@ -60,7 +61,7 @@ namespace Program {
          *
          * Each element of this vector stores a pointer to a Line, and a
          * boolean value indicating whether this Line is an Intron whithin the
-         * program.
+         * program. Pointed Line are stored in the lineBlocks of the Program.
          *
          * Introns are Lines of the program that do not contribute to its final
          * result, stored in the first register. Hence, skipping these lines
@@ -68,6 +69,68 @@ namespace Program {
          */
         std::vector<std::pair<Line*, bool>> lines;
 
+        /// Contiguous memory block storing Line and their operands.
+        struct LineBlock
+        {
+            /// Memory of the block.
+            std::unique_ptr<unsigned char[]> memory;
+
+            /// Number of Line that can be stored in the block.
+            size_t capacity;
+
+            /// Number of Line already allocated in the block.
+            size_t nbUsed;
+        };
+
+        /**
+         * \brief Memory blocks in which the Line of the Program are stored.
+         *
+         * Each Line is stored in a slot of a block, immediately followed by
+         * its operands, so that no allocation is needed per Line and that
+         * the Line of a copied Program are stored in a single block, in
+         * order. Slots are never moved, so references to Line remain valid
+         * until the Line is removed.
+         */
+        std::vector<LineBlock> lineBlocks;
+
+        /// Slots of removed Line, available for new Line.
+        std::vector<unsigned char*> freeLineSlots;
+
+        /// Minimum number of Line in a new LineBlock.
+        static const size_t MIN_LINE_BLOCK_CAPACITY = 8;
+
+        /// Size of the slot storing a Line and its operands.
+        size_t getLineSlotSize() const;
+
+        /**
+         * \brief Get a slot for a new Line.
+         *
+         * \param[in] minBlockCapacity the minimum capacity of the LineBlock
+         * allocated if no slot is available.
+         * \return a pointer to the slot.
+         */
+        unsigned char* getFreeLineSlot(size_t minBlockCapacity);
+
+        /**
+         * \brief Create a new Line in a free slot.
+         *
+         * \param[in] copiedLine pointer to the Line copied in the new Line,
+         * or nullptr to create a zero-filled Line.
+         * \param[in] minBlockCapacity the minimum capacity of the LineBlock
+         * allocated if no slot is available.
+         * \return a pointer to the created Line.
+         */
+        Line* createLine(const Line* copiedLine,
+                         size_t minBlockCapacity = MIN_LINE_BLOCK_CAPACITY);
+
+        /**
+         * \brief Destroy a Line created with createLine() and release its
+         * slot.
+         *
+         * \param[in] line the destroyed Line.
+         */
+        void destroyLine(Line* line);
+
         /**
          *   \brief Constants of the Program
          *
@@ -96,22 +159,22 @@ namespace Program {
          * \brief Copy constructor of the Program.
          *
          * This copy constructor realises a deep copy of the Line of the given
-         * Program, instead of the default shallow copy.
+         * Program, instead of the default shallow copy. All copied Line are
+         * stored contiguously, in a single memory block.
          *
          * \param[in] other a const reference the the copied Program.
          */
         Program(const Program& other)
-            : environment{other.environment}, lines{other.lines},
-              constants{other.constants}
+            : environment{other.environment}, constants{other.constants}
         {
-            // Replace lines with their copy
+            // Copy lines in a single block
             // Keep intro info
-            std::transform(
-                lines.begin(), lines.end(), lines.begin(),
-                [](std::pair<Line*, bool>& otherLine)
-                    -> std::pair<Line*, bool> {
-                    return {new Line(*(otherLine.first)), otherLine.second};
-                });
+            this->lines.reserve(other.lines.size());
+            for (const std::pair<Line*, bool>& otherLine : other.lines) {
+                this->lines.push_back(
+                    {this->createLine(otherLine.first, other.lines.size()),
+                     otherLine.second});
+            }
         };
 
         /**
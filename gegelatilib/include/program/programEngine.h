@@ -256,6 +256,25 @@ namespace Program {
         const void fetchCurrentOperands(
             std::vector<Data::UntypedSharedPtr>& operands) const;
 
+        /**
+         * \brief Get the operands for the current Instruction, without
+         * dynamic allocation.
+         *
+         * This method is the counterpart of fetchCurrentOperands for a
+         * std::vector of UntypedSharedPtr, where non-owning views on the
+         * operands are pushed in the given OperandBuffer, using the
+         * DataHandler::fetchDataAt() method.
+         *
+         * \param[in,out] operands OperandBuffer where the fetched operands
+         * will be pushed.
+         * \throws std::invalid_argument if the data type of the
+         * current Instruction is not provided by the indexed DataHandler.
+         * \throws std::out_of_range if the given address is invalid for the
+         * indexed DataHandler, with the given data type, or if the indexed
+         * DataHandler does not exist, or if the OperandBuffer is full.
+         */
+        const void fetchCurrentOperands(Data::OperandBuffer& operands) const;
+
         /**
          * \brief Get the location for the current Instruction.
          *
@@ -40,8 +40,11 @@
 
 #include <type_traits>
 
+#include "data/operandBuffer.h"
 #include "data/primitiveTypeArray.h"
 #include "data/untypedSharedPtr.h"
+#include "program/compiledProgram.h"
+#include "program/nativeProgram.h"
 #include "program/program.h"
 #include "program/programEngine.h"
 
@@ -55,6 +58,48 @@ namespace Program {
         /// Default constructor is deleted.
         ProgramExecutionEngine() = delete;
 
+        /// Operands vector reused by executeCompiledProgram() for
+        /// Instruction not supporting the OperandBuffer.
+        std::vector<Data::UntypedSharedPtr> compiledOperands;
+
+        /// OperandBuffer reused for the execution of all lines.
+        Data::OperandBuffer operandBuffer;
+
+        /// Data source pointers given to the native code.
+        std::vector<const double*> nativeDataSources;
+
+        /// Registers of the native code, reset before each execution.
+        std::vector<double> nativeRegisters;
+
+        /**
+         * \brief Whether the given Instruction can be executed with the
+         * operandBuffer.
+         *
+         * \param[in] instruction the Instruction to execute.
+         * \return true if the Instruction supports the OperandBuffer and if
+         * its number of operands does not exceed the operandBuffer capacity.
+         */
+        bool useOperandBuffer(
+            const Instructions::Instruction& instruction) const
+        {
+            return instruction.supportsOperandBuffer() &&
+                   instruction.getNbOperands() <=
+                       this->operandBuffer.getCapacity();
+        }
+
+        /**
+         * \brief Execute the lines of a CompiledProgram on the current data
+         * sources and returns the content of register 0.
+         *
+         * The Program of the CompiledProgram must be the current Program of
+         * the ProgramExecutionEngine.
+         *
+         * \param[in] compiled the CompiledProgram to execute.
+         * \param[in] ignoreException see executeProgram().
+         */
+        double executeCompiledLines(const CompiledProgram& compiled,
+                                    const bool ignoreException);
+
       public:
         /**
          * \brief Constructor of the class.
@@ -64,7 +109,8 @@ namespace Program {
          *
          * \param[in] env The Environment in which the Program will be executed.
          */
-        ProgramExecutionEngine(const Environment& env) : ProgramEngine(env){};
+        ProgramExecutionEngine(const Environment& env)
+            : ProgramEngine(env), operandBuffer(env.getMaxNbOperands()){};
 
         /**
          * \brief Constructor of the class.
@@ -85,7 +131,8 @@ namespace Program {
         ProgramExecutionEngine(
             const Program& prog,
             const std::vector<std::reference_wrapper<T>>& dataSrc)
-            : ProgramEngine(prog, dataSrc){};
+            : ProgramEngine(prog, dataSrc),
+              operandBuffer(prog.getEnvironment().getMaxNbOperands()){};
 
         /**
          * \brief Constructor of the class.
@@ -123,6 +170,82 @@ namespace Program {
          */
         double executeProgram(const bool ignoreException = false);
 
+        /**
+         * \brief Execute a CompiledProgram completely and returns the content
+         * of register 0.
+         *
+         * If the Program of the CompiledProgram is not the current Program of
+         * the ProgramExecutionEngine, it is set with setProgram() before the
+         * execution.
+         *
+         * The result of this method is identical to the result of
+         * executeProgram() for the Program from which the CompiledProgram was
+         * built, as long as this Program was not modified since the
+         * compilation.
+         *
+         * \param[in] compiled the CompiledProgram to execute.
+         * \param[in] ignoreException see executeProgram().
+         * \return the double value contained in the 0-indexed register at the
+         *         end of the program execution.
+         */
+        double executeCompiledProgram(const CompiledProgram& compiled,
+                                      const bool ignoreException = false);
+
+        /**
+         * \brief Execute the native code of a NativeProgram and returns the
+         * content of register 0.
+         *
+         * If the Program of the NativeProgram is not the current Program of
+         * the ProgramExecutionEngine, it is set with setProgram() before the
+         * execution.
+         *
+         * The native code reads the current data sources directly in memory.
+         * When the NativeProgram is not native, or when a data source read by
+         * the native code does not expose its double data in contiguous
+         * memory with DataHandler::getContiguousData(), the CompiledProgram
+         * of the NativeProgram is executed with executeCompiledProgram()
+         * instead, producing the same result.
+         *
+         * Contrary to executeCompiledProgram(), the native code does not
+         * modify the registers DataHandler of the ProgramExecutionEngine.
+         *
+         * \param[in] native the NativeProgram to execute.
+         * \param[in] ignoreException see executeProgram().
+         * \return the double value contained in the 0-indexed register at the
+         *         end of the program execution.
+         */
+        double executeNativeProgram(const NativeProgram& native,
+                                    const bool ignoreException = false);
+
+        /**
+         * \brief Execute a CompiledProgram on several sets of data sources.
+         *
+         * The CompiledProgram is executed once for each set of data sources,
+         * as if these were successively set with setDataSources() before
+         * calling executeCompiledProgram(). Compatibility of each set with
+         * the Environment of the Program is checked only once, before all
+         * executions, and operand locations resolved in the CompiledProgram
+         * are reused for all sets.
+         *
+         * Data sources of the ProgramExecutionEngine are restored at the end
+         * of the method.
+         *
+         * \param[in] compiled the CompiledProgram to execute.
+         * \param[in] dataSourcesSets the sets of DataHandler with which the
+         * CompiledProgram is executed.
+         * \param[out] results vector filled with the content of register 0
+         * at the end of each execution, in the order of dataSourcesSets.
+         * \param[in] ignoreException see executeProgram().
+         * \throws std::runtime_error if a set of data sources is incompatible
+         * with the Environment of the Program.
+         */
+        void executeCompiledProgramBatch(
+            const CompiledProgram& compiled,
+            const std::vector<std::reference_wrapper<const std::vector<
+                std::reference_wrapper<const Data::DataHandler>>>>&
+                dataSourcesSets,
+            std::vector<double>& results, const bool ignoreException = false);
+
         /// inherited from Program::ProgramEngine
         virtual void processLine() override;
     };
@@ -0,0 +1,113 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef POLICY_FINGERPRINT_H
+#define POLICY_FINGERPRINT_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "program/program.h"
+
+#include "tpg/tpgVertex.h"
+
+namespace TPG {
+
+    /**
+     * \brief Utility class for computing structural fingerprints of the
+     * policies within a TPGGraph.
+     *
+     * The fingerprint of a policy is a Merkle-style hash of the subgraph
+     * reachable from its root TPGVertex:
+     * - the fingerprint of a TPGAction depends on its action identifier,
+     * - the fingerprint of a Program depends on its non-intron Line, and on
+     *   the values of the Constant they use, like in
+     *   Program::Program::hasIdenticalBehavior(),
+     * - the fingerprint of a TPGTeam depends on the ordered fingerprints of
+     *   the Program and destination of its outgoing TPGEdge.
+     *
+     * Two policies with identical behaviors, even if they are built from
+     * distinct TPGVertex and Program, thus get the same fingerprint.
+     * Fingerprints of TPGVertex and Program are memoized, so shared subgraphs
+     * are hashed once. The clear() method must be called whenever the
+     * analyzed TPGGraph, or its Program, are modified.
+     *
+     * The TPGExecutionEngine assumes that the TPGGraph is acyclic and does
+     * not exclude previously visited TPGTeam, so the behavior of a policy
+     * containing a cycle is not captured by its fingerprint, where the
+     * recursion is cut on the cycle. The hasCycle() method makes it possible
+     * to detect such policies.
+     */
+    class PolicyFingerprint
+    {
+      protected:
+        /// Fingerprints of the TPGVertex, or 0 for vertices being hashed.
+        std::unordered_map<const TPGVertex*, uint64_t> vertexFingerprints;
+
+        /// Fingerprints of the Program.
+        std::unordered_map<const Program::Program*, uint64_t>
+            programFingerprints;
+
+        /// Whether a cycle was encountered since the last call to clear().
+        bool cycleDetected = false;
+
+      public:
+        /**
+         * \brief Get the fingerprint of the policy starting from the given
+         * TPGVertex.
+         *
+         * \param[in] vertex the root TPGVertex of the policy.
+         * \return the fingerprint of the policy.
+         */
+        uint64_t getFingerprint(const TPGVertex& vertex);
+
+        /**
+         * \brief Get the fingerprint of the given Program.
+         *
+         * \param[in] prog the Program whose fingerprint is computed.
+         * \return the fingerprint of the Program.
+         */
+        uint64_t getFingerprint(const Program::Program& prog);
+
+        /**
+         * \brief Whether a cycle was encountered while computing the
+         * fingerprints since the last call to clear().
+         */
+        bool hasCycle() const;
+
+        /// Forget all memoized fingerprints.
+        void clear();
+    };
+}; // namespace TPG
+
+#endif // POLICY_FINGERPRINT_H
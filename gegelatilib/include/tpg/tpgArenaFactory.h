@@ -0,0 +1,346 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef TPG_ARENA_FACTORY_H
+#define TPG_ARENA_FACTORY_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "tpg/tpgFactory.h"
+
+namespace TPG {
+
+    /**
+     * \brief Memory arena recycling the storage of TPGGraph elements.
+     *
+     * The TPGArena serves fixed-size memory slots from large blocks. Slots
+     * are grouped by size classes, multiples of SLOT_ALIGNMENT bytes, with
+     * one independent pool, and one mutex, per size class. Freed slots are
+     * reused by the next allocation of the same size class, so that the
+     * vertices, edges and Programs destroyed during a generation provide the
+     * storage for those created during the next one, without going back to
+     * the global heap.
+     *
+     * Since Program are created and destroyed concurrently by the threads
+     * mutating them, freed slots are first kept in a LIFO free list of the
+     * cache of the calling thread. Each thread is assigned one of the
+     * NB_THREAD_CACHES caches of the TPGArena, and only exchanges slots with
+     * the shared pools by batches, when its cache is empty or full.
+     *
+     * Blocks are only released when the TPGArena is destroyed, which bounds
+     * the memory fragmentation over long training to the peak number of
+     * simultaneously alive elements.
+     *
+     * Requests larger than MAX_SLOT_SIZE are forwarded to the global heap.
+     */
+    class TPGArena
+    {
+      public:
+        /// Alignment, and granularity, of the slots served by the TPGArena.
+        static constexpr size_t SLOT_ALIGNMENT = alignof(std::max_align_t);
+
+        /// Largest size served from the pools of the TPGArena.
+        static constexpr size_t MAX_SLOT_SIZE = 1024;
+
+        /// Number of slots allocated at once when a pool is exhausted.
+        static constexpr size_t NB_SLOTS_PER_BLOCK = 256;
+
+        /// Number of per-thread caches of the TPGArena.
+        static constexpr size_t NB_THREAD_CACHES = 16;
+
+        /// Maximum number of free slots of a size class kept in the cache of
+        /// a thread. Half of them are exchanged at once with the pools.
+        static constexpr size_t THREAD_CACHE_CAPACITY = 64;
+
+        /// Default constructor.
+        TPGArena();
+
+        /**
+         * \brief Destructor releasing all the blocks of the TPGArena.
+         *
+         * All the slots of the TPGArena must have been given back before. In
+         * debug builds, destroying a TPGArena whose slots are still used, or
+         * deleting an element whose TPGArena was destroyed, fails an
+         * assertion.
+         */
+        ~TPGArena();
+
+        /// Deleted copy constructor.
+        TPGArena(const TPGArena& other) = delete;
+
+        /// Deleted assignment operator.
+        TPGArena& operator=(const TPGArena& other) = delete;
+
+        /**
+         * \brief Get a memory slot of at least the given size.
+         *
+         * This method is thread safe.
+         *
+         * \param[in] size the number of bytes requested.
+         * \return a pointer to a memory area aligned on SLOT_ALIGNMENT.
+         */
+        void* allocate(size_t size);
+
+        /**
+         * \brief Give back a slot obtained with allocate().
+         *
+         * This method is thread safe.
+         *
+         * \param[in] ptr the pointer returned by allocate().
+         * \param[in] size the size given to allocate() for this pointer.
+         */
+        void deallocate(void* ptr, size_t size);
+
+        /// Get the number of slots currently handed out by the TPGArena.
+        size_t getNbUsedSlots() const;
+
+        /// Get the number of freed slots waiting to be reused.
+        size_t getNbFreeSlots() const;
+
+        /// Get the number of memory blocks allocated by the TPGArena.
+        size_t getNbBlocks() const;
+
+      protected:
+        /// Storage of one size class of the TPGArena.
+        struct Pool
+        {
+            /// Mutex protecting all the attributes of the Pool.
+            mutable std::mutex mutex;
+
+            /// Memory blocks of the pool.
+            std::vector<std::unique_ptr<unsigned char[]>> blocks;
+
+            /// LIFO list of freed slots.
+            std::vector<void*> freeSlots;
+
+            /// Number of slots never used in the last block.
+            size_t nbUnusedInLastBlock = 0;
+        };
+
+        /// Number of size classes of the TPGArena.
+        static constexpr size_t NB_SIZE_CLASSES =
+            MAX_SLOT_SIZE / SLOT_ALIGNMENT;
+
+        /// Free slots cached for the threads using it.
+        struct ThreadCache
+        {
+            /**
+             * \brief Mutex protecting the free lists of the cache.
+             *
+             * Only threads sharing the same cache compete for it.
+             */
+            mutable std::mutex mutex;
+
+            /// LIFO lists of freed slots, indexed by size class.
+            std::array<std::vector<void*>, NB_SIZE_CLASSES> freeSlots;
+
+            /**
+             * \brief Number of slots allocated minus number of slots freed
+             * by the threads using the cache.
+             *
+             * Slots may be freed by another thread than the one allocating
+             * them, so only the sum over all caches is meaningful.
+             */
+            int64_t nbUsedSlots = 0;
+        };
+
+        /// Pools of the TPGArena, indexed by size class.
+        std::array<Pool, NB_SIZE_CLASSES> pools;
+
+        /// Per-thread caches of the TPGArena.
+        std::array<ThreadCache, NB_THREAD_CACHES> threadCaches;
+
+        /**
+         * \brief Take a slot from a pool, without going through the caches.
+         *
+         * The mutex of the pool must not be held by the caller.
+         *
+         * \param[in] sizeClass the size class of the slot.
+         * \param[out] cache LIFO list of the thread cache where additional
+         * free slots of the pool are moved.
+         * \return a pointer to the slot.
+         */
+        void* allocateFromPool(size_t sizeClass, std::vector<void*>& cache);
+    };
+
+    /**
+     * \brief Standard allocator drawing its memory from a TPGArena.
+     *
+     * Copies of the allocator keep the TPGArena alive, which makes it usable
+     * with std::allocate_shared: the control block holds a copy of the
+     * allocator until the allocated object is released.
+     *
+     * \tparam T the type of allocated objects.
+     */
+    template <class T> class TPGArenaAllocator
+    {
+      public:
+        /// Type of the allocated objects.
+        using value_type = T;
+
+        /**
+         * \brief Constructor of the allocator.
+         *
+         * \param[in] arena the TPGArena providing the memory.
+         */
+        explicit TPGArenaAllocator(std::shared_ptr<TPGArena> arena)
+            : arena{std::move(arena)}
+        {
+        }
+
+        /// Rebinding constructor.
+        template <class U>
+        TPGArenaAllocator(const TPGArenaAllocator<U>& other)
+            : arena{other.getArena()}
+        {
+        }
+
+        /// Allocate storage for n objects of type T.
+        T* allocate(size_t n)
+        {
+            static_assert(alignof(T) <= TPGArena::SLOT_ALIGNMENT,
+                          "Over-aligned types are not supported.");
+            return static_cast<T*>(this->arena->allocate(n * sizeof(T)));
+        }
+
+        /// Release the storage of n objects of type T.
+        void deallocate(T* ptr, size_t n)
+        {
+            this->arena->deallocate(ptr, n * sizeof(T));
+        }
+
+        /// Get the TPGArena used by the allocator.
+        const std::shared_ptr<TPGArena>& getArena() const
+        {
+            return this->arena;
+        }
+
+        /// Two allocators are equal if they share the same TPGArena.
+        template <class U>
+        bool operator==(const TPGArenaAllocator<U>& other) const
+        {
+            return this->arena == other.getArena();
+        }
+
+        /// Two allocators are different if they use different TPGArena.
+        template <class U>
+        bool operator!=(const TPGArenaAllocator<U>& other) const
+        {
+            return !(*this == other);
+        }
+
+      protected:
+        /// TPGArena providing the memory.
+        std::shared_ptr<TPGArena> arena;
+    };
+
+    /**
+     * \brief Specialization of the TPGFactory allocating the TPGTeam,
+     * TPGAction, TPGEdge and Program from a TPGArena.
+     *
+     * The produced elements are regular TPGTeam, TPGAction, TPGEdge and
+     * Program objects: they are released by the TPGGraph with plain delete
+     * and shared_ptr, and their storage goes back to the TPGArena they were
+     * allocated from.
+     *
+     * TPGTeam, TPGAction and TPGEdge only keep a raw pointer to their
+     * TPGArena, so that creating and deleting them does not update a
+     * reference count shared by all threads. The TPGArena is kept alive by
+     * the TPGArenaFactory of the TPGGraph holding them, which follows its
+     * elements when TPGGraph are swapped or moved. The TPGArena must thus
+     * outlive every TPGGraph, and every element created directly with the
+     * factory, using it: deleting an element after the last owner of its
+     * TPGArena is a use-after-free, detected by an assertion in debug builds.
+     * Program keep their TPGArena alive through the TPGArenaAllocator stored
+     * with their reference count, so they can outlive their TPGGraph.
+     *
+     * TPGGraph created with createTPGGraph() share the TPGArena of the
+     * factory.
+     */
+    class TPGArenaFactory : public TPGFactory
+    {
+      public:
+        /// Constructor creating a new TPGArena.
+        TPGArenaFactory();
+
+        /**
+         * \brief Constructor using an existing TPGArena.
+         *
+         * \param[in] arena the TPGArena where elements are allocated.
+         */
+        explicit TPGArenaFactory(std::shared_ptr<TPGArena> arena);
+
+        /// Specialization of the method returning a TPGGraph with a
+        /// TPGArenaFactory sharing the TPGArena of this one.
+        virtual std::shared_ptr<TPGGraph> createTPGGraph(
+            const Environment& env) const override;
+
+        /// Specialization of the method allocating the TPGTeam in the
+        /// TPGArena.
+        virtual TPGTeam* createTPGTeam() const override;
+
+        /// Specialization of the method allocating the TPGAction in the
+        /// TPGArena.
+        virtual TPGAction* createTPGAction(const uint64_t id) const override;
+
+        /// Specialization of the method allocating the TPGEdge in the
+        /// TPGArena.
+        virtual std::unique_ptr<TPGEdge> createTPGEdge(
+            const TPGVertex* src, const TPGVertex* dest,
+            const std::shared_ptr<Program::Program> prog) const override;
+
+        /// Specialization of the method allocating the Program in the
+        /// TPGArena.
+        virtual std::shared_ptr<Program::Program> createProgram(
+            const Environment& env) const override;
+
+        /// Specialization of the method allocating the Program copy in the
+        /// TPGArena.
+        virtual std::shared_ptr<Program::Program> createProgram(
+            const Program::Program& other) const override;
+
+        /// Get the TPGArena used by the factory.
+        const std::shared_ptr<TPGArena>& getArena() const;
+
+      protected:
+        /// TPGArena where the elements are allocated.
+        const std::shared_ptr<TPGArena> arena;
+    };
+} // namespace TPG
+
+#endif // !TPG_ARENA_FACTORY_H
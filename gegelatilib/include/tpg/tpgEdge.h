@@ -97,6 +97,30 @@ namespace TPG {
          */
         std::shared_ptr<Program::Program> getProgramSharedPointer();
 
+        /**
+         * \brief Get a weak pointer to the Program.
+         *
+         * Unlike the address of the Program, which may be reused by a new
+         * Program once it is deleted, the weak pointer keeps identifying the
+         * Program with hasProgram() after its deletion.
+         *
+         * \return a weak pointer to the program attribute.
+         */
+        std::weak_ptr<const Program::Program> getProgramWeakPointer() const;
+
+        /**
+         * \brief Check if the TPGEdge holds the given Program.
+         *
+         * The comparison is based on the ownership of the Program, without
+         * updating its reference count.
+         *
+         * \param[in] prog a weak pointer obtained with getProgramWeakPointer().
+         * \return true if prog points to the Program of the TPGEdge, false if
+         * the TPGEdge holds another Program or if prog expired.
+         */
+        bool hasProgram(
+            const std::weak_ptr<const Program::Program>& prog) const;
+
         /**
          * \brief Get the source TPGVertex of the TPGEdge.
          *
@@ -37,10 +37,13 @@
 #ifndef TPG_EXECUTION_ENGINE_H
 #define TPG_EXECUTION_ENGINE_H
 
+#include <memory>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "archive.h"
+#include "program/laneEvaluator.h"
 #include "program/programExecutionEngine.h"
 
 #include "tpg/tpgGraph.h"
@@ -68,6 +71,83 @@ namespace TPG {
          */
         Program::ProgramExecutionEngine progExecutionEngine;
 
+        /**
+         * \brief Bids of the outgoing TPGEdge of the last evaluated TPGTeam.
+         *
+         * Bids are stored contiguously, in the order of the outgoing TPGEdge
+         * of the TPGTeam. Keeping this vector as an attribute avoids
+         * allocating a new one for each evaluated TPGTeam.
+         */
+        std::vector<double> bids;
+
+        /// Whether results of Program are cached during an inference.
+        bool bidCacheEnabled = false;
+
+        /**
+         * \brief Results of the Program already executed during the current
+         * inference.
+         *
+         * Since Program are shared between TPGEdge, a same Program may be
+         * evaluated several times during an execution from a root, on the
+         * same data. When the bid cache is enabled, the result of each
+         * Program is kept in this map until the next executeFromRoot() or
+         * clearBidCache() call.
+         */
+        std::unordered_map<const Program::Program*, double> bidCache;
+
+        /// Whether the Program of a TPGTeam are evaluated in SIMD lanes.
+        bool laneEvaluationEnabled = false;
+
+        /// LaneEvaluator built for a TPGTeam.
+        struct TeamLaneEvaluator
+        {
+            /**
+             * \brief Program of the outgoing TPGEdge of the TPGTeam when the
+             * LaneEvaluator was built.
+             *
+             * Program are identified by their ownership rather than by their
+             * address, which may be reused by a Program of a new TPGTeam
+             * allocated at the address of a deleted one.
+             */
+            std::vector<std::weak_ptr<const Program::Program>> programs;
+
+            /// LaneEvaluator of the Program.
+            std::unique_ptr<Program::LaneEvaluator> evaluator;
+
+            /// Whether the LaneEvaluator was used since the last sweep.
+            bool used = false;
+        };
+
+        /**
+         * \brief LaneEvaluator of the evaluated TPGTeam.
+         *
+         * Each LaneEvaluator is rebuilt when the Program of the outgoing
+         * TPGEdge of its TPGTeam change. When the number of LaneEvaluator
+         * doubles, those that were not used since the previous sweep, which
+         * include those of deleted TPGTeam, are discarded.
+         */
+        std::unordered_map<const TPGTeam*, TeamLaneEvaluator> laneEvaluators;
+
+        /// Minimum number of LaneEvaluator triggering a sweep of the
+        /// laneEvaluators map.
+        static constexpr size_t MIN_LANE_EVALUATORS_SWEEP_SIZE = 64;
+
+        /// Number of LaneEvaluator triggering the next sweep of the
+        /// laneEvaluators map.
+        size_t laneEvaluatorsSweepSize = MIN_LANE_EVALUATORS_SWEEP_SIZE;
+
+        /// Discard the LaneEvaluator not used since the previous sweep.
+        void sweepLaneEvaluators();
+
+        /**
+         * \brief Index of the best bid.
+         *
+         * \param[in] bids the bids, none of which is NaN.
+         * \return the index of the largest bid. If several bids are equal to
+         * the largest, the index of the last one is returned.
+         */
+        static size_t getBestBidIndex(const std::vector<double>& bids);
+
       public:
         /**
          * \brief Main constructor of the class.
@@ -92,6 +172,63 @@ namespace TPG {
          */
         void setArchive(Archive* newArchive);
 
+        /**
+         * \brief Enable or disable the caching of Program results.
+         *
+         * When enabled, a Program evaluated several times during an
+         * execution from a root is executed only once, and its result is
+         * reused for the following evaluations. These evaluations are still
+         * recorded in the Archive, if any, so the content of the Archive does
+         * not depend on the caching.
+         *
+         * The cache is emptied at the beginning of each executeFromRoot().
+         * When evaluateEdge() or evaluateTeam() are called directly, the
+         * cache must be emptied with clearBidCache() whenever the data
+         * sources are modified.
+         *
+         * \param[in] enabled whether Program results are cached.
+         */
+        void setBidCacheEnabled(bool enabled);
+
+        /// Whether the caching of Program results is enabled.
+        bool isBidCacheEnabled() const;
+
+        /// Empty the cache of Program results.
+        void clearBidCache();
+
+        /**
+         * \brief Enable or disable the evaluation of the Program of a TPGTeam
+         * in SIMD lanes.
+         *
+         * When enabled, evaluateTeamBids() evaluates the Program of the
+         * outgoing TPGEdge of a TPGTeam together with a
+         * Program::LaneEvaluator, using the widest InstructionSet supported
+         * by the processor. The bids are identical to those computed with
+         * evaluateEdge(), and are recorded in the Archive, if any. TPGTeam
+         * whose Program cannot be evaluated in lanes, or TPGTeam evaluated
+         * while the bid cache is enabled, are evaluated with evaluateEdge().
+         *
+         * The LaneEvaluator built for each TPGTeam is reused by the following
+         * evaluations of the TPGTeam, until the lane evaluation is disabled
+         * or clearLaneEvaluators() is called. It is rebuilt when a TPGEdge of
+         * the TPGTeam is added, removed or given another Program. Deleting a
+         * TPGTeam also counts as a modification: the LaneEvaluator of a
+         * deleted TPGTeam is never used for a new TPGTeam allocated at the
+         * same address, and is discarded once the number of LaneEvaluator
+         * doubles, or earlier with clearLaneEvaluators(). LaneEvaluator must
+         * be cleared whenever the content of a Program of the TPGGraph is
+         * modified.
+         *
+         * \param[in] enabled whether Program are evaluated in SIMD lanes.
+         */
+        void setLaneEvaluationEnabled(bool enabled);
+
+        /// Whether the evaluation of Program in SIMD lanes is enabled.
+        bool isLaneEvaluationEnabled() const;
+
+        /// Discard the LaneEvaluator built for the evaluated TPGTeam.
+        void clearLaneEvaluators();
+
         /**
          * \brief Execute the Program associated to an Edge and returns the
          * obtained double.
@@ -102,19 +239,40 @@ namespace TPG {
          * If the value returned by the Program is NaN, then it is replaced with
          * a -inf value.
          *
+         * If the bid cache is enabled and the Program of the TPGEdge was
+         * already executed since the cache was last emptied, the cached result
+         * is returned without executing the Program.
+         *
          * \param[in] edge the const ref to the TPGEdge whose Program will be
          * evaluated.
          * \return the double value returned by the Program of the TPGEdge.
          */
         virtual double evaluateEdge(const TPGEdge& edge);
 
+        /**
+         * \brief Compute the bids of all outgoing TPGEdge of a TPGTeam.
+         *
+         * All bids are computed before the selection of the best one. The
+         * default implementation calls evaluateEdge() for each outgoing
+         * TPGEdge, in the order of the TPGTeam outgoing edges list, or
+         * evaluates all the Program in SIMD lanes when enabled with
+         * setLaneEvaluationEnabled().
+         *
+         * \param[in] team the TPGTeam whose outgoing TPGEdge are evaluated.
+         * \param[out] bids vector filled with the bids of the outgoing
+         * TPGEdge of the TPGTeam, in the same order.
+         */
+        virtual void evaluateTeamBids(const TPGTeam& team,
+                                      std::vector<double>& bids);
+
         /**
          * \brief Evaluate all the Program of the outgoing TPGEdge of the
          *        TPGTeam.
          *
          * This method evaluates the Programs of all outgoing TPGEdge of the
-         * TPGTeam, and returns the reference to the TPGEdge providing the
-         * largest evaluation.
+         * TPGTeam with evaluateTeamBids(), and returns the reference to the
+         * TPGEdge providing the largest evaluation. In case of equality, the
+         * last TPGEdge with the largest evaluation is returned.
          *
          * \param[in] team the TPGTeam whose outgoing TPGEdge are evaluated.
          * \return the reference to the TPGEdge evaluated with the the highest
@@ -61,6 +61,7 @@ namespace TPG {
      * - TPGTeam
      * - TPGAction
      * - TPGVertex
+     * - Program
      *
      * The factory also enables the creation of TPGExecutionEngine.
      *
@@ -112,6 +113,28 @@ namespace TPG {
             const TPGVertex* src, const TPGVertex* dest,
             const std::shared_ptr<Program::Program> prog) const;
 
+        /**
+         * \brief Create a new Program for a TPGGraph.
+         *
+         * This method allocates and returns a new Program, with empty lines,
+         * for the given Environment.
+         *
+         * \param[in] env Environment for which the Program is created.
+         */
+        virtual std::shared_ptr<Program::Program> createProgram(
+            const Environment& env) const;
+
+        /**
+         * \brief Create a copy of a Program for a TPGGraph.
+         *
+         * This method allocates and returns a new Program copied from the
+         * given one.
+         *
+         * \param[in] other the Program to copy.
+         */
+        virtual std::shared_ptr<Program::Program> createProgram(
+            const Program::Program& other) const;
+
         /**
          * \brief Create a TPGExecutionEngine for a TPGGraph produced by this
          * TPGFactory.
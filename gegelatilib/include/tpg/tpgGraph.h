@@ -39,6 +39,8 @@
 #define TPG_GRAPH_H
 
 #include <list>
+#include <map>
+#include <unordered_map>
 
 #include "environment.h"
 #include "tpg/tpgAction.h"
@@ -87,8 +89,15 @@ namespace TPG {
         friend inline void swap(TPGGraph& a, TPGGraph& b)
         {
             using std::swap;
+            // The factory follows the elements it created, and keeps their
+            // storage alive.
+            swap(a.factory, b.factory);
             swap(a.vertices, b.vertices);
             swap(a.edges, b.edges);
+            swap(a.vertexIndex, b.vertexIndex);
+            swap(a.edgeIndex, b.edgeIndex);
+            swap(a.rootVertices, b.rootVertices);
+            swap(a.nextVertexOrder, b.nextVertexOrder);
         }
 
         /**
@@ -307,7 +316,7 @@ namespace TPG {
         const Environment& env;
 
         /// TPGFactory of the TPGGraph
-        const std::unique_ptr<TPGFactory> factory;
+        std::unique_ptr<TPGFactory> factory;
 
         /**
          * \brief Set of TPGVertex composing the TPGGraph.
@@ -319,6 +328,63 @@ namespace TPG {
          */
         std::list<std::unique_ptr<TPGEdge>> edges;
 
+        /// Position of a TPGVertex in the TPGGraph.
+        struct VertexPosition
+        {
+            /// Iterator on the vertices attribute.
+            std::list<TPGVertex*>::iterator iterator;
+
+            /// Rank of insertion of the TPGVertex in the TPGGraph.
+            uint64_t order;
+        };
+
+        /**
+         * \brief Index associating each TPGVertex of the TPGGraph to its
+         * position.
+         *
+         * This index makes the lookup of vertices independent of the size of
+         * the TPGGraph.
+         */
+        std::unordered_map<const TPGVertex*, VertexPosition> vertexIndex;
+
+        /**
+         * \brief Index associating each TPGEdge of the TPGGraph to its
+         * position in the edges attribute.
+         */
+        std::unordered_map<const TPGEdge*,
+                           std::list<std::unique_ptr<TPGEdge>>::iterator>
+            edgeIndex;
+
+        /**
+         * \brief Root TPGVertex of the TPGGraph, sorted by insertion order.
+         *
+         * Since vertices are always added at the back of the vertices list,
+         * the insertion order of a TPGVertex is also its order in the
+         * vertices list. This map is updated whenever the incoming edges of
+         * a TPGVertex of the TPGGraph are modified.
+         */
+        std::map<uint64_t, const TPGVertex*> rootVertices;
+
+        /// Insertion order given to the next TPGVertex added to the TPGGraph.
+        uint64_t nextVertexOrder = 0;
+
+        /**
+         * \brief Add a newly created TPGVertex at the back of the vertices
+         * of the TPGGraph and register it in the indexes.
+         *
+         * \param[in] vertex pointer to the new TPGVertex.
+         */
+        void addVertex(TPGVertex* vertex);
+
+        /**
+         * \brief Update the presence of a TPGVertex in the rootVertices,
+         * depending on the number of its incoming edges.
+         *
+         * \param[in] vertex the TPGVertex of the TPGGraph whose incoming edges
+         * were modified.
+         */
+        void updateRootStatus(const TPGVertex* vertex);
+
         /**
          * \brief Find the non-const iterator to a vertex of the graph from
          * its const pointer.
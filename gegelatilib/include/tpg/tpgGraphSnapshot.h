@@ -0,0 +1,173 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef TPG_GRAPH_SNAPSHOT_H
+#define TPG_GRAPH_SNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "environment.h"
+#include "program/compiledProgram.h"
+#include "program/program.h"
+#include "tpg/tpgGraph.h"
+#include "tpg/tpgVertex.h"
+
+namespace TPG {
+    /**
+     * \brief Immutable, flattened representation of a TPGGraph for inference.
+     *
+     * The snapshot stores the TPGVertex and TPGEdge of a TPGGraph in
+     * contiguous arrays, in a compressed sparse row layout: the outgoing
+     * edges of each team are stored consecutively in the edges array, and
+     * each vertex stores the index of its first outgoing edge and its number
+     * of outgoing edges. Action identifiers are stored inline in the vertices
+     * array, and the Program of the edges are stored once, as
+     * Program::CompiledProgram, even when shared by several edges.
+     *
+     * The snapshot keeps the Program of the TPGGraph alive with shared
+     * pointers, but does not follow later modifications of the TPGGraph or of
+     * its Program. A new snapshot must be built after each modification,
+     * for example after each call to TPGMutator::populateTPG().
+     */
+    class TPGGraphSnapshot
+    {
+      public:
+        /// Vertex of the snapshot.
+        struct Vertex
+        {
+            /// Whether the vertex is a TPGAction.
+            bool isAction;
+
+            /// Identifier of the action, for TPGAction vertices.
+            uint64_t actionID;
+
+            /// Index of the first outgoing edge of the vertex in the edges.
+            uint64_t firstEdge;
+
+            /// Number of outgoing edges of the vertex.
+            uint64_t nbEdges;
+        };
+
+        /// Edge of the snapshot.
+        struct Edge
+        {
+            /// Index of the Program of the edge in the compiledPrograms.
+            uint64_t programIndex;
+
+            /// Index of the destination vertex of the edge in the vertices.
+            uint64_t destination;
+        };
+
+      protected:
+        /// Environment of the TPGGraph.
+        const Environment& env;
+
+        /// Vertices of the snapshot, in the order of the TPGGraph vertices.
+        std::vector<Vertex> vertices;
+
+        /// Edges of the snapshot, grouped by source vertex.
+        std::vector<Edge> edges;
+
+        /// Indexes of the root vertices, in the order of the TPGGraph.
+        std::vector<uint64_t> roots;
+
+        /// Program of the TPGGraph, kept alive by the snapshot.
+        std::vector<std::shared_ptr<Program::Program>> programs;
+
+        /// Compiled Program, with the same indexes as the programs.
+        std::vector<Program::CompiledProgram> compiledPrograms;
+
+        /// TPGVertex of the TPGGraph corresponding to each vertex.
+        std::vector<const TPGVertex*> graphVertices;
+
+        /// Index of each TPGVertex of the TPGGraph in the vertices.
+        std::unordered_map<const TPGVertex*, uint64_t> vertexIndexes;
+
+      public:
+        /// Default constructor is deleted.
+        TPGGraphSnapshot() = delete;
+
+        /**
+         * \brief Build the snapshot of a TPGGraph.
+         *
+         * Introns of the Program of the TPGGraph are expected to be
+         * identified before building the snapshot, as for the
+         * Program::CompiledProgram.
+         *
+         * \param[in] graph the TPGGraph whose snapshot is built.
+         */
+        explicit TPGGraphSnapshot(const TPGGraph& graph);
+
+        /// Get the Environment of the TPGGraph.
+        const Environment& getEnvironment() const;
+
+        /// Get the vertices of the snapshot.
+        const std::vector<Vertex>& getVertices() const;
+
+        /// Get the edges of the snapshot.
+        const std::vector<Edge>& getEdges() const;
+
+        /// Get the indexes of the root vertices of the snapshot.
+        const std::vector<uint64_t>& getRoots() const;
+
+        /// Get the compiled Program of the snapshot.
+        const std::vector<Program::CompiledProgram>& getCompiledPrograms()
+            const;
+
+        /**
+         * \brief Get the TPGVertex of the TPGGraph corresponding to a vertex
+         * of the snapshot.
+         *
+         * \param[in] index the index of the vertex in the snapshot.
+         * \return a pointer to the TPGVertex.
+         * \throw std::out_of_range if the index is invalid.
+         */
+        const TPGVertex* getGraphVertex(uint64_t index) const;
+
+        /**
+         * \brief Get the index of the vertex of the snapshot corresponding to
+         * a TPGVertex of the TPGGraph.
+         *
+         * \param[in] vertex the TPGVertex of the TPGGraph.
+         * \return the index of the vertex in the snapshot.
+         * \throw std::out_of_range if the TPGVertex was not in the TPGGraph
+         * when the snapshot was built.
+         */
+        uint64_t getVertexIndex(const TPGVertex& vertex) const;
+    };
+}; // namespace TPG
+
+#endif
@@ -0,0 +1,272 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef TPG_SNAPSHOT_EXECUTION_ENGINE_H
+#define TPG_SNAPSHOT_EXECUTION_ENGINE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "archive.h"
+#include "program/nativeProgram.h"
+#include "program/programExecutionEngine.h"
+#include "tpg/tpgGraphSnapshot.h"
+
+namespace TPG {
+    /**
+     * \brief Class in charge of executing a TPGGraphSnapshot.
+     *
+     * This engine is the counterpart of the TPGExecutionEngine for a
+     * TPGGraphSnapshot. Executions from a root produce the same traces and
+     * the same Archive recordings as the TPGExecutionEngine on the TPGGraph
+     * from which the snapshot was built, but browse contiguous arrays
+     * instead of the lists of the TPGGraph, execute Program::CompiledProgram
+     * and store the trace of each execution in a reused vector.
+     *
+     * Since the Program of a snapshot are immutable, the engine can also
+     * reuse the bid computed by a Program during a previous execution, as
+     * long as none of the environment data read by its non-intron lines was
+     * modified since then. This temporal bid cache, disabled by default,
+     * relies on the modification tracking of the DataHandler (see
+     * Data::DataHandler::isModifiedSince()) and makes the cost of successive
+     * inferences proportional to the amount of modified data.
+     *
+     * The engine can also execute the Programs of the snapshot as native
+     * machine code (see Program::NativeProgram), an option disabled by
+     * default.
+     */
+    class TPGSnapshotExecutionEngine
+    {
+      protected:
+        /// Snapshot executed by the engine.
+        const TPGGraphSnapshot& snapshot;
+
+        /// Archive for recording Program results.
+        Archive* archive;
+
+        /// ProgramExecutionEngine for executing Programs of edges.
+        Program::ProgramExecutionEngine progExecutionEngine;
+
+        /// Indexes of the vertices traversed during the last execution.
+        std::vector<uint64_t> trace;
+
+        /// Native addresses of an environment data source read by a Program.
+        struct DataDependency
+        {
+            /// Index of the data source in the environment data sources.
+            uint64_t dataSourceIndex;
+
+            /// Sorted native addresses read in the data source.
+            std::vector<size_t> addresses;
+        };
+
+        /// Entry of the temporal bid cache for a Program of the snapshot.
+        struct TemporalBid
+        {
+            /// Whether the dependencies of the Program were computed.
+            bool dependenciesComputed = false;
+
+            /// Environment data read by the non-intron lines of the Program.
+            std::vector<DataDependency> dependencies;
+
+            /// Whether the cached bid can be reused.
+            bool valid = false;
+
+            /// Bid computed by the last execution of the Program.
+            double bid = 0.0;
+
+            /// Modification version of the data source of each dependency
+            /// when the bid was computed.
+            std::vector<uint64_t> versions;
+        };
+
+        /// Whether bids are reused across executions of the engine.
+        bool temporalBidCacheEnabled;
+
+        /// Index of the first environment data source among the data
+        /// sources indexed by CompiledOperand::dataSourceIndex.
+        const uint64_t envDataSourceOffset;
+
+        /// Temporal bid cache entries, indexed like the compiled Programs of
+        /// the snapshot.
+        std::vector<TemporalBid> temporalBids;
+
+        /// Whether Programs are executed as native code.
+        bool nativeProgramsEnabled;
+
+        /// Native translation of the compiled Programs of the snapshot,
+        /// indexed like them.
+        std::vector<std::unique_ptr<Program::NativeProgram>> nativePrograms;
+
+        /**
+         * \brief Compute the environment data read by a Program of the
+         * snapshot.
+         *
+         * \param[in,out] entry the temporal bid cache entry where the
+         * dependencies are stored.
+         * \param[in] compiled the CompiledProgram of the entry.
+         */
+        void computeDataDependencies(
+            TemporalBid& entry, const Program::CompiledProgram& compiled) const;
+
+        /**
+         * \brief Check whether the bid of a temporal bid cache entry can be
+         * reused.
+         *
+         * \param[in] entry the temporal bid cache entry.
+         * \return true if the entry is valid and none of its dependencies
+         * was modified since its bid was computed.
+         */
+        bool isTemporalBidReusable(const TemporalBid& entry) const;
+
+      public:
+        /**
+         * \brief Main constructor of the class.
+         *
+         * \param[in] env Environment in which the Program of the snapshot
+         *                will be executed.
+         * \param[in] snapshot the TPGGraphSnapshot executed by the engine.
+         * \param[in] arch pointer to the Archive for storing recordings of
+         *                 the Program Execution. By default, a NULL pointer is
+         *                 given, meaning that no recording of the execution
+         *                 will be made.
+         */
+        TPGSnapshotExecutionEngine(const Environment& env,
+                                   const TPGGraphSnapshot& snapshot,
+                                   Archive* arch = NULL)
+            : snapshot{snapshot}, archive{arch}, progExecutionEngine(env),
+              temporalBidCacheEnabled{false},
+              envDataSourceOffset{(env.getNbConstant() > 0) ? 2u : 1u},
+              nativeProgramsEnabled{false} {};
+
+        /**
+         * \brief Set a new Archive for storing Program results.
+         *
+         * \param[in] newArchive A pointer (possibly NULL) to an Archive.
+         */
+        void setArchive(Archive* newArchive);
+
+        /**
+         * \brief Enable or disable the temporal bid cache.
+         *
+         * When enabled, the bid of a Program is reused from a previous
+         * execution of the engine, unless one of the addresses of the
+         * environment data sources read by its non-intron lines was modified
+         * in the meantime. Data sources not supporting the tracking of
+         * modifications are always considered modified.
+         *
+         * Instructions of the Environment are expected to be deterministic.
+         * Disabling the cache empties it.
+         *
+         * \param[in] enabled whether the temporal bid cache is used.
+         */
+        void setTemporalBidCacheEnabled(bool enabled);
+
+        /// Whether the temporal bid cache is enabled.
+        bool isTemporalBidCacheEnabled() const;
+
+        /**
+         * \brief Invalidate all bids stored in the temporal bid cache.
+         *
+         * Dependencies of the Programs are kept, as they only depend on the
+         * snapshot.
+         */
+        void clearTemporalBidCache();
+
+        /**
+         * \brief Enable or disable the execution of Programs as native code.
+         *
+         * When enabled, all compiled Programs of the snapshot are translated
+         * into Program::NativeProgram, and executed with
+         * Program::ProgramExecutionEngine::executeNativeProgram(). Programs
+         * that cannot be translated are executed by the interpreter, so
+         * results of the engine are unchanged. Disabling the option
+         * releases the native code.
+         *
+         * \param[in] enabled whether Programs are executed as native code.
+         */
+        void setNativeProgramsEnabled(bool enabled);
+
+        /// Whether Programs are executed as native code.
+        bool isNativeProgramsEnabled() const;
+
+        /**
+         * \brief Execute the Program associated to an edge of the snapshot.
+         *
+         * As in TPGExecutionEngine::evaluateEdge(), NaN results are replaced
+         * with -inf, and results are recorded in the Archive, if any.
+         *
+         * When the temporal bid cache is enabled, the Program is executed
+         * only if its cached bid cannot be reused.
+         *
+         * \param[in] edgeIndex the index of the edge in the snapshot.
+         * \return the double value returned by the Program of the edge.
+         */
+        double evaluateEdge(uint64_t edgeIndex);
+
+        /**
+         * \brief Evaluate all the outgoing edges of a team of the snapshot.
+         *
+         * \param[in] vertexIndex the index of the team in the snapshot.
+         * \return the index of the edge with the highest bid. In case of
+         * equality, the last edge with the highest bid is returned.
+         * \throw std::runtime_error if the team has no outgoing edge.
+         */
+        uint64_t evaluateTeam(uint64_t vertexIndex);
+
+        /**
+         * \brief Execute the snapshot starting from the given vertex.
+         *
+         * \param[in] vertexIndex the index of the vertex from which the
+         * execution starts.
+         * \return a reference to the indexes of the vertices traversed during
+         * the execution. The action resulting from the execution is at the
+         * end of the returned vector. The content of the vector is valid
+         * until the next execution.
+         */
+        const std::vector<uint64_t>& executeFromRoot(uint64_t vertexIndex);
+
+        /**
+         * \brief Execute the snapshot starting from the given vertex and
+         * returns the identifier of the reached action.
+         *
+         * \param[in] vertexIndex the index of the vertex from which the
+         * execution starts.
+         * \return the actionID of the action reached by the execution.
+         */
+        uint64_t executeActionFromRoot(uint64_t vertexIndex);
+    };
+}; // namespace TPG
+
+#endif
@@ -0,0 +1,179 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Util {
+    /**
+     * \brief Persistent pool of threads executing batches of indexed jobs.
+     *
+     * The ThreadPool creates its worker threads once, at construction, and
+     * keeps them alive until its destruction, so that successive batches of
+     * jobs do not pay the cost of thread creation.
+     *
+     * A batch of jobs is executed with the parallelFor() method. Each job is
+     * identified by its index in the batch, and jobs are initially
+     * distributed by contiguous blocks in one double-ended queue per thread.
+     * Each thread processes jobs from the front of its own queue, and steals
+     * jobs from the back of the queues of other threads when its own queue
+     * is empty.
+     *
+     * The thread calling parallelFor() participates to the execution of the
+     * jobs, as the thread with index 0. Hence, a ThreadPool with nbThreads
+     * threads creates only nbThreads - 1 worker threads.
+     *
+     * Since each job receives its own index, results should be stored by the
+     * executed function in pre-allocated slots indexed by the job index,
+     * which requires no synchronization and makes the results independent
+     * from the scheduling of jobs among threads.
+     */
+    class ThreadPool
+    {
+      public:
+        /**
+         * \brief Function executed for each job.
+         *
+         * The first argument is the index of the job in the batch, the second
+         * argument is the index of the thread executing the job, in
+         * [0, getNbThreads()[.
+         */
+        using Task = std::function<void(uint64_t jobIdx, uint64_t threadIdx)>;
+
+      protected:
+        /// Double-ended queue of job indexes of one thread.
+        struct JobQueue
+        {
+            /// Mutex protecting the jobs.
+            std::mutex mutex;
+
+            /// Indexes of the jobs to process.
+            std::deque<uint64_t> jobs;
+        };
+
+        /// Total number of threads, including the calling thread.
+        const uint64_t nbThreads;
+
+        /// Job queues, one per thread.
+        std::vector<std::unique_ptr<JobQueue>> queues;
+
+        /// Worker threads.
+        std::vector<std::thread> workers;
+
+        /// Mutex protecting the batch state.
+        std::mutex batchMutex;
+
+        /// Condition variable used to wake up workers on a new batch.
+        std::condition_variable batchStart;
+
+        /// Condition variable used to signal the end of a batch.
+        std::condition_variable batchEnd;
+
+        /// Function executed for the jobs of the current batch.
+        const Task* task;
+
+        /// Counter of batches, used by workers to detect a new batch.
+        uint64_t batchCounter;
+
+        /// Number of workers still processing the current batch.
+        uint64_t nbActiveWorkers;
+
+        /// Whether the workers must stop.
+        bool stopWorkers;
+
+        /// First exception thrown by a job of the current batch.
+        std::exception_ptr exception;
+
+        /**
+         * \brief Get the index of the next job to process for a thread.
+         *
+         * \param[in] threadIdx the index of the thread.
+         * \param[out] jobIdx the index of the job to process.
+         * \return false if no job remains in any queue.
+         */
+        bool popJob(uint64_t threadIdx, uint64_t& jobIdx);
+
+        /// Process jobs of the current batch until all queues are empty.
+        void processJobs(uint64_t threadIdx);
+
+        /// Main loop of worker threads.
+        void workerLoop(uint64_t threadIdx);
+
+      public:
+        /**
+         * \brief Constructor of the ThreadPool.
+         *
+         * \param[in] nbThreads total number of threads executing the jobs,
+         * including the thread calling parallelFor(). A value of 0 is
+         * treated as 1.
+         */
+        explicit ThreadPool(uint64_t nbThreads);
+
+        /// The ThreadPool is not copyable.
+        ThreadPool(const ThreadPool&) = delete;
+
+        /// The ThreadPool is not copyable.
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// Destructor stops and joins the worker threads.
+        ~ThreadPool();
+
+        /// Get the total number of threads, including the calling thread.
+        uint64_t getNbThreads() const;
+
+        /**
+         * \brief Execute a batch of jobs and wait for its completion.
+         *
+         * This method is not reentrant: it must not be called from a job, and
+         * must not be called concurrently from several threads.
+         *
+         * \param[in] nbJobs the number of jobs of the batch.
+         * \param[in] task the function called for each job.
+         * \throws any exception thrown by a job is re-thrown once all other
+         * jobs of the batch are completed.
+         */
+        void parallelFor(uint64_t nbJobs, const Task& task);
+    };
+} // namespace Util
+
+#endif // THREAD_POOL_H
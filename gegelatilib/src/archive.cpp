@@ -33,13 +33,16 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <math.h>
+#include <unordered_set>
 
 #include "archive.h"
 
 Archive::~Archive()
 {
-    for (auto dHandlerAndHash : this->dataHandlers) {
+    for (const auto& dHandlerAndHash : this->dataHandlers) {
         for (auto dHandler : dHandlerAndHash.second) {
             // Free memory of DataHandlers within the archive
             delete &dHandler.get();
@@ -82,7 +85,8 @@ void Archive::addRecording(
         size_t hash = getCombinedHash(dHandler);
 
         // Check if dataHandler copy is needed.
-        if (this->dataHandlers.find(hash) == this->dataHandlers.end()) {
+        size_t& nbRecordingsForHash = this->nbRecordingsPerDataHandlers[hash];
+        if (nbRecordingsForHash == 0) {
             // Store a copy of data handlers.
             std::vector<std::reference_wrapper<const Data::DataHandler>>
                 dHandlersCpy;
@@ -94,11 +98,18 @@ void Archive::addRecording(
             // Create the map entry
             this->dataHandlers.emplace(hash, std::move(dHandlersCpy));
         }
+        nbRecordingsForHash++;
 
         // Create and stores the recording
         ArchiveRecording recording{program, hash, result};
         this->recordings.push_back(recording);
 
+        // Update the results index
+        if (std::isfinite(result)) {
+            this->resultsIndex[{hash, this->getResultsIndexInterval(result)}]
+                              [program]++;
+        }
+
         // Update the recordings per Program
         auto iterNbRecordings = this->recordingsPerProgram.find(program);
         if (iterNbRecordings != this->recordingsPerProgram.end()) {
@@ -118,22 +129,37 @@ void Archive::addRecording(
 
             // Check if this DataHandler (hash) is still used in other
             // recordings
-            bool stillUsed =
-                (std::find_if(this->recordings.begin(), this->recordings.end(),
-                              [&rec](ArchiveRecording r) {
-                                  return r.dataHash == rec.dataHash;
-                              })) != this->recordings.end();
+            auto iterNbRecordingsForHash =
+                this->nbRecordingsPerDataHandlers.find(rec.dataHash);
+            iterNbRecordingsForHash->second--;
 
             // if not, remove it from the Archive also
-            if (!stillUsed) {
+            if (iterNbRecordingsForHash->second == 0) {
+                auto iterDataHandlers = this->dataHandlers.find(rec.dataHash);
                 // Free memory of DataHandlers within the archive
                 for (std::reference_wrapper<const Data::DataHandler> toErase :
-                     this->dataHandlers.at(rec.dataHash)) {
+                     iterDataHandlers->second) {
                     delete &toErase.get();
                 }
 
-                // Remove the entry from the map
-                this->dataHandlers.erase(rec.dataHash);
+                // Remove the entries from the maps
+                this->dataHandlers.erase(iterDataHandlers);
+                this->nbRecordingsPerDataHandlers.erase(
+                    iterNbRecordingsForHash);
+            }
+
+            // Update the results index
+            if (std::isfinite(rec.result)) {
+                auto iterIndex = this->resultsIndex.find(
+                    {rec.dataHash, this->getResultsIndexInterval(rec.result)});
+                auto iterProgram = iterIndex->second.find(rec.prog);
+                iterProgram->second--;
+                if (iterProgram->second == 0) {
+                    iterIndex->second.erase(iterProgram);
+                    if (iterIndex->second.empty()) {
+                        this->resultsIndex.erase(iterIndex);
+                    }
+                }
             }
 
             // Update the recordingsPerProgram of the corresponding Program,
@@ -149,48 +175,110 @@ void Archive::addRecording(
 
 bool Archive::hasDataHandlers(const size_t& hash) const
 {
-    return this->dataHandlers.count(hash) != 0;
+    return this->nbRecordingsPerDataHandlers.count(hash) != 0;
 }
 
-bool Archive::areProgramResultsUnique(
-    const std::map<size_t, double>& hashesAndResults, double tau) const
+int64_t Archive::getResultsIndexInterval(double result) const
 {
-    // Check programs until one is equivalent or until all have been checked.
-    for (auto programRecordings : this->recordingsPerProgram) {
-        // check all recordings "presence" within the hashesAndResults map.
-        bool isIdentical = false;
-        for (const auto& recording : programRecordings.second) {
-            // For each recording there are three possibilities
-            // 1- there is no result for this hash in the Map
-            //    > Nothing to do for this recording
-            // 2- there is a different result in the Map
-            //    > Put isIdentical to false and stop browsing the recordings
-            //    for this program.
-            // 3- there is an "identical" (within tau margin) result in the Map
-            //    > Put the isIdentical to true. If at the end of all recordings
-            //    the isIdentical is true > The program bid behavior is marked
-            //    as equivalent.
-            auto iter = hashesAndResults.find(recording.dataHash);
-            if (iter != hashesAndResults.end()) {
-                // Cases 2 & 3
-                if (std::abs(iter->second - recording.result) <= tau) {
-                    // results are equivalent
-                    isIdentical = true;
-                }
-                else {
-                    isIdentical = false;
-                    break; // break for recordings loop
-                }
+    // Saturate to keep the conversion to integer well defined.
+    const double maxInterval = (double)(INT64_MAX / 2);
+    double interval = std::floor(result / this->resultsIndexResolution);
+    interval = std::max(-maxInterval, std::min(maxInterval, interval));
+    return (int64_t)interval;
+}
+
+bool Archive::areRecordingsEquivalent(
+    const std::deque<ArchiveRecording>& programRecordings,
+    const std::map<size_t, double>& hashesAndResults, double tau)
+{
+    // check all recordings "presence" within the hashesAndResults map.
+    bool isIdentical = false;
+    for (const auto& recording : programRecordings) {
+        // For each recording there are three possibilities
+        // 1- there is no result for this hash in the Map
+        //    > Nothing to do for this recording
+        // 2- there is a different result in the Map
+        //    > Put isIdentical to false and stop browsing the recordings
+        //    for this program.
+        // 3- there is an "identical" (within tau margin) result in the Map
+        //    > Put the isIdentical to true. If at the end of all recordings
+        //    the isIdentical is true > The program bid behavior is marked
+        //    as equivalent.
+        auto iter = hashesAndResults.find(recording.dataHash);
+        if (iter != hashesAndResults.end()) {
+            // Cases 2 & 3
+            if (std::abs(iter->second - recording.result) <= tau) {
+                // results are equivalent
+                isIdentical = true;
             }
             else {
-                // Case 1 > do nothing
+                isIdentical = false;
+                break; // break for recordings loop
             }
         }
+        else {
+            // Case 1 > do nothing
+        }
+    }
+
+    return isIdentical;
+}
+
+bool Archive::areProgramResultsUnique(
+    const std::map<size_t, double>& hashesAndResults, double tau) const
+{
+    // If the tau margin is too wide for the results index, or if browsing
+    // the index would require more lookups than there are recordings to scan
+    // in the Archive, check programs until one is equivalent or until all
+    // have been checked.
+    const bool useIndex =
+        tau <= MAX_INDEXED_TAU_RATIO * this->resultsIndexResolution &&
+        hashesAndResults.size() *
+                (size_t)(2.0 * tau / this->resultsIndexResolution + 3.0) <
+            this->recordings.size();
+    if (!useIndex) {
+        for (const auto& programRecordings : this->recordingsPerProgram) {
+            // If Programs have equivalent bidding behaviour
+            if (areRecordingsEquivalent(programRecordings.second,
+                                        hashesAndResults, tau)) {
+                return false;
+            } // else, go to the next Program comparison
+        }
+        return true;
+    }
 
-        // If isIdentical is 1 => Programs have equivalent bidding behaviour
-        if (isIdentical) {
-            return false;
-        } // else, go to the next Program comparison
+    // An equivalent Program has at least one recording with a result within
+    // the tau margin of a result from the map. Only these Programs are
+    // checked, using the results index.
+    std::unordered_set<const Program::Program*> checkedPrograms;
+    for (const auto& hashAndResult : hashesAndResults) {
+        if (!std::isfinite(hashAndResult.second)) {
+            continue;
+        }
+
+        // Browse all intervals within the tau margin (with an extra interval
+        // on each side to be safe with rounding errors).
+        const int64_t firstInterval =
+            this->getResultsIndexInterval(hashAndResult.second - tau) - 1;
+        const int64_t lastInterval =
+            this->getResultsIndexInterval(hashAndResult.second + tau) + 1;
+        for (int64_t interval = firstInterval; interval <= lastInterval;
+             interval++) {
+            auto iterIndex =
+                this->resultsIndex.find({hashAndResult.first, interval});
+            if (iterIndex == this->resultsIndex.end()) {
+                continue;
+            }
+
+            for (const auto& programAndCount : iterIndex->second) {
+                const Program::Program* prog = programAndCount.first;
+                if (checkedPrograms.insert(prog).second &&
+                    areRecordingsEquivalent(this->recordingsPerProgram.at(prog),
+                                            hashesAndResults, tau)) {
+                    return false;
+                }
+            }
+        }
     }
 
     return true;
@@ -215,7 +303,7 @@ Archive::getDataHandlers() const
 
 void Archive::clear()
 {
-    for (auto dHandlerAndHash : this->dataHandlers) {
+    for (const auto& dHandlerAndHash : this->dataHandlers) {
         for (auto dHandler : dHandlerAndHash.second) {
             // Free memory of DataHandlers within the archive
             delete &dHandler.get();
@@ -223,6 +311,8 @@ void Archive::clear()
     }
 
     this->dataHandlers.clear();
+    this->nbRecordingsPerDataHandlers.clear();
     this->recordings.clear();
     this->recordingsPerProgram.clear();
+    this->resultsIndex.clear();
 }
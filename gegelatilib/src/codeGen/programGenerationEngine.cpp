@@ -35,6 +35,10 @@
  */
 
 #ifdef CODE_GENERATION
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
 #include "codeGen/programGenerationEngine.h"
 #include "util/timestamp.h"
 
@@ -43,6 +47,22 @@ const std::string CodeGen::ProgramGenerationEngine::nameRegVariable("reg");
 const std::string CodeGen::ProgramGenerationEngine::nameConstantVariable("cst");
 const std::string CodeGen::ProgramGenerationEngine::nameDataVariable("in");
 const std::string CodeGen::ProgramGenerationEngine::nameOperandVariable("op");
+const std::string CodeGen::ProgramGenerationEngine::nameContextType(
+    "TPGContext");
+const std::string CodeGen::ProgramGenerationEngine::nameContextVariable("ctx");
+const std::string CodeGen::ProgramGenerationEngine::nameBatchInputType("in_t");
+const std::string CodeGen::ProgramGenerationEngine::nameBatchInputVariable(
+    "input");
+
+bool CodeGen::ProgramGenerationEngine::isReentrant() const
+{
+    return this->reentrant;
+}
+
+bool CodeGen::ProgramGenerationEngine::isBatch() const
+{
+    return this->batch;
+}
 
 void CodeGen::ProgramGenerationEngine::generateCurrentLine()
 {
@@ -66,19 +86,33 @@ void CodeGen::ProgramGenerationEngine::generateCurrentLine()
 void CodeGen::ProgramGenerationEngine::generateProgram(
     uint64_t progID, const bool ignoreException)
 {
-    fileC << "\ndouble P" << progID << "(){" << std::endl;
-    fileH << "double P" << progID << "();" << std::endl;
+    const std::string parameters =
+        (this->reentrant) ? nameContextType + "* " + nameContextVariable : "";
+    fileC << "\ndouble P" << progID << "(" << parameters << "){" << std::endl;
+    fileH << "double P" << progID << "(" << parameters << ");" << std::endl;
 
     // instantiate register
-    fileC << "\tdouble " << nameRegVariable << "["
-          << program->getEnvironment().getNbRegisters() << "] = {";
-    for (int i = 0; i < program->getEnvironment().getNbRegisters(); ++i) {
-        fileC << "0";
-        if (i < program->getEnvironment().getNbRegisters() - 1) {
-            fileC << ", ";
+    const size_t nbRegisters = program->getEnvironment().getNbRegisters();
+    if (this->reentrant) {
+        // Registers of the context are reset for each program.
+        fileC << "\tdouble* " << nameRegVariable << " = "
+              << nameContextVariable << "->" << nameRegVariable << ";"
+              << std::endl;
+        fileC << "\tfor (int i = 0; i < " << nbRegisters << "; i++) {\n"
+              << "\t\t" << nameRegVariable << "[i] = 0;\n"
+              << "\t}" << std::endl;
+    }
+    else {
+        fileC << "\tdouble " << nameRegVariable << "[" << nbRegisters
+              << "] = {";
+        for (int i = 0; i < nbRegisters; ++i) {
+            fileC << "0";
+            if (i < nbRegisters - 1) {
+                fileC << ", ";
+            }
         }
+        fileC << "};" << std::endl;
     }
-    fileC << "};" << std::endl;
     if (program->getEnvironment().getNbConstant() > 0) {
         size_t nbCst = program->getEnvironment().getNbConstant();
         fileC << "\tint32_t " << nameConstantVariable << "[" << nbCst
@@ -102,12 +136,304 @@ void CodeGen::ProgramGenerationEngine::generateProgram(
     fileC << "\treturn reg[0];\n}" << std::endl;
 }
 
-std::string CodeGen::ProgramGenerationEngine::completeFormat(
-    const Instructions::Instruction& instruction) const
+void CodeGen::ProgramGenerationEngine::generateBatchProgram(
+    uint64_t progID, const bool ignoreException)
+{
+    if (!this->batch) {
+        throw std::runtime_error(
+            "Batch programs can only be generated in batch mode.");
+    }
+
+    const std::string parameters = "const " + nameBatchInputType +
+                                   "* inputs, const int* samples, int n, "
+                                   "double* bids";
+    fileC << "\nvoid P" << progID << "Batch(" << parameters << "){"
+          << std::endl;
+    fileH << "void P" << progID << "Batch(" << parameters << ");"
+          << std::endl;
+
+    fileC << "\tfor (int s = 0; s < n; s++) {" << std::endl;
+    fileC << "\t\tconst " << nameBatchInputType << "* "
+          << nameBatchInputVariable << " = inputs + samples[s];" << std::endl;
+
+    // instantiate register for each sample
+    const size_t nbRegisters = program->getEnvironment().getNbRegisters();
+    fileC << "\t\tdouble " << nameRegVariable << "[" << nbRegisters
+          << "] = {";
+    for (int i = 0; i < nbRegisters; ++i) {
+        fileC << "0";
+        if (i < nbRegisters - 1) {
+            fileC << ", ";
+        }
+    }
+    fileC << "};" << std::endl;
+    if (program->getEnvironment().getNbConstant() > 0) {
+        size_t nbCst = program->getEnvironment().getNbConstant();
+        fileC << "\t\tint32_t " << nameConstantVariable << "[" << nbCst
+              << "] = {";
+        for (int i = 0; i < nbCst; ++i) {
+            fileC << program->getConstantAt(i).value;
+            if (i < nbCst - 1) {
+                fileC << ", ";
+            }
+        }
+        fileC << "};" << std::endl;
+    }
+
+    this->batchGeneration = true;
+    try {
+        iterateThroughtProgram(ignoreException);
+    }
+    catch (...) {
+        this->batchGeneration = false;
+        throw; // rethrow
+    }
+    this->batchGeneration = false;
+
+    fileC << "\t\tbids[s] = " << nameRegVariable << "[0];\n\t}\n}"
+          << std::endl;
+}
+
+bool CodeGen::ProgramGenerationEngine::isOptimizable(const Program::Program& p)
+{
+    const bool hasConstants = p.getEnvironment().getNbConstant() > 0;
+    const Instructions::Set& instructionSet =
+        p.getEnvironment().getInstructionSet();
+    for (uint64_t l = 0; l < p.getNbLines(); l++) {
+        if (p.isIntron(l)) {
+            continue;
+        }
+        const Program::Line& line = p.getLine(l);
+        const Instructions::Instruction& instruction =
+            instructionSet.getInstruction(line.getInstructionIndex());
+        for (uint64_t i = 0; i < instruction.getNbOperands(); i++) {
+            const uint64_t sourceIdx = line.getOperand(i).first;
+            const std::type_info& operandType =
+                instruction.getOperandTypes().at(i).get();
+            if (sourceIdx == 0 && operandType != typeid(double)) {
+                return false;
+            }
+            if (hasConstants && sourceIdx == 1 &&
+                operandType != typeid(Data::Constant)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void CodeGen::ProgramGenerationEngine::generateTeamBids(
+    uint64_t teamID,
+    const std::vector<std::pair<const Program::Program*, uint64_t>>& programs)
+{
+    for (const auto& [p, bidIdx] : programs) {
+        if (!isOptimizable(*p)) {
+            throw std::invalid_argument(
+                "The program cannot be part of the bids of a team.");
+        }
+    }
+
+    // Value-number all the programs together
+    std::vector<OptimizedValue> values;
+    std::unordered_map<std::string, uint64_t> index;
+    std::vector<uint64_t> results;
+    for (const auto& [p, bidIdx] : programs) {
+        results.push_back(this->analyzeProgram(*p, values, index));
+    }
+
+    // Keep only values contributing to a bid
+    std::vector<bool> needed(values.size(), false);
+    std::vector<uint64_t> toVisit(results);
+    while (!toVisit.empty()) {
+        const uint64_t idx = toVisit.back();
+        toVisit.pop_back();
+        if (needed.at(idx)) {
+            continue;
+        }
+        needed.at(idx) = true;
+        for (const OptimizedOperand& op : values.at(idx).operands) {
+            if (op.kind == OptimizedOperand::Kind::VALUE) {
+                toVisit.push_back((uint64_t)op.id);
+            }
+        }
+    }
+
+    const std::string parameters =
+        ((this->reentrant) ? nameContextType + "* " + nameContextVariable + ", "
+                           : "") +
+        "double* bids";
+    fileC << "\nvoid T" << teamID << "Bids(" << parameters << "){"
+          << std::endl;
+    fileH << "void T" << teamID << "Bids(" << parameters << ");" << std::endl;
+
+    // Values are created after their operands
+    for (uint64_t idx = 0; idx < values.size(); idx++) {
+        const OptimizedValue& value = values.at(idx);
+        if (!needed.at(idx) || value.isLiteral) {
+            continue;
+        }
+        fileC << "\tdouble " << printValue(values, idx) << ";\n"
+              << "\t{" << std::endl;
+        for (uint64_t i = 0; i < value.operands.size(); i++) {
+            const OptimizedOperand& op = value.operands.at(i);
+            fileC << "\t\t"
+                  << value.instruction->getPrintablePrimitiveOperandType(i)
+                  << " " << nameOperandVariable << i;
+            switch (op.kind) {
+            case OptimizedOperand::Kind::VALUE:
+                fileC << " = " << printValue(values, (uint64_t)op.id) << ";";
+                break;
+            case OptimizedOperand::Kind::CONSTANT:
+                fileC << " = " << op.id << ";";
+                break;
+            case OptimizedOperand::Kind::DATA:
+                fileC << dataPrinter.printDataAt(
+                    this->dataScsConstsAndRegs.at((uint64_t)op.id),
+                    *op.type, op.location,
+                    getNameSourceData((uint64_t)op.id));
+                break;
+            }
+            fileC << std::endl;
+        }
+        fileC << "\t\t"
+              << formatTemplate(*value.instruction, printValue(values, idx))
+              << "\n"
+              << "\t}" << std::endl;
+    }
+
+    for (uint64_t i = 0; i < programs.size(); i++) {
+        fileC << "\tbids[" << programs.at(i).second
+              << "] = " << printValue(values, results.at(i)) << ";"
+              << std::endl;
+    }
+    fileC << "}" << std::endl;
+}
+
+uint64_t CodeGen::ProgramGenerationEngine::analyzeProgram(
+    const Program::Program& p, std::vector<OptimizedValue>& values,
+    std::unordered_map<std::string, uint64_t>& index)
+{
+    this->setProgram(p);
+
+    // Get the index of a value, creating it if needed.
+    auto getValue = [&values, &index](const std::string& key,
+                                      OptimizedValue&& value) {
+        auto [itr, inserted] = index.emplace(key, values.size());
+        if (inserted) {
+            values.push_back(std::move(value));
+        }
+        return itr->second;
+    };
+    auto getLiteral = [&getValue](double literal) {
+        std::ostringstream key;
+        key << "L" << std::hexfloat << literal;
+        return getValue(key.str(), {true, literal, nullptr, {}});
+    };
+
+    // Registers are initialized to 0.
+    const size_t nbRegisters = p.getEnvironment().getNbRegisters();
+    std::vector<uint64_t> registerValues(nbRegisters, getLiteral(0.0));
+
+    const bool hasConstants = p.getEnvironment().getNbConstant() > 0;
+    const Data::DataHandler& constants =
+        this->dataScsConstsAndRegs.at(hasConstants ? 1 : 0);
+    for (this->programCounter = 0; this->programCounter < p.getNbLines();
+         this->programCounter++) {
+        if (p.isIntron(this->programCounter)) {
+            continue;
+        }
+        const Program::Line& line = this->getCurrentLine();
+        const Instructions::Instruction& instruction =
+            this->getCurrentInstruction();
+        if (!instruction.isPrintable()) {
+            throw std::runtime_error("The instruction is not printable, stop "
+                                     "the generation of the program.");
+        }
+
+        // Identify the operands of the line
+        OptimizedValue value{false, 0.0, &instruction, {}};
+        std::ostringstream key;
+        key << &instruction;
+        bool isFoldable = true;
+        for (uint64_t i = 0; i < instruction.getNbOperands(); i++) {
+            const uint64_t sourceIdx = line.getOperand(i).first;
+            const uint64_t location = this->getOperandLocation(i);
+            const std::type_info& operandType =
+                instruction.getOperandTypes().at(i).get();
+            OptimizedOperand op{OptimizedOperand::Kind::DATA,
+                                (int64_t)sourceIdx, location, &operandType};
+            if (sourceIdx == 0) {
+                op.kind = OptimizedOperand::Kind::VALUE;
+                op.id = (int64_t)registerValues.at(location);
+                isFoldable &= values.at(op.id).isLiteral;
+                key << " V" << op.id;
+            }
+            else if (hasConstants && sourceIdx == 1) {
+                op.kind = OptimizedOperand::Kind::CONSTANT;
+                op.id = p.getConstantAt(location).value;
+                key << " C" << op.id;
+            }
+            else {
+                isFoldable = false;
+                key << " D" << sourceIdx << "@" << location << ":"
+                    << operandType.name();
+            }
+            value.operands.push_back(op);
+        }
+
+        uint64_t result;
+        double literal = NAN;
+        if (isFoldable) {
+            // Execute the line with its operands known at generation time.
+            Data::PrimitiveTypeArray<double> scratch(
+                instruction.getNbOperands());
+            std::vector<Data::UntypedSharedPtr> args;
+            for (uint64_t i = 0; i < value.operands.size(); i++) {
+                const OptimizedOperand& op = value.operands.at(i);
+                if (op.kind == OptimizedOperand::Kind::VALUE) {
+                    scratch.setDataAt(typeid(double), i,
+                                      values.at(op.id).literal);
+                    args.push_back(scratch.getDataAt(typeid(double), i));
+                }
+                else {
+                    args.push_back(constants.getDataAt(*op.type, op.location));
+                }
+            }
+            literal = instruction.execute(args);
+        }
+
+        // Non-finite results are left to the generated code.
+        if (isFoldable && std::isfinite(literal)) {
+            result = getLiteral(literal);
+        }
+        else {
+            result = getValue(key.str(), std::move(value));
+        }
+        registerValues.at(line.getDestinationIndex()) = result;
+    }
+
+    return registerValues.at(0);
+}
+
+std::string CodeGen::ProgramGenerationEngine::printValue(
+    const std::vector<OptimizedValue>& values, uint64_t idx)
+{
+    std::ostringstream name;
+    const OptimizedValue& value = values.at(idx);
+    if (value.isLiteral) {
+        name << std::hexfloat << value.literal;
+    }
+    else {
+        name << "v" << idx;
+    }
+    return name.str();
+}
+
+std::string CodeGen::ProgramGenerationEngine::formatTemplate(
+    const Instructions::Instruction& instruction,
+    const std::string& destination) const
 {
     const std::string& printTemplate = instruction.getPrintTemplate();
-    const Program::Line& line =
-        this->getCurrentLine(); // throw std::out_of_range
     std::string codeLine(printTemplate);
     std::string operandValue;
     for (auto itr = std::sregex_iterator(printTemplate.begin(),
@@ -118,20 +444,28 @@ std::string CodeGen::ProgramGenerationEngine::completeFormat(
         // get number after character '$'
         int idx = std::stoi(match.substr(1));
         if (idx > 0) {
-            const uint64_t operandLocation = this->getOperandLocation(idx - 1);
-            std::string operandIdx(std::to_string(idx - 1));
-            operandValue = nameOperandVariable + operandIdx;
+            operandValue = nameOperandVariable + std::to_string(idx - 1);
         }
         else {
             // if number == 0 it corresponds to the result of the function
-            operandValue = nameRegVariable + "[" +
-                           std::to_string(line.getDestinationIndex()) + "]";
+            operandValue = destination;
         }
         codeLine.replace(pos, match.size(), operandValue);
     }
     return codeLine;
 }
 
+std::string CodeGen::ProgramGenerationEngine::completeFormat(
+    const Instructions::Instruction& instruction) const
+{
+    const Program::Line& line =
+        this->getCurrentLine(); // throw std::out_of_range
+    return formatTemplate(instruction,
+                          nameRegVariable + "[" +
+                              std::to_string(line.getDestinationIndex()) +
+                              "]");
+}
+
 void CodeGen::ProgramGenerationEngine::initGlobalVar(size_t nbConstant)
 {
     int i;
@@ -143,12 +477,41 @@ void CodeGen::ProgramGenerationEngine::initGlobalVar(size_t nbConstant)
         i = 1;
     }
 
+    if (this->batch) {
+        fileH << "typedef struct " << nameBatchInputType << " {" << std::endl;
+        for (int j = i, cpt = 1; j < this->dataScsConstsAndRegs.size();
+             ++j, ++cpt) {
+            const Data::DataHandler& d = this->dataScsConstsAndRegs.at(j);
+            fileH << "\t" << dataPrinter.getDemangleTemplateType(d) << " "
+                  << nameDataVariable << cpt << "["
+                  << d.getAddressSpace(d.getNativeType()) << "];"
+                  << std::endl;
+        }
+        fileH << "} " << nameBatchInputType << ";\n" << std::endl;
+    }
+
+    if (this->reentrant) {
+        fileH << "typedef struct " << nameContextType << " {" << std::endl;
+    }
+
     for (int cpt = 1; i < this->dataScsConstsAndRegs.size(); ++i, ++cpt) {
 
         const Data::DataHandler& d = this->dataScsConstsAndRegs.at(i);
         std::string type = dataPrinter.getDemangleTemplateType(d);
 
-        fileC << "extern " << type << "* in" << cpt << ";" << std::endl;
+        if (this->reentrant) {
+            fileH << "\tconst " << type << "* " << nameDataVariable << cpt
+                  << ";" << std::endl;
+        }
+        else {
+            fileC << "extern " << type << "* in" << cpt << ";" << std::endl;
+        }
+    }
+
+    if (this->reentrant) {
+        fileH << "\tdouble " << nameRegVariable << "["
+              << this->registers.getLargestAddressSpace() << "];" << std::endl;
+        fileH << "} " << nameContextType << ";\n" << std::endl;
     }
 }
 
@@ -231,6 +594,12 @@ std::string CodeGen::ProgramGenerationEngine::getNameSourceData(
             varNumber--;
         }
         nameDataSource = nameDataVariable + std::to_string(varNumber);
+        if (this->batchGeneration) {
+            nameDataSource = nameBatchInputVariable + "->" + nameDataSource;
+        }
+        else if (this->reentrant) {
+            nameDataSource = nameContextVariable + "->" + nameDataSource;
+        }
     }
     return nameDataSource;
 }
@@ -43,10 +43,11 @@
 
 CodeGen::TPGGenerationEngine::TPGGenerationEngine(const std::string& filename,
                                                   const TPG::TPGGraph& tpg,
-                                                  const std::string& path)
-    : TPGAbstractEngine(tpg), progGenerationEngine{filename + "_" +
-                                                       filenameProg,
-                                                   tpg.getEnvironment(), path}
+                                                  const std::string& path,
+                                                  bool reentrant, bool batch)
+    : TPGAbstractEngine(tpg),
+      progGenerationEngine{filename + "_" + filenameProg, tpg.getEnvironment(),
+                           path, reentrant, batch}
 {
     this->fileMain.open(path + filename + ".c", std::ofstream::out);
     this->fileMainH.open(path + filename + ".h", std::ofstream::out);
@@ -75,6 +76,12 @@ CodeGen::TPGGenerationEngine::TPGGenerationEngine(const std::string& filename,
               << " */\n\n";
     fileMainH << "#ifndef C_" << filename << "_H" << std::endl;
     fileMainH << "#define C_" << filename << "_H\n" << std::endl;
+    if (reentrant || batch) {
+        // Declaration of the TPGContext and in_t structs.
+        fileMainH << "#include \"" << filename << "_" << filenameProg
+                  << ".h\"\n"
+                  << std::endl;
+    }
 };
 
 CodeGen::TPGGenerationEngine::~TPGGenerationEngine()
@@ -61,6 +61,18 @@ std::unique_ptr<CodeGen::TPGGenerationEngine> CodeGen::
     else if (this->mode == switchMode) {
         return std::make_unique<TPGSwitchGenerationEngine>(filename, tpg, path);
     }
+    else if (this->mode == reentrantSwitchMode) {
+        return std::make_unique<TPGSwitchGenerationEngine>(filename, tpg, path,
+                                                           true);
+    }
+    else if (this->mode == batchSwitchMode) {
+        return std::make_unique<TPGSwitchGenerationEngine>(filename, tpg, path,
+                                                           false, true);
+    }
+    else if (this->mode == optimizedSwitchMode) {
+        return std::make_unique<TPGSwitchGenerationEngine>(filename, tpg, path,
+                                                           false, false, true);
+    }
     else {
         return nullptr;
     }
@@ -0,0 +1,355 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifdef CODE_GENERATION
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+#include "codeGen/programGenerationEngine.h"
+#include "codeGen/tpgNativeExecutionEngine.h"
+#include "data/dataHandlerPrinter.h"
+#include "data/demangle.h"
+#include "tpg/tpgAction.h"
+#include "tpg/tpgEdge.h"
+#include "tpg/tpgTeam.h"
+#include "util/timestamp.h"
+
+CodeGen::TPGNativeExecutionEngine::TPGNativeExecutionEngine(
+    const Environment& env, const TPG::TPGGraph& graph, Archive* arch,
+    const std::string& compiler)
+    : TPGExecutionEngine(env, arch), tpg{graph},
+      dataSources(env.getDataSources()), compiler{compiler}
+{
+    if (this->compiler.empty()) {
+        const char* cc = std::getenv("CC");
+        this->compiler = (cc != nullptr) ? cc : "cc";
+    }
+}
+
+CodeGen::TPGNativeExecutionEngine::~TPGNativeExecutionEngine()
+{
+    this->unload();
+    if (!this->workingDirectory.empty()) {
+        std::error_code error;
+        std::filesystem::remove_all(this->workingDirectory, error);
+    }
+}
+
+void CodeGen::TPGNativeExecutionEngine::unload()
+{
+#ifndef _WIN32
+    if (this->library != nullptr) {
+        dlclose(this->library);
+    }
+#endif
+    this->library = nullptr;
+    this->inferenceFunction = nullptr;
+    this->setInputFunction = nullptr;
+    this->compiledRoots.clear();
+}
+
+bool CodeGen::TPGNativeExecutionEngine::areDataSourcesContiguous() const
+{
+    for (const Data::DataHandler& dataSource : this->dataSources) {
+        // A copy of the data would not be at the expected addresses.
+        if (dataSource.getContiguousData(dataSource.getNativeType()) ==
+            nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CodeGen::TPGNativeExecutionEngine::updateDataSources()
+{
+    for (size_t idx = 0; idx < this->dataSources.size(); idx++) {
+        const Data::DataHandler& dataSource = this->dataSources.at(idx).get();
+        this->setInputFunction(
+            (int)idx + 1,
+            dataSource.getContiguousData(dataSource.getNativeType()));
+    }
+}
+
+void CodeGen::TPGNativeExecutionEngine::generateCode(
+    const std::vector<const TPG::TPGVertex*>& roots)
+{
+    // Index all vertices as in the TPGGraph
+    this->vertices = this->tpg.getVertices();
+    std::unordered_map<const TPG::TPGVertex*, int> vertexIdx;
+    for (size_t idx = 0; idx < this->vertices.size(); idx++) {
+        vertexIdx.emplace(this->vertices.at(idx), (int)idx);
+    }
+
+    // Find the teams reachable from the roots
+    std::set<int> reachableTeams;
+    std::vector<const TPG::TPGVertex*> toVisit(roots);
+    while (!toVisit.empty()) {
+        const TPG::TPGVertex* vertex = toVisit.back();
+        toVisit.pop_back();
+        if (dynamic_cast<const TPG::TPGTeam*>(vertex) != nullptr &&
+            reachableTeams.insert(vertexIdx.at(vertex)).second) {
+            for (const TPG::TPGEdge* edge : vertex->getOutgoingEdges()) {
+                toVisit.push_back(edge->getDestination());
+            }
+        }
+    }
+
+    // Generate the Program of all edges of reachable teams
+    const std::string path = this->workingDirectory + "/";
+    std::unordered_map<const Program::Program*, uint64_t> programIDs;
+    {
+        ProgramGenerationEngine progGenerationEngine(
+            "gegelati_programs", this->tpg.getEnvironment(), path);
+        for (int teamIdx : reachableTeams) {
+            for (const TPG::TPGEdge* edge :
+                 this->vertices.at(teamIdx)->getOutgoingEdges()) {
+                const Program::Program& program = edge->getProgram();
+                if (programIDs.emplace(&program, programIDs.size()).second) {
+                    progGenerationEngine.setProgram(program);
+                    progGenerationEngine.generateProgram(
+                        programIDs.at(&program));
+                }
+            }
+        }
+    }
+
+    std::ofstream externHeader(path + "externHeader.h", std::ofstream::out);
+    externHeader << "#include <float.h>\n"
+                 << "#include <math.h>\n"
+                 << "#include <stdint.h>\n";
+    externHeader.close();
+
+    std::ofstream fileC(path + "gegelati_tpg.c", std::ofstream::out);
+    if (!fileC.is_open()) {
+        throw std::runtime_error("Error can't open " + path + "gegelati_tpg.c");
+    }
+    fileC << "/**\n"
+          << " * File generated with GEGELATI v" GEGELATI_VERSION "\n"
+          << " * On the " << Util::getCurrentDate() << "\n"
+          << " * With the " << DEMANGLE_TYPEID_NAME(typeid(*this).name())
+          << ".\n"
+          << " */\n\n"
+          << "#include <math.h>\n"
+          << "#include \"gegelati_programs.h\"\n\n";
+
+    // Data sources, set before each inference
+    Data::DataHandlerPrinter dataPrinter;
+    for (size_t idx = 0; idx < this->dataSources.size(); idx++) {
+        fileC << dataPrinter.getDemangleTemplateType(this->dataSources.at(idx))
+              << "* in" << idx + 1 << ";\n";
+    }
+    fileC << "\nvoid setInput(int idx, const void* data) {\n"
+          << "\tswitch (idx) {\n";
+    for (size_t idx = 0; idx < this->dataSources.size(); idx++) {
+        fileC << "\tcase " << idx + 1 << ": in" << idx + 1 << " = ("
+              << dataPrinter.getDemangleTemplateType(this->dataSources.at(idx))
+              << "*)data; break;\n";
+    }
+    fileC << "\t}\n"
+          << "}\n\n";
+
+    // Same selection as TPGExecutionEngine: NaN bids are -infinity and the
+    // last of the best bids is selected.
+    fileC << "static int bestProgram(const double* results, int nb) {\n"
+          << "\tint bestProgram = 0;\n"
+          << "\tdouble bestScore = (isnan(results[0])) ? -INFINITY : "
+             "results[0];\n"
+          << "\tfor (int i = 1; i < nb; i++) {\n"
+          << "\t\tdouble challengerScore = (isnan(results[i])) ? -INFINITY : "
+             "results[i];\n"
+          << "\t\tif (challengerScore >= bestScore) {\n"
+          << "\t\t\tbestProgram = i;\n"
+          << "\t\t\tbestScore = challengerScore;\n"
+          << "\t\t}\n"
+          << "\t}\n"
+          << "\treturn bestProgram;\n"
+          << "}\n\n";
+
+    // Inference function, writing the index of visited vertices in trace.
+    // An acyclic path never visits more vertices than the TPGGraph holds, and
+    // the trace buffer holds one entry per vertex. Returns -1 on overflow.
+    fileC << "int inference(int vertex, int* trace) {\n"
+          << "\tint nbVisited = 0;\n"
+          << "\twhile (nbVisited < " << this->vertices.size() << ") {\n"
+          << "\t\ttrace[nbVisited++] = vertex;\n"
+          << "\t\tswitch (vertex) {\n";
+    for (int teamIdx : reachableTeams) {
+        const auto& edges = this->vertices.at(teamIdx)->getOutgoingEdges();
+        fileC << "\t\tcase " << teamIdx << ": {\n"
+              << "\t\t\tstatic const int next[" << edges.size() << "] = {";
+        for (const TPG::TPGEdge* edge : edges) {
+            fileC << vertexIdx.at(edge->getDestination()) << ", ";
+        }
+        fileC << "};\n"
+              << "\t\t\tdouble bids[" << edges.size() << "];\n";
+        size_t edgeIdx = 0;
+        for (const TPG::TPGEdge* edge : edges) {
+            fileC << "\t\t\tbids[" << edgeIdx++ << "] = P"
+                  << programIDs.at(&edge->getProgram()) << "();\n";
+        }
+        fileC << "\t\t\tvertex = next[bestProgram(bids, " << edges.size()
+              << ")];\n"
+              << "\t\t\tbreak;\n"
+              << "\t\t}\n";
+    }
+    fileC << "\t\tdefault:\n"
+          << "\t\t\treturn nbVisited;\n"
+          << "\t\t}\n"
+          << "\t}\n"
+          << "\treturn -1;\n"
+          << "}\n";
+    fileC.close();
+
+    this->compiledRoots.clear();
+    for (const TPG::TPGVertex* root : roots) {
+        this->compiledRoots.emplace(root, vertexIdx.at(root));
+    }
+}
+
+bool CodeGen::TPGNativeExecutionEngine::compile(
+    const std::vector<const TPG::TPGVertex*>& roots)
+{
+    this->unload();
+#ifdef _WIN32
+    return false;
+#else
+    if (roots.empty() || !this->areDataSourcesContiguous()) {
+        return false;
+    }
+
+    // Create the working directory
+    if (this->workingDirectory.empty()) {
+        std::string dirTemplate =
+            (std::filesystem::temp_directory_path() / "gegelati_native_XXXXXX")
+                .string();
+        if (mkdtemp(dirTemplate.data()) == nullptr) {
+            return false;
+        }
+        this->workingDirectory = dirTemplate;
+    }
+
+    try {
+        this->generateCode(roots);
+    }
+    catch (const std::exception&) {
+        // e.g. non printable Instruction
+        this->compiledRoots.clear();
+        return false;
+    }
+
+    // Compile the code in a shared library with a new name, since the
+    // previous library may not be unloaded yet by the system.
+    const std::string path = this->workingDirectory + "/";
+    const std::string libraryPath = path + "libgegelati_tpg_" +
+                                    std::to_string(this->nbCompilations++) +
+                                    ".so";
+    // The compiler command may hold several words, as in "ccache gcc".
+    std::istringstream compilerWords(this->compiler);
+    std::string command;
+    std::string word;
+    while (compilerWords >> word) {
+        command += "\"" + word + "\" ";
+    }
+    command += "-O2 -ffp-contract=off -shared -fPIC -o \"" + libraryPath +
+               "\" \"" + path + "gegelati_tpg.c\" \"" + path +
+               "gegelati_programs.c\" -lm > \"" + path + "compile.log\" 2>&1";
+    if (std::system(command.c_str()) != 0) {
+        this->compiledRoots.clear();
+        return false;
+    }
+
+    // Load the library
+    this->library = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (this->library != nullptr) {
+        this->inferenceFunction =
+            (InferenceFunction)dlsym(this->library, "inference");
+        this->setInputFunction =
+            (SetInputFunction)dlsym(this->library, "setInput");
+    }
+    if (this->inferenceFunction == nullptr ||
+        this->setInputFunction == nullptr) {
+        this->unload();
+        return false;
+    }
+
+    this->trace.resize(this->vertices.size());
+    return true;
+#endif
+}
+
+bool CodeGen::TPGNativeExecutionEngine::compile()
+{
+    return this->compile(this->tpg.getRootVertices());
+}
+
+bool CodeGen::TPGNativeExecutionEngine::isNative(
+    const TPG::TPGVertex& root) const
+{
+    return this->archive == NULL && this->inferenceFunction != nullptr &&
+           this->compiledRoots.count(&root) > 0;
+}
+
+const std::vector<const TPG::TPGVertex*> CodeGen::TPGNativeExecutionEngine::
+    executeFromRoot(const TPG::TPGVertex& root)
+{
+    if (!this->isNative(root)) {
+        return TPGExecutionEngine::executeFromRoot(root);
+    }
+
+    this->updateDataSources();
+    const int nbVisited =
+        this->inferenceFunction(this->compiledRoots.at(&root), trace.data());
+    if (nbVisited < 0) {
+        throw std::runtime_error(
+            "Native inference visited more vertices than the TPGGraph holds: "
+            "the TPGGraph contains a cycle.");
+    }
+
+    std::vector<const TPG::TPGVertex*> visitedVertices;
+    visitedVertices.reserve(nbVisited);
+    for (int idx = 0; idx < nbVisited; idx++) {
+        visitedVertices.push_back(this->vertices.at(this->trace.at(idx)));
+    }
+    return visitedVertices;
+}
+
+#endif // CODE_GENERATION
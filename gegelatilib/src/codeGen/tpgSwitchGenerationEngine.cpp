@@ -37,8 +37,16 @@
 
 #ifdef CODE_GENERATION
 
+#include <algorithm>
+#include <set>
+
 #include "codeGen/tpgSwitchGenerationEngine.h"
 
+bool CodeGen::TPGSwitchGenerationEngine::isOptimized() const
+{
+    return this->optimized;
+}
+
 void CodeGen::TPGSwitchGenerationEngine::generateEdge(const TPG::TPGEdge& edge)
 {
     const Program::Program& p = edge.getProgram();
@@ -48,8 +56,12 @@ void CodeGen::TPGSwitchGenerationEngine::generateEdge(const TPG::TPGEdge& edge)
 
     if (findProgramID(p, progID)) {
         progGenerationEngine.generateProgram(progID);
+        if (progGenerationEngine.isBatch()) {
+            progGenerationEngine.generateBatchProgram(progID);
+        }
     }
-    fileMain << "P" << progID << "()";
+    fileMain << "P" << progID << "("
+             << (progGenerationEngine.isReentrant() ? "ctx" : "") << ")";
 }
 
 void CodeGen::TPGSwitchGenerationEngine::generateTeam(const TPG::TPGTeam& team)
@@ -75,11 +87,49 @@ void CodeGen::TPGSwitchGenerationEngine::generateTeam(const TPG::TPGTeam& team)
     fileMain << std::endl;
 
     int i = 0;
-    for (const auto* edge : edges) {
-        fileMain << "\t\t\t" << teamName << "Scores[" << i << "] = ";
-        ++i;
-        generateEdge(*edge);
-        fileMain << ";" << std::endl;
+    if (this->optimized) {
+        // Programs that can be value-numbered are generated together.
+        std::vector<std::pair<const Program::Program*, uint64_t>> programs;
+        std::vector<const TPG::TPGEdge*> otherEdges;
+        std::vector<int> otherIndexes;
+        for (const auto* edge : edges) {
+            const Program::Program& p = edge->getProgram();
+            uint64_t progID;
+            if (progGenerationEngine.isOptimizable(p)) {
+                programs.push_back({&p, i});
+                if (findProgramID(p, progID) &&
+                    progGenerationEngine.isBatch()) {
+                    progGenerationEngine.setProgram(p);
+                    progGenerationEngine.generateBatchProgram(progID);
+                }
+            }
+            else {
+                otherEdges.push_back(edge);
+                otherIndexes.push_back(i);
+            }
+            ++i;
+        }
+        if (!programs.empty()) {
+            progGenerationEngine.generateTeamBids(findVertexID(team),
+                                                  programs);
+            fileMain << "\t\t\t" << teamName << "Bids("
+                     << (progGenerationEngine.isReentrant() ? "ctx, " : "")
+                     << teamName << "Scores);" << std::endl;
+        }
+        for (size_t j = 0; j < otherEdges.size(); j++) {
+            fileMain << "\t\t\t" << teamName << "Scores["
+                     << otherIndexes.at(j) << "] = ";
+            generateEdge(*otherEdges.at(j));
+            fileMain << ";" << std::endl;
+        }
+    }
+    else {
+        for (const auto* edge : edges) {
+            fileMain << "\t\t\t" << teamName << "Scores[" << i << "] = ";
+            ++i;
+            generateEdge(*edge);
+            fileMain << ";" << std::endl;
+        }
     }
     fileMain << std::endl;
 
@@ -101,7 +151,7 @@ void CodeGen::TPGSwitchGenerationEngine::generateTPGGraph()
     initHeaderFile();
 
     std::map<const TPG::TPGTeam*, std::list<TPG::TPGEdge*>> graph;
-    auto vertices = this->tpg.getVertices();
+    auto vertices = getGeneratedVertices();
 
     // generate enum of teams and actions for readability
     fileMain << "enum vertices {";
@@ -111,7 +161,9 @@ void CodeGen::TPGSwitchGenerationEngine::generateTPGGraph()
     fileMain << "};" << std::endl << std::endl;
 
     // generate inference function
-    fileMain << "int inferenceTPG() {" << std::endl;
+    fileMain << "int inferenceTPG("
+             << (progGenerationEngine.isReentrant() ? "TPGContext* ctx" : "")
+             << ") {" << std::endl;
 
     // start graph on root
     fileMain << "\tenum vertices currentVertex = "
@@ -134,6 +186,127 @@ void CodeGen::TPGSwitchGenerationEngine::generateTPGGraph()
     fileMain << "\t\t}" << std::endl;
     fileMain << "\t}" << std::endl;
     fileMain << "}" << std::endl;
+
+    if (progGenerationEngine.isBatch()) {
+        generateBatchInference();
+    }
+}
+
+void CodeGen::TPGSwitchGenerationEngine::generateBatchInference()
+{
+    // Teams reachable from the root, in topological order (reversed
+    // post-order of a depth-first search).
+    std::vector<const TPG::TPGTeam*> teams;
+    std::set<const TPG::TPGVertex*> visited;
+    std::vector<std::pair<const TPG::TPGVertex*, bool>> toVisit{
+        {tpg.getRootVertices().at(0), false}};
+    while (!toVisit.empty()) {
+        auto [vertex, expanded] = toVisit.back();
+        toVisit.pop_back();
+        if (expanded) {
+            teams.push_back((const TPG::TPGTeam*)vertex);
+            continue;
+        }
+        if (dynamic_cast<const TPG::TPGTeam*>(vertex) == nullptr ||
+            !visited.insert(vertex).second) {
+            continue;
+        }
+        toVisit.push_back({vertex, true});
+        for (const auto* edge : vertex->getOutgoingEdges()) {
+            toVisit.push_back({edge->getDestination(), false});
+        }
+    }
+    std::reverse(teams.begin(), teams.end());
+
+    // Action of each vertex, -1 for teams.
+    auto vertices = getGeneratedVertices();
+    fileMain << "\nstatic const int batchActions[" << vertices.size()
+             << "] = {";
+    for (auto vertex : vertices) {
+        const auto* action = dynamic_cast<const TPG::TPGAction*>(vertex);
+        fileMain << ((action != nullptr) ? (int64_t)action->getActionID() : -1)
+                 << ", ";
+    }
+    fileMain << "};\n" << std::endl;
+
+    fileMain
+        << "void inferenceTPGBatch(const in_t* inputs, int n, int* actions) {\n"
+        << "\tenum vertices current[TPG_BATCH_SIZE];\n"
+        << "\tint samples[TPG_BATCH_SIZE];\n"
+        << "\tint bestEdges[TPG_BATCH_SIZE];\n"
+        << "\tdouble bestBids[TPG_BATCH_SIZE];\n"
+        << "\tdouble bids[TPG_BATCH_SIZE];\n"
+        << "\tfor (int start = 0; start < n; start += TPG_BATCH_SIZE) {\n"
+        << "\t\tconst int size = (n - start < TPG_BATCH_SIZE) ? n - start : "
+           "TPG_BATCH_SIZE;\n"
+        << "\t\tconst in_t* block = inputs + start;\n"
+        << "\t\tfor (int s = 0; s < size; s++) {\n"
+        << "\t\t\tcurrent[s] = " << vertexName(*tpg.getRootVertices().at(0))
+        << ";\n"
+        << "\t\t}\n"
+        << std::endl;
+
+    for (const TPG::TPGTeam* team : teams) {
+        const auto edges = team->getOutgoingEdges();
+        const std::string teamName = vertexName(*team);
+
+        // Gather the samples of the block at the team
+        fileMain << "\t\t{\n"
+                 << "\t\t\tint nb = 0;\n"
+                 << "\t\t\tfor (int s = 0; s < size; s++) {\n"
+                 << "\t\t\t\tif (current[s] == " << teamName << ") {\n"
+                 << "\t\t\t\t\tsamples[nb++] = s;\n"
+                 << "\t\t\t\t}\n"
+                 << "\t\t\t}\n"
+                 << "\t\t\tif (nb > 0) {\n";
+
+        fileMain << "\t\t\t\tconst enum vertices next[" << edges.size()
+                 << "] = { ";
+        for (const auto* edge : edges) {
+            fileMain << vertexName(*edge->getDestination()) << ", ";
+        }
+        fileMain << " };" << std::endl;
+
+        // Evaluate the programs of the team, keeping the last best bid as
+        // in bestProgram().
+        int i = 0;
+        for (const auto* edge : edges) {
+            uint64_t progID;
+            findProgramID(edge->getProgram(), progID);
+            fileMain << "\t\t\t\tP" << progID << "Batch(block, samples, nb, "
+                     << ((i == 0) ? "bestBids" : "bids") << ");\n";
+            if (i == 0) {
+                fileMain << "\t\t\t\tfor (int s = 0; s < nb; s++) {\n"
+                         << "\t\t\t\t\tbestBids[s] = (isnan(bestBids[s])) ? "
+                            "-INFINITY : bestBids[s];\n"
+                         << "\t\t\t\t\tbestEdges[s] = 0;\n"
+                         << "\t\t\t\t}\n";
+            }
+            else {
+                fileMain << "\t\t\t\tfor (int s = 0; s < nb; s++) {\n"
+                         << "\t\t\t\t\tdouble bid = (isnan(bids[s])) ? "
+                            "-INFINITY : bids[s];\n"
+                         << "\t\t\t\t\tif (bid >= bestBids[s]) {\n"
+                         << "\t\t\t\t\t\tbestBids[s] = bid;\n"
+                         << "\t\t\t\t\t\tbestEdges[s] = " << i << ";\n"
+                         << "\t\t\t\t\t}\n"
+                         << "\t\t\t\t}\n";
+            }
+            i++;
+        }
+
+        fileMain << "\t\t\t\tfor (int s = 0; s < nb; s++) {\n"
+                 << "\t\t\t\t\tcurrent[samples[s]] = next[bestEdges[s]];\n"
+                 << "\t\t\t\t}\n"
+                 << "\t\t\t}\n"
+                 << "\t\t}\n";
+    }
+
+    fileMain << "\n\t\tfor (int s = 0; s < size; s++) {\n"
+             << "\t\t\tactions[start + s] = batchActions[current[s]];\n"
+             << "\t\t}\n"
+             << "\t}\n"
+             << "}" << std::endl;
 }
 
 void CodeGen::TPGSwitchGenerationEngine::initTpgFile()
@@ -167,7 +340,44 @@ void CodeGen::TPGSwitchGenerationEngine::initTpgFile()
 void CodeGen::TPGSwitchGenerationEngine::initHeaderFile()
 {
     fileMainH << "#include <stdlib.h>\n\n"
-              << "int inferenceTPG();\n";
+              << "int inferenceTPG("
+              << (progGenerationEngine.isReentrant() ? "TPGContext* ctx" : "")
+              << ");\n";
+    if (progGenerationEngine.isBatch()) {
+        fileMainH << "\n#ifndef TPG_BATCH_SIZE\n"
+                  << "#define TPG_BATCH_SIZE 64\n"
+                  << "#endif\n\n"
+                  << "void inferenceTPGBatch(const in_t* inputs, int n, int* "
+                     "actions);\n";
+    }
+}
+
+std::vector<const TPG::TPGVertex*> CodeGen::TPGSwitchGenerationEngine::
+    getGeneratedVertices() const
+{
+    auto vertices = this->tpg.getVertices();
+    if (!this->optimized) {
+        return vertices;
+    }
+
+    // Keep vertices reachable from the root
+    std::set<const TPG::TPGVertex*> reachable{tpg.getRootVertices().at(0)};
+    std::vector<const TPG::TPGVertex*> toVisit{tpg.getRootVertices().at(0)};
+    while (!toVisit.empty()) {
+        const TPG::TPGVertex* vertex = toVisit.back();
+        toVisit.pop_back();
+        for (const auto* edge : vertex->getOutgoingEdges()) {
+            if (reachable.insert(edge->getDestination()).second) {
+                toVisit.push_back(edge->getDestination());
+            }
+        }
+    }
+    vertices.erase(std::remove_if(vertices.begin(), vertices.end(),
+                                  [&reachable](const TPG::TPGVertex* v) {
+                                      return reachable.count(v) == 0;
+                                  }),
+                   vertices.end());
+    return vertices;
 }
 
 std::string CodeGen::TPGSwitchGenerationEngine::vertexName(
@@ -63,3 +63,27 @@ uint64_t Data::DataHandler::scaleLocation(const uint64_t rawLocation,
 {
     return rawLocation % this->getAddressSpace(type);
 }
+
+void Data::DataHandler::fetchDataAt(const std::type_info& type,
+                                    const size_t address,
+                                    OperandBuffer& operands) const
+{
+    operands.push(this->getDataAt(type, address), type);
+}
+
+uint64_t Data::DataHandler::getModificationVersion() const
+{
+    return 0;
+}
+
+const void* Data::DataHandler::getContiguousData(
+    const std::type_info& type) const
+{
+    return nullptr;
+}
+
+bool Data::DataHandler::isModifiedSince(const std::vector<size_t>& addresses,
+                                        uint64_t version) const
+{
+    return true;
+}
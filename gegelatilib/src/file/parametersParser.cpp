@@ -227,6 +227,10 @@ void File::ParametersParser::setParameterFromString(
         params.doValidation = value.asBool();
         return;
     }
+    if (param == "counterBasedRNG") {
+        params.counterBasedRNG = value.asBool();
+        return;
+    }
     // we didn't recognize the symbol
     std::cerr << "Ignoring unknown parameter " << param << std::endl;
 }
@@ -258,6 +262,10 @@ void File::ParametersParser::writeParametersToJson(
         Learn::LearningParameters::archivingProbabilityComment,
         Json::commentBefore);
 
+    root["counterBasedRNG"] = params.counterBasedRNG;
+    root["counterBasedRNG"].setComment(
+        Learn::LearningParameters::counterBasedRNGComment, Json::commentBefore);
+
     root["doValidation"] = params.doValidation;
     root["doValidation"].setComment(
         Learn::LearningParameters::doValidationComment, Json::commentBefore);
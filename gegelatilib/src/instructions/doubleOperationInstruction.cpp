@@ -0,0 +1,131 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <stdexcept>
+
+#include "instructions/doubleOperationInstruction.h"
+
+using namespace Instructions;
+
+#ifdef CODE_GENERATION
+DoubleOperationInstruction::DoubleOperationInstruction(
+    Program::DoubleOperation::Opcode opcode, const std::string& printTemplate)
+    : Instruction(printTemplate)
+{
+    setUpOperation(opcode, nullptr);
+}
+
+DoubleOperationInstruction::DoubleOperationInstruction(
+    double (*function)(double), const std::string& printTemplate)
+    : Instruction(printTemplate)
+{
+    setUpOperation(Program::DoubleOperation::Opcode::CALL, function);
+}
+#else
+DoubleOperationInstruction::DoubleOperationInstruction(
+    Program::DoubleOperation::Opcode opcode)
+{
+    setUpOperation(opcode, nullptr);
+}
+
+DoubleOperationInstruction::DoubleOperationInstruction(
+    double (*function)(double))
+{
+    setUpOperation(Program::DoubleOperation::Opcode::CALL, function);
+}
+#endif // CODE_GENERATION
+
+double DoubleOperationInstruction::execute(
+    const std::vector<Data::UntypedSharedPtr>& args) const
+{
+#ifndef NDEBUG
+    if (Instruction::execute(args) != 1.0) {
+        return 0.0;
+    }
+#endif
+
+    double arguments[2];
+    for (size_t i = 0; i < args.size(); i++) {
+        arguments[i] = *(args.at(i).getSharedPointer<const double>());
+    }
+    return this->operation.execute(arguments);
+}
+
+bool DoubleOperationInstruction::supportsOperandBuffer() const
+{
+    return true;
+}
+
+double DoubleOperationInstruction::execute(
+    const Data::OperandBuffer& args) const
+{
+#ifndef NDEBUG
+    if (Instruction::execute(args) != 1.0) {
+        return 0.0;
+    }
+#endif
+
+    double arguments[2];
+    for (size_t i = 0; i < args.size(); i++) {
+        arguments[i] = *(args.getPointer<double>(i));
+    }
+    return this->operation.execute(arguments);
+}
+
+bool DoubleOperationInstruction::getDoubleOperation(
+    Program::DoubleOperation& operation) const
+{
+    operation = this->operation;
+    return true;
+}
+
+void DoubleOperationInstruction::setUpOperation(
+    Program::DoubleOperation::Opcode opcode, double (*function)(double))
+{
+    using Opcode = Program::DoubleOperation::Opcode;
+    if (opcode == Opcode::CALL && function == nullptr) {
+        throw std::invalid_argument(
+            "A CALL operation requires a function to call.");
+    }
+
+    if (opcode == Opcode::SQRT || opcode == Opcode::CALL) {
+        this->operation = {opcode, function, {0, 0}, 1};
+    }
+    else {
+        this->operation = {opcode, nullptr, {0, 1}, 2};
+    }
+
+    for (uint64_t i = 0; i < this->operation.nbOperands; i++) {
+        this->operandTypes.push_back(typeid(double));
+    }
+}
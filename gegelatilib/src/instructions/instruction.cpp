@@ -93,6 +93,50 @@ double Instruction::execute(
 #endif
 }
 
+bool Instruction::checkOperandTypes(
+    const Data::OperandBuffer& arguments) const
+{
+    if (arguments.size() != this->operandTypes.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < arguments.size(); i++) {
+        if (*arguments[i].type != this->operandTypes[i].get()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Instruction::supportsOperandBuffer() const
+{
+    return false;
+}
+
+bool Instruction::supportsStridedOperands() const
+{
+    return false;
+}
+
+double Instruction::execute(const Data::OperandBuffer& arguments) const
+{
+#ifndef NDEBUG
+    if (!this->checkOperandTypes(arguments)) {
+        return 0.0;
+    }
+    else {
+        return 1.0;
+    }
+#else
+    return 1.0;
+#endif
+}
+
+bool Instruction::getDoubleOperation(Program::DoubleOperation& operation) const
+{
+    return false;
+}
+
 #ifdef CODE_GENERATION
 
 Instruction::Instruction(std::string printTemplate)
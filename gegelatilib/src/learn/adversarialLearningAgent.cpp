@@ -233,7 +233,7 @@ std::queue<std::shared_ptr<Learn::Job>> Learn::AdversarialLearningAgent::
         for (auto& team : championsTeams) {
             // puts the root at each possible location in the team
             for (int16_t i = 0; i < agentsPerEvaluation; i++) {
-                archiveSeed = this->rng.getUnsignedInt64(0, UINT64_MAX);
+                archiveSeed = this->getJobArchiveSeed(index);
                 auto job = std::make_shared<Learn::AdversarialJob>(
                     Learn::AdversarialJob({}, archiveSeed, index++, i));
 
@@ -38,11 +38,13 @@
 
 #include <inttypes.h>
 #include <queue>
+#include <unordered_set>
 
 #include "data/hash.h"
 #include "learn/evaluationResult.h"
 #include "mutator/rng.h"
 #include "mutator/tpgMutator.h"
+#include "tpg/policyFingerprint.h"
 #include "tpg/tpgExecutionEngine.h"
 
 #include "learn/learningAgent.h"
@@ -67,9 +69,17 @@ Mutator::RNG& Learn::LearningAgent::getRNG()
     return this->rng;
 }
 
+Util::ThreadPool* Learn::LearningAgent::getThreadPool()
+{
+    return nullptr;
+}
+
 void Learn::LearningAgent::init(uint64_t seed)
 {
     // Initialize Randomness
+    this->rng.setEngineType(this->params.counterBasedRNG
+                                ? Mutator::RNG::EngineType::PHILOX_4X32
+                                : Mutator::RNG::EngineType::MT19937_64);
     this->rng.setSeed(seed);
 
     // Initialize the tpg
@@ -91,6 +101,14 @@ void Learn::LearningAgent::addLogger(Log::LALogger& logger)
     loggers.push_back(std::reference_wrapper<Log::LALogger>(logger));
 }
 
+uint64_t Learn::LearningAgent::getEvaluationSeed(LearningMode mode) const
+{
+    size_t seed = Data::_Hash_representation((uint64_t)mode);
+    seed = Data::_Fnv1a_append_value(
+        seed, this->params.nbIterationsPerPolicyEvaluation);
+    return Data::_Fnv1a_append_value(seed, this->params.maxNbActionsPerEval);
+}
+
 bool Learn::LearningAgent::isRootEvalSkipped(
     const TPG::TPGVertex& root,
     std::shared_ptr<Learn::EvaluationResult>& previousResult) const
@@ -125,6 +143,30 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateJob(
         return previousEval;
     }
 
+    // In a deterministic LearningEnvironment, reuse the result of any
+    // previously evaluated policy with the same fingerprint.
+    bool useFingerprint = le.isDeterministic();
+    std::pair<uint64_t, uint64_t> fingerprintKey;
+    if (useFingerprint) {
+        TPG::PolicyFingerprint fingerprint;
+        fingerprintKey = {fingerprint.getFingerprint(*root),
+                          this->getEvaluationSeed(mode)};
+        useFingerprint = !fingerprint.hasCycle();
+    }
+    if (useFingerprint) {
+        std::lock_guard<std::mutex> lock(this->resultsPerFingerprintMutex);
+        const auto& iter = this->resultsPerFingerprint.find(fingerprintKey);
+        if (iter != this->resultsPerFingerprint.end()) {
+            this->fingerprintKeysPerRoot.emplace(root, fingerprintKey);
+            auto evaluationResult = std::make_shared<EvaluationResult>(
+                iter->second->getResult(), iter->second->getNbEvaluation());
+            if (previousEval != nullptr) {
+                *evaluationResult += *previousEval;
+            }
+            return evaluationResult;
+        }
+    }
+
     // Init results
     double result = 0.0;
 
@@ -162,6 +204,15 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateJob(
             result / (double)params.nbIterationsPerPolicyEvaluation,
             params.nbIterationsPerPolicyEvaluation));
 
+    // Store it for policies with the same fingerprint
+    if (useFingerprint) {
+        std::lock_guard<std::mutex> lock(this->resultsPerFingerprintMutex);
+        this->resultsPerFingerprint.emplace(
+            fingerprintKey,
+            std::make_shared<const EvaluationResult>(*evaluationResult));
+        this->fingerprintKeysPerRoot.emplace(root, fingerprintKey);
+    }
+
     // Combine it with previous one if any
     if (previousEval != nullptr) {
         *evaluationResult += *previousEval;
@@ -185,7 +236,7 @@ Learn::LearningAgent::evaluateAllRoots(uint64_t generationNumber,
 
     auto roots = tpg->getRootVertices();
     for (int i = 0; i < roots.size(); i++) {
-        auto job = makeJob(roots.at(i), mode);
+        auto job = makeJob(roots.at(i), mode, i);
         this->archive.setRandomSeed(job->getArchiveSeed());
         std::shared_ptr<EvaluationResult> avgScore = this->evaluateJob(
             *tee, *job, generationNumber, mode, this->learningEnvironment);
@@ -227,6 +278,8 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateOneRoot(
 
 void Learn::LearningAgent::trainOneGeneration(uint64_t generationNumber)
 {
+    this->currentGeneration = generationNumber;
+
     for (auto logger : loggers) {
         logger.get().logNewGeneration(generationNumber);
     }
@@ -234,7 +287,8 @@ void Learn::LearningAgent::trainOneGeneration(uint64_t generationNumber)
     // Populate Sequentially
     Mutator::TPGMutator::populateTPG(
         *this->tpg, this->archive, this->params.mutation, this->rng,
-        this->learningEnvironment.getNbActions(), maxNbThreads);
+        this->learningEnvironment.getNbActions(), maxNbThreads,
+        this->getThreadPool());
     for (auto logger : loggers) {
         logger.get().logAfterPopulateTPG();
     }
@@ -253,6 +307,8 @@ void Learn::LearningAgent::trainOneGeneration(uint64_t generationNumber)
     decimateWorstRoots(results);
     // Update the best
     this->updateEvaluationRecords(results);
+    // Forget results of policies of decimated roots
+    this->pruneResultsPerFingerprint();
 
     for (auto logger : loggers) {
         logger.get().logAfterDecimate();
@@ -435,6 +491,19 @@ void Learn::LearningAgent::keepBestPolicy()
     }
 }
 
+uint64_t Learn::LearningAgent::getJobArchiveSeed(uint64_t jobIdx)
+{
+    // Purpose identifying the streams of archive seeds.
+    static const uint64_t ARCHIVE_SEED_STREAM = 0;
+
+    if (this->rng.getEngineType() == Mutator::RNG::EngineType::PHILOX_4X32) {
+        return this->rng
+            .getStream(this->currentGeneration, jobIdx, ARCHIVE_SEED_STREAM)
+            .getUnsignedInt64(0, UINT64_MAX);
+    }
+    return this->rng.getUnsignedInt64(0, UINT64_MAX);
+}
+
 std::shared_ptr<Learn::Job> Learn::LearningAgent::makeJob(
     const TPG::TPGVertex* vertex, Learn::LearningMode mode, int idx,
     TPG::TPGGraph* tpgGraph)
@@ -446,7 +515,7 @@ std::shared_ptr<Learn::Job> Learn::LearningAgent::makeJob(
     // TRAINING Mode Else, archiving should be deactivate anyway
     uint64_t archiveSeed = 0;
     if (mode == LearningMode::TRAINING) {
-        archiveSeed = this->rng.getUnsignedInt64(0, UINT64_MAX);
+        archiveSeed = this->getJobArchiveSeed(idx);
     }
 
     if (tpgGraph->getNbRootVertices() > 0) {
@@ -474,6 +543,50 @@ std::queue<std::shared_ptr<Learn::Job>> Learn::LearningAgent::makeJobs(
 void Learn::LearningAgent::forgetPreviousResults()
 {
     resultsPerRoot.clear();
+    {
+        std::lock_guard<std::mutex> lock(this->resultsPerFingerprintMutex);
+        resultsPerFingerprint.clear();
+        fingerprintKeysPerRoot.clear();
+    }
     bestRoot.first = nullptr;
     bestRoot.second = nullptr;
 }
+
+void Learn::LearningAgent::pruneResultsPerFingerprint()
+{
+    std::lock_guard<std::mutex> lock(this->resultsPerFingerprintMutex);
+
+    // Keep the keys of surviving roots only
+    const std::vector<const TPG::TPGVertex*> roots =
+        this->tpg->getRootVertices();
+    const std::unordered_set<const TPG::TPGVertex*> rootSet(roots.begin(),
+                                                            roots.end());
+    std::set<std::pair<uint64_t, uint64_t>> keptKeys;
+    for (auto iter = this->fingerprintKeysPerRoot.begin();
+         iter != this->fingerprintKeysPerRoot.end();) {
+        if (rootSet.count(iter->first) != 0) {
+            keptKeys.insert(iter->second);
+            iter++;
+        }
+        else {
+            iter = this->fingerprintKeysPerRoot.erase(iter);
+        }
+    }
+
+    // Remove results no longer associated to a root
+    for (auto iter = this->resultsPerFingerprint.begin();
+         iter != this->resultsPerFingerprint.end();) {
+        if (keptKeys.count(iter->first) == 0) {
+            iter = this->resultsPerFingerprint.erase(iter);
+        }
+        else {
+            iter++;
+        }
+    }
+}
+
+size_t Learn::LearningAgent::getNbResultsPerFingerprint() const
+{
+    std::lock_guard<std::mutex> lock(this->resultsPerFingerprintMutex);
+    return this->resultsPerFingerprint.size();
+}
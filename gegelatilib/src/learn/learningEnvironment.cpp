@@ -47,6 +47,11 @@ bool Learn::LearningEnvironment::isCopyable() const
     return false;
 }
 
+bool Learn::LearningEnvironment::isDeterministic() const
+{
+    return false;
+}
+
 void Learn::LearningEnvironment::doAction(uint64_t actionID)
 {
     if (actionID >= this->nbActions) {
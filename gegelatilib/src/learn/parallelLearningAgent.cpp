@@ -37,9 +37,8 @@
 
 #include <algorithm>
 #include <iterator>
-#include <mutex>
-#include <queue>
-#include <thread>
+#include <memory>
+#include <vector>
 
 #include "mutator/rng.h"
 #include "mutator/tpgMutator.h"
@@ -67,7 +66,7 @@ Learn::ParallelLearningAgent::evaluateAllRoots(uint64_t generationNumber,
         // Execute for all root
         auto roots = this->tpg->getRootVertices();
         for (int i = 0; i < roots.size(); i++) {
-            auto job = makeJob(roots.at(i), mode);
+            auto job = makeJob(roots.at(i), mode, i);
 
             this->archive.setRandomSeed(job->getArchiveSeed());
 
@@ -84,82 +83,37 @@ Learn::ParallelLearningAgent::evaluateAllRoots(uint64_t generationNumber,
     return results;
 }
 
-void Learn::ParallelLearningAgent::slaveEvalJobThread(
-    uint64_t generationNumber, Learn::LearningMode mode,
-    std::queue<std::shared_ptr<Learn::Job>>& jobsToProcess,
-    std::mutex& rootsToProcessMutex,
-    std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-                                 std::shared_ptr<Job>>>& resultsPerRootMap,
-    std::mutex& resultsPerRootMapMutex,
-    std::map<uint64_t, Archive*>& archiveMap, std::mutex& archiveMapMutex,
-    bool useMainEnvironment)
+void Learn::ParallelLearningAgent::initEvaluationContext(
+    EvaluationContext& context, bool useMainEnvironment)
 {
-
     // Clone learningEnvironment
-    LearningEnvironment* privateLearningEnvironment =
-        useMainEnvironment ? &this->learningEnvironment
-                           : this->learningEnvironment.clone();
+    if (useMainEnvironment) {
+        context.learningEnvironment = &this->learningEnvironment;
+    }
+    else {
+        context.ownedLearningEnvironment.reset(
+            this->learningEnvironment.clone());
+        context.learningEnvironment = context.ownedLearningEnvironment.get();
+    }
 
     // Create a TPGExecutionEngine
-    Environment privateEnv(this->env.getInstructionSet(),
-                           privateLearningEnvironment->getDataSources(),
-                           this->env.getNbRegisters(),
-                           this->env.getNbConstant());
-    std::unique_ptr<TPG::TPGExecutionEngine> tee =
-        this->tpg->getFactory().createTPGExecutionEngine(privateEnv, NULL);
-
-    int i = 0;
-    // Pop a job
-    while (!jobsToProcess.empty()) { // Thread safe access to size
-        i++;
-        bool doProcess = false;
-        std::shared_ptr<Learn::Job> jobToProcess;
-        { // Mutuel exclusion zone
-            std::lock_guard<std::mutex> lock(rootsToProcessMutex);
-            if (!jobsToProcess.empty()) { // Additional verification after lock
-                jobToProcess = jobsToProcess.front();
-                jobsToProcess.pop();
-                doProcess = true;
-            }
-        } // End of mutual exclusion zone
-
-        // Processing to do?
-        if (doProcess) {
-            doProcess = false;
-            // Dedicated archive for the root
-            Archive* temporaryArchive = NULL;
-            if (mode == LearningMode::TRAINING) {
-                temporaryArchive =
-                    new Archive(params.archiveSize, params.archivingProbability,
-                                jobToProcess->getArchiveSeed());
-            }
-            tee->setArchive(temporaryArchive);
-
-            std::shared_ptr<EvaluationResult> avgScore =
-                this->evaluateJob(*tee, *jobToProcess, generationNumber, mode,
-                                  *privateLearningEnvironment);
-
-            { // Store result Mutual exclusion zone
-                std::lock_guard<std::mutex> lock(resultsPerRootMapMutex);
-                resultsPerRootMap.emplace(
-                    jobToProcess->getIdx(),
-                    std::make_pair(avgScore, jobToProcess));
-            }
-
-            if (mode == LearningMode::TRAINING) {
-                { // Insertion archiveMap update mutual exclusion zone
-                    std::lock_guard<std::mutex> lock(archiveMapMutex);
-                    archiveMap.insert(
-                        {jobToProcess->getIdx(), temporaryArchive});
-                }
-            }
-        }
-    }
+    context.environment = std::make_unique<Environment>(
+        this->env.getInstructionSet(),
+        context.learningEnvironment->getDataSources(),
+        this->env.getNbRegisters(), this->env.getNbConstant());
+    context.tee = this->tpg->getFactory().createTPGExecutionEngine(
+        *context.environment, NULL);
+}
 
-    // Clean up
-    if (!useMainEnvironment) {
-        delete privateLearningEnvironment;
+Util::ThreadPool* Learn::ParallelLearningAgent::getThreadPool()
+{
+    if (this->threadPool == nullptr ||
+        this->threadPool->getNbThreads() != this->maxNbThreads) {
+        this->threadPool =
+            std::make_unique<Util::ThreadPool>(this->maxNbThreads);
     }
+
+    return this->threadPool.get();
 }
 
 void Learn::ParallelLearningAgent::mergeArchiveMap(
@@ -236,36 +190,66 @@ void Learn::ParallelLearningAgent::evaluateAllRootsInParallelExecute(
                                  std::shared_ptr<Job>>>& resultsPerJobMap,
     std::map<uint64_t, Archive*>& archiveMap)
 {
-    // Create and fill the queue for distributing work among threads
+    // Create the list of jobs to distribute among threads
     // each root is associated to its number in the list for enabling the
     // determinism of stochastic archive storage.
-    auto jobsToProcess = makeJobs(mode);
-
-    // Create mutexes
-    std::mutex rootsToProcessMutex;
-    std::mutex resultsPerRootMutex;
-    std::mutex archiveMapMutex;
-
-    // Create the threads
-    std::vector<std::thread> threads;
-    for (auto i = 0; i < (this->maxNbThreads - 1); i++) {
-        threads.emplace_back(std::thread(
-            &ParallelLearningAgent::slaveEvalJobThread, this, generationNumber,
-            mode, std::ref(jobsToProcess), std::ref(rootsToProcessMutex),
-            std::ref(resultsPerJobMap), std::ref(resultsPerRootMutex),
-            std::ref(archiveMap), std::ref(archiveMapMutex), false));
+    auto jobsQueue = makeJobs(mode);
+    std::vector<std::shared_ptr<Learn::Job>> jobs;
+    jobs.reserve(jobsQueue.size());
+    while (!jobsQueue.empty()) {
+        jobs.push_back(jobsQueue.front());
+        jobsQueue.pop();
     }
 
-    // Work in the main thread also, using the main environment
-    this->slaveEvalJobThread(generationNumber, mode, jobsToProcess,
-                             rootsToProcessMutex, resultsPerJobMap,
-                             resultsPerRootMutex, archiveMap, archiveMapMutex,
-                             true);
+    // Result slots, one per job, written without lock.
+    std::vector<std::shared_ptr<EvaluationResult>> results(jobs.size());
+    std::vector<Archive*> archives(jobs.size(), NULL);
+
+    Util::ThreadPool& pool = *this->getThreadPool();
 
-    // Join the threads
-    for (auto& thread : threads) {
-        thread.join();
+    // One persistent EvaluationContext per thread, initialized by its thread
+    // on first use. The calling thread (index 0) uses the main environment.
+    if (this->evaluationContexts.size() != pool.getNbThreads()) {
+        this->resyncEvaluationContexts();
+        this->evaluationContexts.resize(pool.getNbThreads());
     }
+
+    pool.parallelFor(jobs.size(), [&](uint64_t jobIdx, uint64_t threadIdx) {
+        EvaluationContext& context = this->evaluationContexts.at(threadIdx);
+        if (context.tee == nullptr) {
+            this->initEvaluationContext(context, threadIdx == 0);
+        }
+
+        const std::shared_ptr<Learn::Job>& job = jobs.at(jobIdx);
+
+        // Dedicated archive for the root
+        Archive* temporaryArchive = NULL;
+        if (mode == LearningMode::TRAINING) {
+            temporaryArchive =
+                new Archive(params.archiveSize, params.archivingProbability,
+                            job->getArchiveSeed());
+        }
+        archives.at(jobIdx) = temporaryArchive;
+        context.tee->setArchive(temporaryArchive);
+
+        results.at(jobIdx) =
+            this->evaluateJob(*context.tee, *job, generationNumber, mode,
+                              *context.learningEnvironment);
+    });
+
+    // Fill the output maps, indexed by job number
+    for (size_t i = 0; i < jobs.size(); i++) {
+        resultsPerJobMap.emplace(jobs.at(i)->getIdx(),
+                                 std::make_pair(results.at(i), jobs.at(i)));
+        if (mode == LearningMode::TRAINING) {
+            archiveMap.insert({jobs.at(i)->getIdx(), archives.at(i)});
+        }
+    }
+}
+
+void Learn::ParallelLearningAgent::resyncEvaluationContexts()
+{
+    this->evaluationContexts.clear();
 }
 
 void Learn::ParallelLearningAgent::evaluateAllRootsInParallelCompileResults(
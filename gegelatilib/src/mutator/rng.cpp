@@ -34,27 +34,75 @@
  */
 
 #include "mutator/rng.h"
+#include "data/hash.h"
 #include "mutator/deterministicRandom.h"
 
 void Mutator::RNG::setSeed(uint64_t seed)
 {
-    engine->seed(seed);
+    this->seed = seed;
+    if (this->engine != nullptr) {
+        this->engine->seed(seed);
+    }
+    this->counterEngine.seed(seed);
+}
+
+void Mutator::RNG::setEngineType(EngineType type)
+{
+    this->engineType = type;
+    this->engine = (type == EngineType::MT19937_64)
+                       ? std::make_unique<std::mt19937_64>(this->seed)
+                       : nullptr;
+    this->counterEngine.seed(this->seed);
+}
+
+Mutator::RNG::EngineType Mutator::RNG::getEngineType() const
+{
+    return this->engineType;
+}
+
+Mutator::RNG Mutator::RNG::getStream(uint64_t generation, uint64_t index,
+                                     uint64_t purpose) const
+{
+    // Identify the stream with a hash of the tuple.
+    Data::WordHash<uint64_t> hasher;
+    uint64_t streamId = hasher(generation);
+    streamId = hasher(index, streamId);
+    streamId = hasher(purpose, streamId);
+
+    RNG result(this->seed, this->engineType);
+    if (this->engineType == EngineType::PHILOX_4X32) {
+        // Same key, independent counter space
+        result.counterEngine.seed(this->seed, streamId);
+    }
+    else {
+        result.setSeed(hasher(this->seed, streamId));
+    }
+    return result;
 }
 
 uint64_t Mutator::RNG::getUnsignedInt64(uint64_t min, uint64_t max)
 {
     Mutator::uniform_int_distribution<uint64_t> distribution(min, max);
-    return distribution(*engine);
+    if (this->engine != nullptr) {
+        return distribution(*engine);
+    }
+    return distribution(this->counterEngine);
 }
 
 int32_t Mutator::RNG::getInt32(int32_t min, int32_t max)
 {
     Mutator::uniform_int_distribution<int32_t> distribution(min, max);
-    return distribution(*engine);
+    if (this->engine != nullptr) {
+        return distribution(*engine);
+    }
+    return distribution(this->counterEngine);
 }
 
 double Mutator::RNG::getDouble(double min, double max)
 {
     Mutator::uniform_real_distribution<double> distribution(min, max);
-    return distribution(*engine);
+    if (this->engine != nullptr) {
+        return distribution(*engine);
+    }
+    return distribution(this->counterEngine);
 }
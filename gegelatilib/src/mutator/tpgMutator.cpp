@@ -36,11 +36,8 @@
  */
 
 #include <algorithm>
-#include <mutex>
 #include <numeric>
-#include <queue>
 #include <stdexcept>
-#include <thread>
 #include <vector>
 
 #include "archive.h"
@@ -85,7 +82,8 @@ void Mutator::TPGMutator::initRandomTPG(
         teams.push_back(&(graph.addNewTeam()));
     }
     for (size_t i = 0; i < 2 * params.tpg.initNbRoots; i++) {
-        programs.emplace_back(new Program::Program(graph.getEnvironment()));
+        programs.push_back(
+            graph.getFactory().createProgram(graph.getEnvironment()));
         // RandomInit the Programs
         Mutator::ProgramMutator::initRandomProgram(*programs.back(), params,
                                                    rng);
@@ -255,8 +253,8 @@ void Mutator::TPGMutator::mutateOutgoingEdge(
     const Mutator::MutationParameters& params, Mutator::RNG& rng)
 {
     // copy program
-    std::shared_ptr<Program::Program> newProg(
-        new Program::Program(edge->getProgram()));
+    std::shared_ptr<Program::Program> newProg =
+        graph.getFactory().createProgram(edge->getProgram());
 
     // Add it to the list of new Program to be mutated.
     newPrograms.push_back(newProg);
@@ -327,6 +325,104 @@ void Mutator::TPGMutator::mutateTPGTeam(
     }
 }
 
+Mutator::TPGMutator::TeamMutation Mutator::TPGMutator::prepareTeamMutation(
+    const TPG::TPGGraph& graph, const TPG::TPGTeam& clonedTeam,
+    const std::vector<const TPG::TPGTeam*>& preExistingTeams,
+    const std::vector<const TPG::TPGAction*>& preExistingActions,
+    const std::vector<TPG::TPGEdge*>& preExistingEdges,
+    const Mutator::MutationParameters& params, Mutator::RNG& rng)
+{
+    // Copy the outgoing edges of the cloned team
+    TeamMutation mutation;
+    for (TPG::TPGEdge* edge : clonedTeam.getOutgoingEdges()) {
+        mutation.edges.emplace_back(edge->getDestination(),
+                                    edge->getProgramSharedPointer());
+    }
+
+    // 1. Remove randomly selected edges
+    {
+        // Keep at least two edges (otherwise the team is useless)
+        double proba = 1.0;
+        while (mutation.edges.size() > 2 && proba > rng.getDouble(0.0, 1.0)) {
+            mutation.edges.erase(
+                mutation.edges.begin() +
+                rng.getUnsignedInt64(0, mutation.edges.size() - 1));
+
+            // Decrement the proba of removing another edge
+            proba *= params.tpg.pEdgeDeletion;
+        }
+    }
+
+    // 2. Add random duplicated edge
+    // (The new team is not in the graph yet, hence no pre-existing edge is
+    // connected to it.)
+    {
+        double proba = 1.0;
+        while (mutation.edges.size() < params.tpg.maxOutgoingEdges &&
+               proba > rng.getDouble(0.0, 1.0)) {
+            TPG::TPGEdge* pickedEdge = preExistingEdges.at(
+                rng.getUnsignedInt64(0, preExistingEdges.size() - 1));
+            mutation.edges.emplace_back(
+                pickedEdge->getDestination(),
+                pickedEdge->getProgramSharedPointer());
+
+            // Decrement the proba of adding another edge
+            proba *= params.tpg.pEdgeAddition;
+        }
+    }
+
+    // 3. Mutate edges of the team
+    mutation.isNewProgram.resize(mutation.edges.size(), false);
+    {
+        bool anyMutationDone = false;
+        do {
+            for (size_t idx = 0; idx < mutation.edges.size(); idx++) {
+                if (rng.getDouble(0.0, 1.0) < params.tpg.pProgramMutation) {
+                    auto& edge = mutation.edges.at(idx);
+                    // copy program
+                    edge.second =
+                        graph.getFactory().createProgram(*edge.second);
+                    mutation.isNewProgram.at(idx) = true;
+
+                    // Edge target modification
+                    if (rng.getDouble(0.0, 1.0) <
+                        params.tpg.pEdgeDestinationChange) {
+                        if (rng.getDouble(0, 1) <
+                            params.tpg.pEdgeDestinationIsAction) {
+                            edge.first = preExistingActions.at(
+                                rng.getUnsignedInt64(
+                                    0, preExistingActions.size() - 1));
+                        }
+                        else {
+                            edge.first = preExistingTeams.at(
+                                rng.getUnsignedInt64(
+                                    0, preExistingTeams.size() - 1));
+                        }
+                    }
+                    anyMutationDone = true;
+                }
+            }
+        } while (!anyMutationDone);
+    }
+
+    return mutation;
+}
+
+const TPG::TPGTeam& Mutator::TPGMutator::commitTeamMutation(
+    TPG::TPGGraph& graph, const TeamMutation& mutation,
+    std::list<std::shared_ptr<Program::Program>>& newPrograms)
+{
+    const TPG::TPGTeam& team = graph.addNewTeam();
+    for (size_t idx = 0; idx < mutation.edges.size(); idx++) {
+        const auto& edge = mutation.edges.at(idx);
+        graph.addNewEdge(team, *edge.first, edge.second);
+        if (mutation.isNewProgram.at(idx)) {
+            newPrograms.push_back(edge.second);
+        }
+    }
+    return team;
+}
+
 void Mutator::TPGMutator::mutateProgramBehaviorAgainstArchive(
     std::shared_ptr<Program::Program>& newProg,
     const Mutator::MutationParameters& params, const Archive& archive,
@@ -340,6 +436,17 @@ void Mutator::TPGMutator::mutateProgramBehaviorAgainstArchive(
         newProgCopy = std::make_shared<Program::Program>(*newProg);
     }
 
+    // Gather the archived data handlers once for all executions.
+    std::vector<size_t> archivedHashes;
+    std::vector<std::reference_wrapper<
+        const std::vector<std::reference_wrapper<const Data::DataHandler>>>>
+        archivedDataSources;
+    for (const auto& archiveDatahandler : archive.getDataHandlers()) {
+        archivedHashes.push_back(archiveDatahandler.first);
+        archivedDataSources.push_back(archiveDatahandler.second);
+    }
+    std::vector<double> results;
+
     bool allUnique;
     // Mutate behavior until it changes (against the archive).
     do {
@@ -358,17 +465,14 @@ void Mutator::TPGMutator::mutateProgramBehaviorAgainstArchive(
                 ;
         }
         // Check for uniqueness in archive
-        auto archivedDataHandlers = archive.getDataHandlers();
-        std::map<size_t, double> hashesAndResults;
+        // Execute the mutated program on the archive data handlers
         Program::ProgramExecutionEngine pee(*newProg);
-        for (std::pair<
-                 size_t,
-                 std::vector<std::reference_wrapper<const Data::DataHandler>>>
-                 archiveDatahandler : archivedDataHandlers) {
-            // Execute the mutated program on the archive data handlers
-            pee.setDataSources(archiveDatahandler.second);
-            double result = pee.executeProgram();
-            hashesAndResults.insert({archiveDatahandler.first, result});
+        Program::CompiledProgram compiled(*newProg);
+        pee.executeCompiledProgramBatch(compiled, archivedDataSources,
+                                        results);
+        std::map<size_t, double> hashesAndResults;
+        for (size_t idx = 0; idx < archivedHashes.size(); idx++) {
+            hashesAndResults.emplace(archivedHashes[idx], results[idx]);
         }
 
         // If the result is not unique, do another mutation.
@@ -380,70 +484,65 @@ void Mutator::TPGMutator::mutateNewProgramBehaviors(
     const uint64_t& maxNbThreads,
     std::list<std::shared_ptr<Program::Program>>& newPrograms,
     Mutator::RNG& rng, const Mutator::MutationParameters& params,
-    const Archive& archive)
+    const Archive& archive, Util::ThreadPool* threadPool)
 {
     // This is a computing intensive part of the mutation process
     // Hence the parallelization.
-    if (maxNbThreads <= 1) {
+    const uint64_t nbThreads =
+        (threadPool != nullptr) ? threadPool->getNbThreads() : maxNbThreads;
+
+    // With the counter-based engine, the RNG of each Program is an
+    // independent stream, identified by a single draw from the main RNG and
+    // by the index of the Program, instead of a seed drawn sequentially.
+    static const uint64_t PROGRAM_MUTATION_STREAM = 1;
+    const bool useStreams =
+        (rng.getEngineType() == Mutator::RNG::EngineType::PHILOX_4X32);
+    const uint64_t streamGeneration =
+        useStreams ? rng.getUnsignedInt64(0, UINT64_MAX) : 0;
+
+    if (nbThreads <= 1) {
         // Sequential (kept for determinism check mostly)
+        uint64_t progIdx = 0;
         for (std::shared_ptr<Program::Program> newProg : newPrograms) {
-            Mutator::RNG privateRNG(rng.getUnsignedInt64(0, UINT64_MAX));
+            Mutator::RNG privateRNG =
+                useStreams ? rng.getStream(streamGeneration, progIdx,
+                                           PROGRAM_MUTATION_STREAM)
+                           : Mutator::RNG(rng.getUnsignedInt64(0, UINT64_MAX));
             mutateProgramBehaviorAgainstArchive(newProg, params, archive,
                                                 privateRNG);
+            progIdx++;
         }
     }
     else {
         // Parallel
         // Create job list with Program pointers and seed
-        std::queue<std::pair<std::shared_ptr<Program::Program>, uint64_t>>
+        std::vector<std::pair<std::shared_ptr<Program::Program>, uint64_t>>
             programsToMutate;
         for (std::shared_ptr<Program::Program> newProg : newPrograms) {
-            programsToMutate.push(
-                {newProg, rng.getUnsignedInt64(0, UINT64_MAX)});
+            programsToMutate.push_back(
+                {newProg,
+                 useStreams ? 0 : rng.getUnsignedInt64(0, UINT64_MAX)});
         }
 
-        std::mutex mutexMutation;
-
-        // Function executed in threads
-        auto parallelWorker = [&programsToMutate, &mutexMutation, &params,
-                               &archive]() {
-            Mutator::RNG privateRNG;
-            // While there is work to be done
-            bool jobDone;
-            do {
-                std::pair<std::shared_ptr<Program::Program>, uint64_t> job;
-                jobDone = false;
-                { // get one job critical section
-                    std::lock_guard lock(mutexMutation);
-                    if (programsToMutate.size() != 0) {
-                        jobDone = true;
-                        job = programsToMutate.front();
-                        programsToMutate.pop();
-                    }
-                }
-
-                //  Do the job (if any)
-                if (jobDone) {
-                    privateRNG.setSeed(job.second);
-                    mutateProgramBehaviorAgainstArchive(job.first, params,
-                                                        archive, privateRNG);
-                }
-            } while (jobDone);
-        };
-
-        // Start threads
-        std::vector<std::thread> threads;
-        for (auto idx = 0; idx < maxNbThreads - 1; idx++) {
-            threads.emplace_back(std::thread(parallelWorker));
+        // Use a temporary pool if none is given.
+        std::unique_ptr<Util::ThreadPool> temporaryPool;
+        if (threadPool == nullptr) {
+            temporaryPool = std::make_unique<Util::ThreadPool>(maxNbThreads);
+            threadPool = temporaryPool.get();
         }
 
-        // Work in the main thread also
-        parallelWorker();
-
-        // Join the threads
-        for (auto& thread : threads) {
-            thread.join();
-        }
+        threadPool->parallelFor(
+            programsToMutate.size(),
+            [&programsToMutate, &params, &archive, &rng, useStreams,
+             streamGeneration](uint64_t jobIdx, uint64_t threadIdx) {
+                auto& job = programsToMutate[jobIdx];
+                Mutator::RNG privateRNG =
+                    useStreams ? rng.getStream(streamGeneration, jobIdx,
+                                               PROGRAM_MUTATION_STREAM)
+                               : Mutator::RNG(job.second);
+                mutateProgramBehaviorAgainstArchive(job.first, params, archive,
+                                                    privateRNG);
+            });
     }
 }
 
@@ -451,7 +550,8 @@ void Mutator::TPGMutator::populateTPG(TPG::TPGGraph& graph,
                                       const Archive& archive,
                                       const Mutator::MutationParameters& params,
                                       Mutator::RNG& rng, uint64_t nbActions,
-                                      uint64_t maxNbThreads)
+                                      uint64_t maxNbThreads,
+                                      Util::ThreadPool* threadPool)
 {
     // Get current vertex set (copy)
     auto vertices(graph.getVertices());
@@ -507,8 +607,63 @@ void Mutator::TPGMutator::populateTPG(TPG::TPGGraph& graph,
     // Create an empty list to store Programs to mutate.
     std::list<std::shared_ptr<Program::Program>> newPrograms;
 
-    // While the target is not reached, add new teams
     uint64_t currentNumberOfRoot = rootVertices.size();
+    std::unique_ptr<Util::ThreadPool> temporaryPool;
+
+    // With the counter-based engine, new teams are mutated in parallel, each
+    // with an independent stream of the rng, and committed in the graph in
+    // the order of their index.
+    if (rng.getEngineType() == Mutator::RNG::EngineType::PHILOX_4X32) {
+        static const uint64_t TEAM_MUTATION_STREAM = 2;
+        const uint64_t streamGeneration = rng.getUnsignedInt64(0, UINT64_MAX);
+        std::vector<TPG::TPGEdge*> pickableEdges;
+        for (const std::unique_ptr<TPG::TPGEdge>& edge : graph.getEdges()) {
+            pickableEdges.push_back(edge.get());
+        }
+        const uint64_t nbThreads =
+            (threadPool != nullptr) ? threadPool->getNbThreads() : maxNbThreads;
+
+        // Use a temporary pool if none is given (also used for the mutation
+        // of Program behaviors).
+        if (nbThreads > 1 && threadPool == nullptr) {
+            temporaryPool = std::make_unique<Util::ThreadPool>(maxNbThreads);
+            threadPool = temporaryPool.get();
+        }
+
+        uint64_t nbCreatedTeams = 0;
+        while (params.tpg.nbRoots > currentNumberOfRoot) {
+            // Since pre-existing roots may be subsumed by new ones, teams are
+            // created by batches until the target is reached.
+            std::vector<TeamMutation> mutations(params.tpg.nbRoots -
+                                                currentNumberOfRoot);
+            auto prepare = [&](uint64_t jobIdx, uint64_t) {
+                Mutator::RNG teamRNG =
+                    rng.getStream(streamGeneration, nbCreatedTeams + jobIdx,
+                                  TEAM_MUTATION_STREAM);
+                const TPG::TPGTeam* clonedRoot = rootTeams.at(
+                    teamRNG.getUnsignedInt64(0, rootTeams.size() - 1));
+                mutations[jobIdx] = prepareTeamMutation(
+                    graph, *clonedRoot, preExistingTeams, preExistingActions,
+                    pickableEdges, params, teamRNG);
+            };
+            if (nbThreads <= 1) {
+                for (uint64_t idx = 0; idx < mutations.size(); idx++) {
+                    prepare(idx, 0);
+                }
+            }
+            else {
+                threadPool->parallelFor(mutations.size(), prepare);
+            }
+
+            for (const TeamMutation& mutation : mutations) {
+                commitTeamMutation(graph, mutation, newPrograms);
+            }
+            nbCreatedTeams += mutations.size();
+            currentNumberOfRoot = graph.getNbRootVertices();
+        }
+    }
+
+    // While the target is not reached, add new teams
     while (params.tpg.nbRoots > currentNumberOfRoot) {
         // Select a random existing root
         uint64_t clonedRootIndex =
@@ -526,5 +681,6 @@ void Mutator::TPGMutator::populateTPG(TPG::TPGGraph& graph,
     }
 
     // Mutate the new Programs
-    mutateNewProgramBehaviors(maxNbThreads, newPrograms, rng, params, archive);
+    mutateNewProgramBehaviors(maxNbThreads, newPrograms, rng, params, archive,
+                              threadPool);
 }
@@ -0,0 +1,119 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <stdexcept>
+
+#include "program/compiledProgram.h"
+#include "program/line.h"
+
+Program::CompiledProgram::CompiledProgram(const Program& prog)
+    : program{&prog}, maxNbOperands{0}
+{
+    const Environment& env = prog.getEnvironment();
+    const Instructions::Set& instructionSet = env.getInstructionSet();
+
+    // Data sources used for scaling locations: they are identical to those
+    // used by ProgramEngine (registers, constants, environment data sources)
+    const std::vector<std::reference_wrapper<const Data::DataHandler>>&
+        dataSources = env.getFakeDataSources();
+
+    this->lines.reserve(prog.getNbLines());
+    for (uint64_t idx = 0; idx < prog.getNbLines(); idx++) {
+        if (prog.isIntron(idx)) {
+            continue;
+        }
+
+        const Line& line = prog.getLine(idx);
+        CompiledLine compiledLine{nullptr, line.getDestinationIndex(),
+                                  this->operands.size(), 0, true};
+
+        try {
+            const Instructions::Instruction& instruction =
+                instructionSet.getInstruction(line.getInstructionIndex());
+            compiledLine.instruction = &instruction;
+            compiledLine.nbOperands = instruction.getNbOperands();
+
+            for (uint64_t i = 0; i < instruction.getNbOperands(); i++) {
+                const std::pair<uint64_t, uint64_t>& operand =
+                    line.getOperand(i);
+                const std::type_info& type =
+                    instruction.getOperandTypes().at(i).get();
+                const Data::DataHandler& dataSource =
+                    dataSources.at(operand.first);
+                if (dataSource.getAddressSpace(type) == 0) {
+                    // Location cannot be scaled for a type not provided by
+                    // the data source.
+                    throw std::out_of_range(
+                        "Operand type not provided by the data source.");
+                }
+                this->operands.push_back(
+                    {operand.first,
+                     dataSource.scaleLocation(operand.second, type), &type});
+            }
+        }
+        catch (std::out_of_range&) {
+            // The interpreter would throw when executing this line.
+            // Keep the line, marked as invalid, to reproduce this behavior.
+            this->operands.resize(compiledLine.firstOperand);
+            compiledLine.nbOperands = 0;
+            compiledLine.valid = false;
+        }
+
+        if (compiledLine.nbOperands > this->maxNbOperands) {
+            this->maxNbOperands = compiledLine.nbOperands;
+        }
+        this->lines.push_back(compiledLine);
+    }
+}
+
+const Program::Program& Program::CompiledProgram::getProgram() const
+{
+    return *this->program;
+}
+
+const std::vector<Program::CompiledProgram::CompiledLine>& Program::
+    CompiledProgram::getLines() const
+{
+    return this->lines;
+}
+
+const std::vector<Program::CompiledProgram::CompiledOperand>& Program::
+    CompiledProgram::getOperands() const
+{
+    return this->operands;
+}
+
+uint64_t Program::CompiledProgram::getMaxNbOperands() const
+{
+    return this->maxNbOperands;
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "data/untypedSharedPtr.h"
+#include "program/doubleOperation.h"
+
+namespace {
+    /// Operands on which declared operations are checked. They are in the
+    /// domain of all the functions of the standard C library accepted in
+    /// CALL operations, and distinguish the order of binary operands.
+    const double PROBES[][2] = {{0.75, 2.5}, {3.0, -0.5}, {1.5, 1.0}};
+
+    /// Compare two results, considering all NaN as equal.
+    bool isSameResult(double a, double b)
+    {
+        return (a == b) || (std::isnan(a) && std::isnan(b));
+    }
+} // namespace
+
+double Program::DoubleOperation::execute(const double* arguments) const
+{
+    const double a = arguments[this->operands[0]];
+    const double b = arguments[this->operands[1]];
+    switch (this->opcode) {
+    case Opcode::ADD:
+        return a + b;
+    case Opcode::SUB:
+        return a - b;
+    case Opcode::MUL:
+        return a * b;
+    case Opcode::DIV:
+        return a / b;
+    case Opcode::SQRT:
+        return std::sqrt(a);
+    default:
+        return this->function(a);
+    }
+}
+
+bool Program::DoubleOperation::identify(
+    const Instructions::Instruction& instruction, DoubleOperation& operation)
+{
+    const auto& types = instruction.getOperandTypes();
+    if (types.empty() || types.size() > 2) {
+        return false;
+    }
+    for (const auto& type : types) {
+        if (type.get() != typeid(double)) {
+            return false;
+        }
+    }
+
+    DoubleOperation declared;
+    if (!instruction.getDoubleOperation(declared)) {
+        return false;
+    }
+
+    // Check the consistency of the declaration with the Instruction.
+    const bool isUnary =
+        declared.opcode == Opcode::SQRT || declared.opcode == Opcode::CALL;
+    if (declared.nbOperands != (isUnary ? 1 : 2) ||
+        (declared.opcode == Opcode::CALL && declared.function == nullptr)) {
+        return false;
+    }
+    for (uint64_t i = 0; i < 2; i++) {
+        if (i >= declared.nbOperands) {
+            declared.operands[i] = declared.operands[0];
+        }
+        if (declared.operands[i] >= types.size()) {
+            return false;
+        }
+    }
+
+    // Check the declared operation against the execution of the Instruction.
+    for (const auto& probe : PROBES) {
+        double values[2] = {probe[0], probe[1]};
+        std::vector<Data::UntypedSharedPtr> arguments;
+        for (size_t i = 0; i < types.size(); i++) {
+            arguments.emplace_back(
+                &values[i], Data::UntypedSharedPtr::emptyDestructor<double>());
+        }
+        if (!isSameResult(instruction.execute(arguments),
+                          declared.execute(values))) {
+            return false;
+        }
+    }
+
+    operation = declared;
+    return true;
+}
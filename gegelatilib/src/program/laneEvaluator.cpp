@@ -0,0 +1,460 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LANE_EVALUATOR_X86_64
+#include <immintrin.h>
+#endif
+
+#include "program/compiledProgram.h"
+#include "program/doubleOperation.h"
+#include "program/laneEvaluator.h"
+
+namespace {
+    using Opcode = Program::DoubleOperation::Opcode;
+
+    /// Operations of the steps of a group of Program.
+    struct Steps
+    {
+        /// DoubleOperation::Opcode of each operation.
+        const int64_t* opcodes;
+        /// Index in the memory of the first operand of each operation.
+        const int64_t* firstOperands;
+        /// Index in the memory of the second operand of each operation.
+        const int64_t* secondOperands;
+        /// Index in the memory of the destination of each operation.
+        const int64_t* destinations;
+        /// Function called by each CALL operation.
+        double (*const* functions)(double);
+        /// Bit mask of the Opcode executed during each step.
+        const uint8_t* stepOpcodes;
+        /// Number of steps.
+        size_t nbSteps;
+    };
+
+    /// Execute the steps of a group lane by lane.
+    void executeScalar(double* memory, const Steps& steps, size_t nbLanes)
+    {
+        for (size_t idx = 0; idx < steps.nbSteps * nbLanes; idx++) {
+            const double a = memory[steps.firstOperands[idx]];
+            const double b = memory[steps.secondOperands[idx]];
+            double result;
+            switch ((Opcode)steps.opcodes[idx]) {
+            case Opcode::ADD:
+                result = a + b;
+                break;
+            case Opcode::SUB:
+                result = a - b;
+                break;
+            case Opcode::MUL:
+                result = a * b;
+                break;
+            case Opcode::DIV:
+                result = a / b;
+                break;
+            case Opcode::SQRT:
+                result = std::sqrt(a);
+                break;
+            default:
+                result = steps.functions[idx](a);
+                break;
+            }
+            memory[steps.destinations[idx]] = result;
+        }
+    }
+
+#ifdef LANE_EVALUATOR_X86_64
+    /// Execute the steps of a group with 4 lanes of AVX2 registers.
+    __attribute__((target("avx2"))) void executeAVX2(double* memory,
+                                                     const Steps& steps)
+    {
+        alignas(32) double results[4];
+        const __m256i sub = _mm256_set1_epi64x((int64_t)Opcode::SUB);
+        const __m256i mul = _mm256_set1_epi64x((int64_t)Opcode::MUL);
+        const __m256i div = _mm256_set1_epi64x((int64_t)Opcode::DIV);
+        const __m256i sqrt = _mm256_set1_epi64x((int64_t)Opcode::SQRT);
+        for (size_t step = 0; step < steps.nbSteps; step++) {
+            const size_t idx = step * 4;
+            const __m256d a = _mm256_i64gather_pd(
+                memory,
+                _mm256_loadu_si256(
+                    (const __m256i*)(steps.firstOperands + idx)),
+                8);
+            const __m256d b = _mm256_i64gather_pd(
+                memory,
+                _mm256_loadu_si256(
+                    (const __m256i*)(steps.secondOperands + idx)),
+                8);
+            const __m256i opcodes =
+                _mm256_loadu_si256((const __m256i*)(steps.opcodes + idx));
+
+            // Compute the operations of the step, and keep the one of each
+            // lane.
+            const uint8_t stepOpcodes = steps.stepOpcodes[step];
+            __m256d result = _mm256_add_pd(a, b);
+            if (stepOpcodes & (1 << (int)Opcode::SUB)) {
+                result = _mm256_blendv_pd(
+                    result, _mm256_sub_pd(a, b),
+                    _mm256_castsi256_pd(_mm256_cmpeq_epi64(opcodes, sub)));
+            }
+            if (stepOpcodes & (1 << (int)Opcode::MUL)) {
+                result = _mm256_blendv_pd(
+                    result, _mm256_mul_pd(a, b),
+                    _mm256_castsi256_pd(_mm256_cmpeq_epi64(opcodes, mul)));
+            }
+            if (stepOpcodes & (1 << (int)Opcode::DIV)) {
+                result = _mm256_blendv_pd(
+                    result, _mm256_div_pd(a, b),
+                    _mm256_castsi256_pd(_mm256_cmpeq_epi64(opcodes, div)));
+            }
+            if (stepOpcodes & (1 << (int)Opcode::SQRT)) {
+                result = _mm256_blendv_pd(
+                    result, _mm256_sqrt_pd(a),
+                    _mm256_castsi256_pd(_mm256_cmpeq_epi64(opcodes, sqrt)));
+            }
+            _mm256_store_pd(results, result);
+
+            if (stepOpcodes & (1 << (int)Opcode::CALL)) {
+                for (size_t lane = 0; lane < 4; lane++) {
+                    if (steps.opcodes[idx + lane] == (int64_t)Opcode::CALL) {
+                        results[lane] = steps.functions[idx + lane](
+                            memory[steps.firstOperands[idx + lane]]);
+                    }
+                }
+            }
+            for (size_t lane = 0; lane < 4; lane++) {
+                memory[steps.destinations[idx + lane]] = results[lane];
+            }
+        }
+    }
+
+    /// Execute the steps of a group with 8 lanes of AVX-512 registers.
+    __attribute__((target("avx512f"))) void executeAVX512(double* memory,
+                                                          const Steps& steps)
+    {
+        alignas(64) double results[8];
+        const __m512i sub = _mm512_set1_epi64((int64_t)Opcode::SUB);
+        const __m512i mul = _mm512_set1_epi64((int64_t)Opcode::MUL);
+        const __m512i div = _mm512_set1_epi64((int64_t)Opcode::DIV);
+        const __m512i sqrt = _mm512_set1_epi64((int64_t)Opcode::SQRT);
+        for (size_t step = 0; step < steps.nbSteps; step++) {
+            const size_t idx = step * 8;
+            const __m512d a = _mm512_i64gather_pd(
+                _mm512_loadu_si512(steps.firstOperands + idx), memory, 8);
+            const __m512d b = _mm512_i64gather_pd(
+                _mm512_loadu_si512(steps.secondOperands + idx), memory, 8);
+            const __m512i opcodes = _mm512_loadu_si512(steps.opcodes + idx);
+
+            // Compute the operations of the step, and keep the one of each
+            // lane.
+            const uint8_t stepOpcodes = steps.stepOpcodes[step];
+            __m512d result = _mm512_add_pd(a, b);
+            if (stepOpcodes & (1 << (int)Opcode::SUB)) {
+                result = _mm512_mask_blend_pd(
+                    _mm512_cmpeq_epi64_mask(opcodes, sub), result,
+                    _mm512_sub_pd(a, b));
+            }
+            if (stepOpcodes & (1 << (int)Opcode::MUL)) {
+                result = _mm512_mask_blend_pd(
+                    _mm512_cmpeq_epi64_mask(opcodes, mul), result,
+                    _mm512_mul_pd(a, b));
+            }
+            if (stepOpcodes & (1 << (int)Opcode::DIV)) {
+                result = _mm512_mask_blend_pd(
+                    _mm512_cmpeq_epi64_mask(opcodes, div), result,
+                    _mm512_div_pd(a, b));
+            }
+            if (stepOpcodes & (1 << (int)Opcode::SQRT)) {
+                result = _mm512_mask_blend_pd(
+                    _mm512_cmpeq_epi64_mask(opcodes, sqrt), result,
+                    _mm512_sqrt_pd(a));
+            }
+
+            if (stepOpcodes & (1 << (int)Opcode::CALL)) {
+                _mm512_store_pd(results, result);
+                for (size_t lane = 0; lane < 8; lane++) {
+                    if (steps.opcodes[idx + lane] == (int64_t)Opcode::CALL) {
+                        results[lane] = steps.functions[idx + lane](
+                            memory[steps.firstOperands[idx + lane]]);
+                    }
+                }
+                result = _mm512_load_pd(results);
+            }
+            // Lanes write distinct registers, or the dummy location.
+            _mm512_i64scatter_pd(memory,
+                                 _mm512_loadu_si512(steps.destinations + idx),
+                                 result, 8);
+        }
+    }
+#endif // LANE_EVALUATOR_X86_64
+} // namespace
+
+Program::LaneEvaluator::LaneEvaluator(
+    const std::vector<const Program*>& programs, InstructionSet instructionSet)
+    : instructionSet{instructionSet}, nbPrograms{programs.size()},
+      nbRegisters{0}, evaluable{false}, operandBuffer(1)
+{
+    if (!isSupported(instructionSet)) {
+        throw std::invalid_argument(
+            "InstructionSet not supported on the current platform.");
+    }
+    this->nbLanes = (instructionSet == InstructionSet::AVX512) ? 8
+                    : (instructionSet == InstructionSet::AVX2) ? 4
+                                                               : 1;
+    if (programs.empty()) {
+        this->evaluable = true;
+        return;
+    }
+
+    const Environment& env = programs.front()->getEnvironment();
+    this->nbRegisters = env.getNbRegisters();
+    // Index of the first environment data source in the ProgramEngine.
+    const uint64_t offset = (env.getNbConstant() > 0) ? 2 : 1;
+    const int64_t inputsBase = (int64_t)(this->nbRegisters * this->nbLanes);
+    // Index of the dummy location, known once all inputs are identified.
+    const int64_t dummy = -1;
+
+    // Program with similar numbers of lines are grouped to limit the steps
+    // where lanes are idle.
+    std::vector<CompiledProgram> compiledPrograms;
+    for (const Program* program : programs) {
+        compiledPrograms.emplace_back(*program);
+    }
+    this->order.resize(programs.size());
+    std::iota(this->order.begin(), this->order.end(), 0);
+    std::stable_sort(this->order.begin(), this->order.end(),
+                     [&compiledPrograms](size_t a, size_t b) {
+                         return compiledPrograms[a].getLines().size() <
+                                compiledPrograms[b].getLines().size();
+                     });
+
+    // Translate the lines of each Program, in the order of the lanes.
+    std::map<std::pair<uint64_t, uint64_t>, int64_t> inputIndexes;
+    std::vector<std::vector<int64_t>> programOperations(programs.size());
+    std::vector<std::vector<double (*)(double)>> programFunctions(
+        programs.size());
+    for (size_t p = 0; p < programs.size(); p++) {
+        const int64_t lane = (int64_t)(p % this->nbLanes);
+        const CompiledProgram& compiled = compiledPrograms[this->order[p]];
+        const auto& operands = compiled.getOperands();
+        for (const CompiledProgram::CompiledLine& line : compiled.getLines()) {
+            DoubleOperation operation;
+            if (!line.valid ||
+                !DoubleOperation::identify(*line.instruction, operation)) {
+                return;
+            }
+
+            int64_t indexes[2];
+            for (uint64_t i = 0; i < operation.nbOperands; i++) {
+                const CompiledProgram::CompiledOperand& operand =
+                    operands[line.firstOperand + operation.operands[i]];
+                if (operand.dataSourceIndex == 0) {
+                    indexes[i] = (int64_t)operand.location *
+                                     (int64_t)this->nbLanes +
+                                 lane;
+                }
+                else if (operand.dataSourceIndex < offset) {
+                    return; // Constants are not double
+                }
+                else {
+                    const std::pair<uint64_t, uint64_t> input{
+                        operand.dataSourceIndex - offset, operand.location};
+                    auto [iter, inserted] = inputIndexes.emplace(
+                        input, inputsBase + (int64_t)this->inputs.size());
+                    if (inserted) {
+                        this->inputs.push_back({input.first, input.second});
+                    }
+                    indexes[i] = iter->second;
+                }
+            }
+            if (operation.nbOperands == 1) {
+                indexes[1] = indexes[0];
+            }
+
+            programOperations[p].insert(
+                programOperations[p].end(),
+                {(int64_t)operation.opcode, indexes[0], indexes[1],
+                 (int64_t)line.destinationIndex * (int64_t)this->nbLanes +
+                     lane});
+            programFunctions[p].push_back(operation.function);
+        }
+    }
+
+    // Interleave the lines of the Program of each group.
+    const int64_t dummyIndex = inputsBase + (int64_t)this->inputs.size();
+    auto resolve = [dummy, dummyIndex](int64_t index) {
+        return (index == dummy) ? dummyIndex : index;
+    };
+    for (size_t first = 0; first < programs.size();
+         first += this->nbLanes) {
+        size_t groupSteps = 0;
+        for (size_t p = first;
+             p < std::min(first + this->nbLanes, programs.size()); p++) {
+            groupSteps = std::max(groupSteps, programFunctions[p].size());
+        }
+        this->nbSteps.push_back(groupSteps);
+        for (size_t step = 0; step < groupSteps; step++) {
+            uint8_t stepOpcodes = 0;
+            for (size_t lane = 0; lane < this->nbLanes; lane++) {
+                const size_t p = first + lane;
+                int64_t operation[4] = {(int64_t)Opcode::ADD, dummy, dummy,
+                                        dummy};
+                double (*function)(double) = nullptr;
+                if (p < programs.size() &&
+                    step < programFunctions[p].size()) {
+                    std::copy_n(programOperations[p].begin() + 4 * step, 4,
+                                operation);
+                    function = programFunctions[p][step];
+                }
+                stepOpcodes |= (uint8_t)(1 << operation[0]);
+                this->opcodes.push_back(operation[0]);
+                this->firstOperands.push_back(resolve(operation[1]));
+                this->secondOperands.push_back(resolve(operation[2]));
+                this->destinations.push_back(resolve(operation[3]));
+                this->functions.push_back(function);
+            }
+            this->stepOpcodes.push_back(stepOpcodes);
+        }
+    }
+
+    this->memory.resize(dummyIndex + 1);
+    this->evaluable = true;
+}
+
+bool Program::LaneEvaluator::isSupported(InstructionSet instructionSet)
+{
+    switch (instructionSet) {
+#ifdef LANE_EVALUATOR_X86_64
+    case InstructionSet::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case InstructionSet::AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    case InstructionSet::SCALAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Program::LaneEvaluator::InstructionSet Program::LaneEvaluator::
+    getBestInstructionSet()
+{
+    if (isSupported(InstructionSet::AVX512)) {
+        return InstructionSet::AVX512;
+    }
+    if (isSupported(InstructionSet::AVX2)) {
+        return InstructionSet::AVX2;
+    }
+    return InstructionSet::SCALAR;
+}
+
+Program::LaneEvaluator::InstructionSet Program::LaneEvaluator::
+    getInstructionSet() const
+{
+    return this->instructionSet;
+}
+
+bool Program::LaneEvaluator::isEvaluable() const
+{
+    return this->evaluable;
+}
+
+void Program::LaneEvaluator::evaluate(
+    const std::vector<std::reference_wrapper<const Data::DataHandler>>&
+        dataSources,
+    double* results)
+{
+    if (!this->evaluable) {
+        throw std::runtime_error("Program cannot be evaluated in lanes.");
+    }
+
+    // Read each input once.
+    const size_t inputsBase = this->nbRegisters * this->nbLanes;
+    for (size_t idx = 0; idx < this->inputs.size(); idx++) {
+        const Input& input = this->inputs[idx];
+        this->operandBuffer.clear();
+        dataSources.at(input.dataSourceIndex)
+            .get()
+            .fetchDataAt(typeid(double), input.location, this->operandBuffer);
+        this->memory[inputsBase + idx] =
+            *this->operandBuffer.getPointer<double>(0);
+    }
+
+    size_t firstOperation = 0;
+    size_t firstStep = 0;
+    for (size_t group = 0; group < this->nbSteps.size(); group++) {
+        const Steps steps{this->opcodes.data() + firstOperation,
+                          this->firstOperands.data() + firstOperation,
+                          this->secondOperands.data() + firstOperation,
+                          this->destinations.data() + firstOperation,
+                          this->functions.data() + firstOperation,
+                          this->stepOpcodes.data() + firstStep,
+                          this->nbSteps[group]};
+
+        // Registers are reset for each Program.
+        std::fill(this->memory.begin(), this->memory.begin() + inputsBase,
+                  0.0);
+        switch (this->instructionSet) {
+#ifdef LANE_EVALUATOR_X86_64
+        case InstructionSet::AVX2:
+            executeAVX2(this->memory.data(), steps);
+            break;
+        case InstructionSet::AVX512:
+            executeAVX512(this->memory.data(), steps);
+            break;
+#endif
+        default:
+            executeScalar(this->memory.data(), steps, this->nbLanes);
+            break;
+        }
+
+        // Register 0 of each lane.
+        const size_t first = group * this->nbLanes;
+        for (size_t lane = 0;
+             lane < this->nbLanes && first + lane < this->nbPrograms;
+             lane++) {
+            results[this->order[first + lane]] = this->memory[lane];
+        }
+
+        firstOperation += this->nbSteps[group] * this->nbLanes;
+        firstStep += this->nbSteps[group];
+    }
+}
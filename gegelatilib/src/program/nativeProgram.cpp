@@ -0,0 +1,322 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) && defined(__unix__)
+#define NATIVE_PROGRAM_X86_64
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "program/doubleOperation.h"
+#include "program/nativeProgram.h"
+
+namespace {
+    using Opcode = Program::DoubleOperation::Opcode;
+    using Operation = Program::DoubleOperation;
+
+    /// Minimal encoder of the x86-64 instructions used by NativeProgram.
+    class Assembler
+    {
+      public:
+        /// Encoded machine code.
+        std::vector<uint8_t> bytes;
+
+        /// Append raw bytes to the machine code.
+        void emit(std::initializer_list<uint8_t> values)
+        {
+            bytes.insert(bytes.end(), values);
+        }
+
+        /// Append a little-endian 32-bit displacement.
+        void emit32(uint32_t value)
+        {
+            for (int i = 0; i < 4; i++) {
+                bytes.push_back((value >> (8 * i)) & 0xFF);
+            }
+        }
+
+        /// Append a little-endian 64-bit immediate.
+        void emit64(uint64_t value)
+        {
+            for (int i = 0; i < 8; i++) {
+                bytes.push_back((value >> (8 * i)) & 0xFF);
+            }
+        }
+
+        /// push rbx; push r12; push r13; mov rbx, rdi; mov r12, rsi
+        void prologue()
+        {
+            // Three pushes keep the stack 16-byte aligned for calls.
+            emit({0x53, 0x41, 0x54, 0x41, 0x55});
+            emit({0x48, 0x89, 0xFB});
+            emit({0x49, 0x89, 0xF4});
+        }
+
+        /// movsd xmm0, [rbx]; pop r13; pop r12; pop rbx; ret
+        void epilogue()
+        {
+            loadRegister(0, 0);
+            emit({0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3});
+        }
+
+        /// movsd xmm<xmm>, [rbx + disp]
+        void loadRegister(uint8_t xmm, uint32_t disp)
+        {
+            emit({0xF2, 0x0F, 0x10, uint8_t(0x83 | (xmm << 3))});
+            emit32(disp);
+        }
+
+        /// mov rax, [r12 + slotDisp]; movsd xmm<xmm>, [rax + disp]
+        void loadSource(uint8_t xmm, uint32_t slotDisp, uint32_t disp)
+        {
+            emit({0x49, 0x8B, 0x84, 0x24});
+            emit32(slotDisp);
+            emit({0xF2, 0x0F, 0x10, uint8_t(0x80 | (xmm << 3))});
+            emit32(disp);
+        }
+
+        /// movsd [rbx + disp], xmm0
+        void storeRegister(uint32_t disp)
+        {
+            emit({0xF2, 0x0F, 0x11, 0x83});
+            emit32(disp);
+        }
+
+        /// Scalar operation on xmm0 (and xmm1), result in xmm0.
+        void operation(const Operation& op)
+        {
+            switch (op.opcode) {
+            case Opcode::ADD:
+                emit({0xF2, 0x0F, 0x58, 0xC1});
+                break;
+            case Opcode::SUB:
+                emit({0xF2, 0x0F, 0x5C, 0xC1});
+                break;
+            case Opcode::MUL:
+                emit({0xF2, 0x0F, 0x59, 0xC1});
+                break;
+            case Opcode::DIV:
+                emit({0xF2, 0x0F, 0x5E, 0xC1});
+                break;
+            case Opcode::SQRT:
+                emit({0xF2, 0x0F, 0x51, 0xC0});
+                break;
+            case Opcode::CALL:
+                // mov rax, imm64; call rax
+                emit({0x48, 0xB8});
+                emit64(reinterpret_cast<uint64_t>(op.function));
+                emit({0xFF, 0xD0});
+                break;
+            }
+        }
+    };
+
+    /// Byte displacement of a double location, if it fits in 32 bits.
+    bool toDisplacement(uint64_t location, uint32_t& disp)
+    {
+        if (location > std::numeric_limits<int32_t>::max() / sizeof(double)) {
+            return false;
+        }
+        disp = (uint32_t)(location * sizeof(double));
+        return true;
+    }
+} // namespace
+
+Program::NativeProgram::NativeProgram(const CompiledProgram& compiled)
+    : compiled{&compiled}, code{nullptr}, codeSize{0}
+{
+    if (!isPlatformSupported()) {
+        return;
+    }
+
+    // First pass: identify operations and ranges of data source locations.
+    const auto& lines = compiled.getLines();
+    const auto& operands = compiled.getOperands();
+    std::vector<Operation> operations(lines.size());
+    std::vector<size_t> slots(operands.size(), 0);
+    for (size_t idx = 0; idx < lines.size(); idx++) {
+        const CompiledProgram::CompiledLine& line = lines[idx];
+        if (!line.valid ||
+            !Operation::identify(*line.instruction, operations[idx])) {
+            this->dataSources.clear();
+            return;
+        }
+
+        for (uint64_t i = 0; i < line.nbOperands; i++) {
+            const uint64_t operandIdx = line.firstOperand + i;
+            const CompiledProgram::CompiledOperand& operand =
+                operands[operandIdx];
+            if (operand.dataSourceIndex == 0) {
+                continue; // Registers
+            }
+
+            size_t slot = 0;
+            while (slot < this->dataSources.size() &&
+                   this->dataSources[slot].dataSourceIndex !=
+                       operand.dataSourceIndex) {
+                slot++;
+            }
+            if (slot == this->dataSources.size()) {
+                this->dataSources.push_back({operand.dataSourceIndex,
+                                             operand.location,
+                                             operand.location});
+            }
+            DataSourceRange& range = this->dataSources[slot];
+            range.minLocation = std::min(range.minLocation, operand.location);
+            range.maxLocation = std::max(range.maxLocation, operand.location);
+            slots[operandIdx] = slot;
+        }
+    }
+
+    // Second pass: encode the lines.
+    Assembler assembler;
+    assembler.prologue();
+    for (size_t idx = 0; idx < lines.size(); idx++) {
+        const CompiledProgram::CompiledLine& line = lines[idx];
+        const Operation& operation = operations[idx];
+        for (uint64_t xmm = 0; xmm < operation.nbOperands; xmm++) {
+            const uint64_t operandIdx =
+                line.firstOperand + operation.operands[xmm];
+            const CompiledProgram::CompiledOperand& operand =
+                operands[operandIdx];
+            uint32_t disp, slotDisp;
+            if (operand.dataSourceIndex == 0) {
+                if (!toDisplacement(operand.location, disp)) {
+                    this->dataSources.clear();
+                    return;
+                }
+                assembler.loadRegister((uint8_t)xmm, disp);
+            }
+            else {
+                const DataSourceRange& range =
+                    this->dataSources[slots[operandIdx]];
+                if (!toDisplacement(operand.location - range.minLocation,
+                                    disp) ||
+                    !toDisplacement(slots[operandIdx], slotDisp)) {
+                    this->dataSources.clear();
+                    return;
+                }
+                assembler.loadSource((uint8_t)xmm, slotDisp, disp);
+            }
+        }
+        assembler.operation(operation);
+
+        uint32_t disp;
+        if (!toDisplacement(line.destinationIndex, disp)) {
+            this->dataSources.clear();
+            return;
+        }
+        assembler.storeRegister(disp);
+    }
+    assembler.epilogue();
+
+#ifdef NATIVE_PROGRAM_X86_64
+    // Copy the code in a writable mapping, then make it executable.
+    const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t size =
+        ((assembler.bytes.size() + pageSize - 1) / pageSize) * pageSize;
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        this->dataSources.clear();
+        return;
+    }
+    std::memcpy(mapping, assembler.bytes.data(), assembler.bytes.size());
+    if (mprotect(mapping, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(mapping, size);
+        this->dataSources.clear();
+        return;
+    }
+    this->code = mapping;
+    this->codeSize = size;
+#endif
+}
+
+Program::NativeProgram::~NativeProgram()
+{
+#ifdef NATIVE_PROGRAM_X86_64
+    if (this->code != nullptr) {
+        munmap(this->code, this->codeSize);
+    }
+#endif
+}
+
+bool Program::NativeProgram::isPlatformSupported()
+{
+#ifdef NATIVE_PROGRAM_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool Program::NativeProgram::isInstructionSupported(
+    const Instructions::Instruction& instruction)
+{
+    Operation operation;
+    return isPlatformSupported() &&
+           Operation::identify(instruction, operation);
+}
+
+bool Program::NativeProgram::isNative() const
+{
+    return this->code != nullptr;
+}
+
+const Program::CompiledProgram& Program::NativeProgram::getCompiledProgram()
+    const
+{
+    return *this->compiled;
+}
+
+const std::vector<Program::NativeProgram::DataSourceRange>& Program::
+    NativeProgram::getDataSources() const
+{
+    return this->dataSources;
+}
+
+double Program::NativeProgram::execute(double* registers,
+                                       const double* const* dataSources) const
+{
+    if (this->code == nullptr) {
+        throw std::runtime_error("NativeProgram has no native code.");
+    }
+    return reinterpret_cast<Function>(this->code)(registers, dataSources);
+}
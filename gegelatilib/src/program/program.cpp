@@ -46,13 +46,74 @@
 
 Program::Program::~Program()
 {
-    while (!lines.empty()) {
-        Line* line = lines.back().first;
-        delete line;
-        lines.pop_back();
+    // Line memory is freed with the lineBlocks.
+    for (std::pair<Line*, bool>& line : this->lines) {
+        line.first->~Line();
     }
 }
 
+size_t Program::Program::getLineSlotSize() const
+{
+    // Operands are stored right after the Line, and the next slot must be
+    // aligned for a Line.
+    const size_t operandsOffset =
+        (sizeof(Line) + alignof(std::pair<uint64_t, uint64_t>) - 1) /
+        alignof(std::pair<uint64_t, uint64_t>) *
+        alignof(std::pair<uint64_t, uint64_t>);
+    const size_t slotSize =
+        operandsOffset + this->environment.getMaxNbOperands() *
+                             sizeof(std::pair<uint64_t, uint64_t>);
+    return (slotSize + alignof(Line) - 1) / alignof(Line) * alignof(Line);
+}
+
+unsigned char* Program::Program::getFreeLineSlot(size_t minBlockCapacity)
+{
+    // Reuse the slot of a removed line
+    if (!this->freeLineSlots.empty()) {
+        unsigned char* slot = this->freeLineSlots.back();
+        this->freeLineSlots.pop_back();
+        return slot;
+    }
+
+    // Allocate a new block if needed, doubling the total capacity
+    if (this->lineBlocks.empty() ||
+        this->lineBlocks.back().nbUsed == this->lineBlocks.back().capacity) {
+        size_t capacity = std::max(minBlockCapacity, (size_t)1);
+        for (const LineBlock& block : this->lineBlocks) {
+            capacity = std::max(capacity, block.capacity * 2);
+        }
+        this->lineBlocks.push_back(
+            {std::unique_ptr<unsigned char[]>(
+                 new unsigned char[capacity * this->getLineSlotSize()]),
+             capacity, 0});
+    }
+
+    LineBlock& block = this->lineBlocks.back();
+    return block.memory.get() + (block.nbUsed++) * this->getLineSlotSize();
+}
+
+Program::Line* Program::Program::createLine(const Line* copiedLine,
+                                            size_t minBlockCapacity)
+{
+    unsigned char* slot = this->getFreeLineSlot(minBlockCapacity);
+    std::pair<uint64_t, uint64_t>* operands =
+        reinterpret_cast<std::pair<uint64_t, uint64_t>*>(
+            slot + this->getLineSlotSize() -
+            this->environment.getMaxNbOperands() *
+                sizeof(std::pair<uint64_t, uint64_t>));
+
+    if (copiedLine != nullptr) {
+        return new (slot) Line(*copiedLine, operands);
+    }
+    return new (slot) Line(this->environment, operands);
+}
+
+void Program::Program::destroyLine(Line* line)
+{
+    line->~Line();
+    this->freeLineSlots.push_back(reinterpret_cast<unsigned char*>(line));
+}
+
 Program::Line& Program::Program::addNewLine()
 {
     return this->addNewLine(this->getNbLines());
@@ -64,8 +125,8 @@ Program::Line& Program::Program::addNewLine(const uint64_t idx)
         throw std::out_of_range(
             "Attempting to insert a line beyond the program end.");
     }
-    // Allocate the zero-filled memory
-    Line* newLine = new Line(this->environment);
+    // Create a zero-filled line
+    Line* newLine = this->createLine(nullptr);
     // new line is not marked as an intron by default
     this->lines.insert(lines.begin() + idx, {newLine, false});
 
@@ -93,7 +154,8 @@ void Program::Program::clearIntrons()
 
 void Program::Program::removeLine(const uint64_t idx)
 {
-    delete this->lines.at(idx).first; // throws std::out_of_range on bad index.
+    // throws std::out_of_range on bad index.
+    this->destroyLine(this->lines.at(idx).first);
     this->lines.erase(this->lines.begin() + idx);
 }
 
@@ -141,6 +141,24 @@ const void Program::ProgramEngine::fetchCurrentOperands(
     }
 }
 
+const void Program::ProgramEngine::fetchCurrentOperands(
+    Data::OperandBuffer& operands) const
+{
+    const Line& line = this->getCurrentLine(); // throw std::out_of_range
+    const Instructions::Instruction& instruction =
+        this->getCurrentInstruction(); // throw std::out_of_range
+
+    // Get as many operands as required by the instruction.
+    for (uint64_t i = 0; i < instruction.getNbOperands(); i++) {
+        const Data::DataHandler& dataSource = this->dataScsConstsAndRegs.at(
+            line.getOperand(i).first); // Throws std::out_of_range
+        const uint64_t operandLocation = getOperandLocation(i);
+        const std::type_info& operandType =
+            instruction.getOperandTypes().at(i).get();
+        dataSource.fetchDataAt(operandType, operandLocation, operands);
+    }
+}
+
 uint64_t Program::ProgramEngine::getOperandLocation(uint64_t idxOp) const
 {
     const Line& line = this->getCurrentLine(); // throw std::out_of_range
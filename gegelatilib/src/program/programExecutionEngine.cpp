@@ -40,15 +40,24 @@
 
 void Program::ProgramExecutionEngine::executeCurrentLine()
 {
-    std::vector<Data::UntypedSharedPtr> operands;
-
     // Get everything needed (may throw)
     const Line& line = this->getCurrentLine();
     const Instructions::Instruction& instruction =
         this->getCurrentInstruction();
-    this->fetchCurrentOperands(operands);
 
-    double result = instruction.execute(operands);
+    double result;
+    if (this->useOperandBuffer(instruction)) {
+        this->operandBuffer.clear();
+        this->operandBuffer.setStridedAllowed(
+            instruction.supportsStridedOperands());
+        this->fetchCurrentOperands(this->operandBuffer);
+        result = instruction.execute(this->operandBuffer);
+    }
+    else {
+        std::vector<Data::UntypedSharedPtr> operands;
+        this->fetchCurrentOperands(operands);
+        result = instruction.execute(operands);
+    }
 
     this->registers.setDataAt(typeid(double), line.getDestinationIndex(),
                               result);
@@ -68,6 +77,164 @@ double Program::ProgramExecutionEngine::executeProgram(
                  .getSharedPointer<const double>());
 }
 
+double Program::ProgramExecutionEngine::executeCompiledProgram(
+    const CompiledProgram& compiled, const bool ignoreException)
+{
+    if (this->program != &compiled.getProgram()) {
+        this->setProgram(compiled.getProgram());
+    }
+
+    return this->executeCompiledLines(compiled, ignoreException);
+}
+
+double Program::ProgramExecutionEngine::executeNativeProgram(
+    const NativeProgram& native, const bool ignoreException)
+{
+    const CompiledProgram& compiled = native.getCompiledProgram();
+    if (this->program != &compiled.getProgram()) {
+        this->setProgram(compiled.getProgram());
+    }
+
+    if (!native.isNative()) {
+        return this->executeCompiledLines(compiled, ignoreException);
+    }
+
+    // The native code addresses the range of locations read in each data
+    // source from the first one, which requires contiguous data.
+    const auto& ranges = native.getDataSources();
+    this->nativeDataSources.resize(ranges.size());
+    for (size_t idx = 0; idx < ranges.size(); idx++) {
+        const NativeProgram::DataSourceRange& range = ranges[idx];
+        const Data::DataHandler& dataSource =
+            this->dataScsConstsAndRegs.at(range.dataSourceIndex);
+        const double* data = static_cast<const double*>(
+            dataSource.getContiguousData(typeid(double)));
+        if (data == nullptr) {
+            return this->executeCompiledLines(compiled, ignoreException);
+        }
+        this->nativeDataSources[idx] = data + range.minLocation;
+    }
+
+    // Reset registers and execute.
+    this->nativeRegisters.assign(this->registers.getLargestAddressSpace(),
+                                 0.0);
+    return native.execute(this->nativeRegisters.data(),
+                          this->nativeDataSources.data());
+}
+
+void Program::ProgramExecutionEngine::executeCompiledProgramBatch(
+    const CompiledProgram& compiled,
+    const std::vector<std::reference_wrapper<
+        const std::vector<std::reference_wrapper<const Data::DataHandler>>>>&
+        dataSourcesSets,
+    std::vector<double>& results, const bool ignoreException)
+{
+    if (this->program != &compiled.getProgram()) {
+        this->setProgram(compiled.getProgram());
+    }
+
+    // Check compatibility of all sets once and for all.
+    const std::vector<std::reference_wrapper<const Data::DataHandler>>&
+        envDataSources = this->program->getEnvironment().getDataSources();
+    for (const auto& dataSourcesSet : dataSourcesSets) {
+        if (dataSourcesSet.get().size() != envDataSources.size()) {
+            throw std::runtime_error(
+                "Data sources characteristics for Program Execution differ "
+                "from Program reference Environment.");
+        }
+        for (size_t i = 0; i < envDataSources.size(); i++) {
+            if (dataSourcesSet.get().at(i).get().getId() !=
+                envDataSources.at(i).get().getId()) {
+                throw std::runtime_error(
+                    "Data sources characteristics for Program Execution "
+                    "differ from Program reference Environment.");
+            }
+        }
+    }
+
+    // Keep the current data sources to restore them at the end.
+    const std::vector<std::reference_wrapper<const Data::DataHandler>>
+        savedDataScsConstsAndRegs = this->dataScsConstsAndRegs;
+    const size_t offset =
+        this->dataScsConstsAndRegs.size() - envDataSources.size();
+
+    results.resize(dataSourcesSets.size());
+    try {
+        for (size_t idx = 0; idx < dataSourcesSets.size(); idx++) {
+            const auto& dataSourcesSet = dataSourcesSets[idx].get();
+            for (size_t i = 0; i < dataSourcesSet.size(); i++) {
+                this->dataScsConstsAndRegs[i + offset] = dataSourcesSet[i];
+            }
+            results[idx] =
+                this->executeCompiledLines(compiled, ignoreException);
+        }
+    }
+    catch (...) {
+        this->dataScsConstsAndRegs = savedDataScsConstsAndRegs;
+        throw; // rethrow
+    }
+
+    this->dataScsConstsAndRegs = savedDataScsConstsAndRegs;
+}
+
+double Program::ProgramExecutionEngine::executeCompiledLines(
+    const CompiledProgram& compiled, const bool ignoreException)
+{
+    // Reset registers
+    this->registers.resetData();
+
+    const CompiledProgram::CompiledOperand* operands =
+        compiled.getOperands().data();
+
+    for (const CompiledProgram::CompiledLine& line : compiled.getLines()) {
+        try {
+            if (!line.valid) {
+                throw std::out_of_range(
+                    "Invalid line in the CompiledProgram.");
+            }
+
+            // Fetch operands with their pre-scaled locations
+            double result;
+            const CompiledProgram::CompiledOperand* operand =
+                operands + line.firstOperand;
+            if (this->useOperandBuffer(*line.instruction)) {
+                this->operandBuffer.clear();
+                this->operandBuffer.setStridedAllowed(
+                    line.instruction->supportsStridedOperands());
+                for (uint64_t i = 0; i < line.nbOperands; i++, operand++) {
+                    this->dataScsConstsAndRegs[operand->dataSourceIndex]
+                        .get()
+                        .fetchDataAt(*operand->type, operand->location,
+                                     this->operandBuffer);
+                }
+                result = line.instruction->execute(this->operandBuffer);
+            }
+            else {
+                this->compiledOperands.clear();
+                for (uint64_t i = 0; i < line.nbOperands; i++, operand++) {
+                    const Data::DataHandler& dataSource =
+                        this->dataScsConstsAndRegs[operand->dataSourceIndex];
+                    this->compiledOperands.push_back(dataSource.getDataAt(
+                        *operand->type, operand->location));
+                }
+                result = line.instruction->execute(this->compiledOperands);
+            }
+
+            this->registers.setDataAt(typeid(double), line.destinationIndex,
+                                      result);
+        }
+        catch (std::out_of_range& e) {
+            if (!ignoreException) {
+                throw e; // rethrow
+            }
+        }
+    }
+
+    // Returns the 0-indexed register.
+    return *(this->registers.getDataAt(typeid(double), 0)
+                 .getSharedPointer<const double>());
+}
+
 void Program::ProgramExecutionEngine::processLine()
 {
     this->executeCurrentLine();
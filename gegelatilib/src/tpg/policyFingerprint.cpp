@@ -0,0 +1,149 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <typeinfo>
+
+#include "data/constant.h"
+#include "data/hash.h"
+#include "environment.h"
+#include "instructions/instruction.h"
+#include "tpg/tpgAction.h"
+#include "tpg/tpgEdge.h"
+#include "tpg/tpgTeam.h"
+
+#include "tpg/policyFingerprint.h"
+
+/// Tags differentiating the fingerprints of TPGAction and TPGTeam.
+static const uint64_t ACTION_TAG = 0x41;
+static const uint64_t TEAM_TAG = 0x54;
+
+uint64_t TPG::PolicyFingerprint::getFingerprint(const TPGVertex& vertex)
+{
+    // Memoized fingerprint
+    auto iter = this->vertexFingerprints.find(&vertex);
+    if (iter != this->vertexFingerprints.end()) {
+        if (iter->second == 0) {
+            // The vertex is being hashed: this is a cycle.
+            this->cycleDetected = true;
+        }
+        return iter->second;
+    }
+
+    size_t hash = Data::_FNV_offset_basis;
+    const TPGAction* action = dynamic_cast<const TPGAction*>(&vertex);
+    if (action != nullptr) {
+        hash = Data::_Fnv1a_append_value(hash, ACTION_TAG);
+        hash = Data::_Fnv1a_append_value(hash, action->getActionID());
+    }
+    else {
+        // Mark the vertex as being hashed.
+        this->vertexFingerprints.emplace(&vertex, 0);
+
+        hash = Data::_Fnv1a_append_value(hash, TEAM_TAG);
+        for (const TPGEdge* edge : vertex.getOutgoingEdges()) {
+            hash = Data::_Fnv1a_append_value(
+                hash, this->getFingerprint(edge->getProgram()));
+            hash = Data::_Fnv1a_append_value(
+                hash, this->getFingerprint(*edge->getDestination()));
+        }
+    }
+
+    // 0 is reserved for vertices being hashed.
+    uint64_t fingerprint = (hash == 0) ? 1 : hash;
+    this->vertexFingerprints[&vertex] = fingerprint;
+    return fingerprint;
+}
+
+uint64_t TPG::PolicyFingerprint::getFingerprint(const Program::Program& prog)
+{
+    auto iter = this->programFingerprints.find(&prog);
+    if (iter != this->programFingerprints.end()) {
+        return iter->second;
+    }
+
+    const Environment& env = prog.getEnvironment();
+    const bool hasConstants = env.getNbConstant() > 0;
+
+    size_t hash = Data::_FNV_offset_basis;
+    for (uint64_t lineIdx = 0; lineIdx < prog.getNbLines(); lineIdx++) {
+        if (prog.isIntron(lineIdx)) {
+            continue;
+        }
+
+        const Program::Line& line = prog.getLine(lineIdx);
+        hash = Data::_Fnv1a_append_value(hash, line.getInstructionIndex());
+        hash = Data::_Fnv1a_append_value(hash, line.getDestinationIndex());
+
+        const Instructions::Instruction& instruction =
+            env.getInstructionSet().getInstruction(line.getInstructionIndex());
+        for (uint64_t operandIdx = 0;
+             operandIdx < instruction.getNbOperands(); operandIdx++) {
+            const std::pair<uint64_t, uint64_t>& operand =
+                line.getOperand(operandIdx);
+            hash = Data::_Fnv1a_append_value(hash, operand.first);
+            if (hasConstants && operand.first == 1) {
+                // Hash the value of all Constant read by the operand, not
+                // their location.
+                const std::type_info& type =
+                    instruction.getOperandTypes().at(operandIdx).get();
+                const Data::ConstantHandler& constantHandler =
+                    prog.cGetConstantHandler();
+                const uint64_t location =
+                    constantHandler.scaleLocation(operand.second, type);
+                for (size_t address :
+                     constantHandler.getAddressesAccessed(type, location)) {
+                    hash = Data::_Fnv1a_append_value(
+                        hash, prog.getConstantAt(address).value);
+                }
+            }
+            else {
+                hash = Data::_Fnv1a_append_value(hash, operand.second);
+            }
+        }
+    }
+
+    this->programFingerprints.emplace(&prog, hash);
+    return hash;
+}
+
+bool TPG::PolicyFingerprint::hasCycle() const
+{
+    return this->cycleDetected;
+}
+
+void TPG::PolicyFingerprint::clear()
+{
+    this->vertexFingerprints.clear();
+    this->programFingerprints.clear();
+    this->cycleDetected = false;
+}
@@ -0,0 +1,352 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <new>
+#include <unordered_set>
+
+#include "tpg/tpgArenaFactory.h"
+#include "tpg/tpgGraph.h"
+
+namespace {
+    /**
+     * \brief Header stored in front of each TPGGraph element allocated in a
+     * TPGArena, to find the arena back when the element is deleted.
+     *
+     * The header holds a raw pointer: the TPGArena is kept alive by the
+     * TPGArenaFactory of the TPGGraph holding the element, so allocations
+     * and deletions do not touch a reference count shared by all threads.
+     */
+    struct SlotHeader
+    {
+        /// TPGArena from which the slot was allocated.
+        TPG::TPGArena* arena;
+    };
+
+#ifndef NDEBUG
+    /// TPGArena constructed and not yet destroyed, checked in debug builds
+    /// when an element is deleted.
+    struct LiveArenas
+    {
+        /// Mutex protecting the arenas.
+        std::mutex mutex;
+
+        /// Addresses of the live TPGArena.
+        std::unordered_set<const TPG::TPGArena*> arenas;
+    };
+
+    /// Get the LiveArenas, never destroyed so that TPGArena with a static
+    /// storage duration can still use them.
+    LiveArenas& getLiveArenas()
+    {
+        static LiveArenas* liveArenas = new LiveArenas();
+        return *liveArenas;
+    }
+
+    /// Whether the given TPGArena is alive.
+    bool isArenaAlive(const TPG::TPGArena* arena)
+    {
+        LiveArenas& liveArenas = getLiveArenas();
+        std::lock_guard<std::mutex> lock(liveArenas.mutex);
+        return liveArenas.arenas.count(arena) != 0;
+    }
+#endif // NDEBUG
+
+    /// Size of the SlotHeader, rounded up to preserve the slot alignment.
+    constexpr size_t HEADER_SIZE =
+        ((sizeof(SlotHeader) + TPG::TPGArena::SLOT_ALIGNMENT - 1) /
+         TPG::TPGArena::SLOT_ALIGNMENT) *
+        TPG::TPGArena::SLOT_ALIGNMENT;
+
+    /**
+     * \brief Class whose instances are allocated in a TPGArena.
+     *
+     * Since TPGVertex and TPGEdge have virtual destructors, the operator
+     * delete of the dynamic type is called when the TPGGraph deletes an
+     * element through a base class pointer, which returns the slot to its
+     * TPGArena. No class derives from Pooled, so the size of the slot is
+     * always the size of Pooled<T> and needs not be stored.
+     *
+     * \tparam T the TPGGraph element class.
+     */
+    template <class T> class Pooled final : public T
+    {
+      public:
+        using T::T;
+
+        /// Allocate the object in the given TPGArena.
+        static void* operator new(size_t size, TPG::TPGArena& arena)
+        {
+            static_assert(sizeof(Pooled) == sizeof(T),
+                          "Pooled should not add members to its base class.");
+            unsigned char* mem = static_cast<unsigned char*>(
+                arena.allocate(size + HEADER_SIZE));
+            new (mem) SlotHeader{&arena};
+            return mem + HEADER_SIZE;
+        }
+
+        /// Release the object memory if its constructor throws.
+        static void operator delete(void* ptr, TPG::TPGArena&)
+        {
+            release(ptr);
+        }
+
+        /// Release the object memory.
+        static void operator delete(void* ptr)
+        {
+            release(ptr);
+        }
+
+      private:
+        /// Size of the slot of an object, header included.
+        static constexpr size_t SLOT_SIZE = sizeof(T) + HEADER_SIZE;
+
+        /// Give back the slot of an object to its TPGArena.
+        static void release(void* ptr)
+        {
+            unsigned char* mem = static_cast<unsigned char*>(ptr) - HEADER_SIZE;
+            TPG::TPGArena* arena = reinterpret_cast<SlotHeader*>(mem)->arena;
+            assert(isArenaAlive(arena) &&
+                   "TPGArena destroyed before the elements allocated in it.");
+            arena->deallocate(mem, SLOT_SIZE);
+        }
+    };
+
+    /// Index of the next thread using a TPGArena.
+    std::atomic<size_t> nextThreadIndex{0};
+
+    /// Index of the TPGArena::ThreadCache of the calling thread.
+    size_t getThreadCacheIndex()
+    {
+        thread_local const size_t index =
+            nextThreadIndex++ % TPG::TPGArena::NB_THREAD_CACHES;
+        return index;
+    }
+} // namespace
+
+TPG::TPGArena::TPGArena()
+{
+#ifndef NDEBUG
+    LiveArenas& liveArenas = getLiveArenas();
+    std::lock_guard<std::mutex> lock(liveArenas.mutex);
+    liveArenas.arenas.insert(this);
+#endif // NDEBUG
+}
+
+TPG::TPGArena::~TPGArena()
+{
+    assert(this->getNbUsedSlots() == 0 &&
+           "TPGArena destroyed before the elements allocated in it.");
+#ifndef NDEBUG
+    LiveArenas& liveArenas = getLiveArenas();
+    std::lock_guard<std::mutex> lock(liveArenas.mutex);
+    liveArenas.arenas.erase(this);
+#endif // NDEBUG
+}
+
+void* TPG::TPGArena::allocate(size_t size)
+{
+    if (size == 0) {
+        size = 1;
+    }
+    if (size > MAX_SLOT_SIZE) {
+        return ::operator new(size);
+    }
+
+    size_t sizeClass = (size - 1) / SLOT_ALIGNMENT;
+
+    // Reuse the last slot freed in the cache of the thread
+    ThreadCache& threadCache = this->threadCaches[getThreadCacheIndex()];
+    std::lock_guard<std::mutex> lock(threadCache.mutex);
+    threadCache.nbUsedSlots++;
+    std::vector<void*>& cache = threadCache.freeSlots[sizeClass];
+    if (!cache.empty()) {
+        void* slot = cache.back();
+        cache.pop_back();
+        return slot;
+    }
+
+    return this->allocateFromPool(sizeClass, cache);
+}
+
+void* TPG::TPGArena::allocateFromPool(size_t sizeClass,
+                                      std::vector<void*>& cache)
+{
+    Pool& pool = this->pools[sizeClass];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+
+    // Refill the cache with the last freed slots of the pool
+    if (!pool.freeSlots.empty()) {
+        size_t nbMoved =
+            std::min(pool.freeSlots.size(), THREAD_CACHE_CAPACITY / 2);
+        cache.insert(cache.end(), pool.freeSlots.end() - nbMoved,
+                     pool.freeSlots.end());
+        pool.freeSlots.resize(pool.freeSlots.size() - nbMoved);
+        void* slot = cache.back();
+        cache.pop_back();
+        return slot;
+    }
+
+    // Take a slot from the last block, allocating a new one if needed
+    size_t slotSize = (sizeClass + 1) * SLOT_ALIGNMENT;
+    if (pool.nbUnusedInLastBlock == 0) {
+        pool.blocks.emplace_back(
+            new unsigned char[slotSize * NB_SLOTS_PER_BLOCK]);
+        pool.nbUnusedInLastBlock = NB_SLOTS_PER_BLOCK;
+    }
+    pool.nbUnusedInLastBlock--;
+    return pool.blocks.back().get() +
+           (NB_SLOTS_PER_BLOCK - pool.nbUnusedInLastBlock - 1) * slotSize;
+}
+
+void TPG::TPGArena::deallocate(void* ptr, size_t size)
+{
+    if (size == 0) {
+        size = 1;
+    }
+    if (size > MAX_SLOT_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    size_t sizeClass = (size - 1) / SLOT_ALIGNMENT;
+
+    ThreadCache& threadCache = this->threadCaches[getThreadCacheIndex()];
+    std::lock_guard<std::mutex> lock(threadCache.mutex);
+    threadCache.nbUsedSlots--;
+    std::vector<void*>& cache = threadCache.freeSlots[sizeClass];
+
+    // Give the oldest half of a full cache back to the pool
+    if (cache.size() >= THREAD_CACHE_CAPACITY) {
+        Pool& pool = this->pools[sizeClass];
+        std::lock_guard<std::mutex> poolLock(pool.mutex);
+        size_t nbMoved = THREAD_CACHE_CAPACITY / 2;
+        pool.freeSlots.insert(pool.freeSlots.end(), cache.begin(),
+                              cache.begin() + nbMoved);
+        cache.erase(cache.begin(), cache.begin() + nbMoved);
+    }
+    cache.push_back(ptr);
+}
+
+size_t TPG::TPGArena::getNbUsedSlots() const
+{
+    int64_t result = 0;
+    for (const ThreadCache& threadCache : this->threadCaches) {
+        std::lock_guard<std::mutex> lock(threadCache.mutex);
+        result += threadCache.nbUsedSlots;
+    }
+    return (size_t)result;
+}
+
+size_t TPG::TPGArena::getNbFreeSlots() const
+{
+    size_t result = 0;
+    for (const Pool& pool : this->pools) {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        result += pool.freeSlots.size();
+    }
+    for (const ThreadCache& threadCache : this->threadCaches) {
+        std::lock_guard<std::mutex> lock(threadCache.mutex);
+        for (const std::vector<void*>& cache : threadCache.freeSlots) {
+            result += cache.size();
+        }
+    }
+    return result;
+}
+
+size_t TPG::TPGArena::getNbBlocks() const
+{
+    size_t result = 0;
+    for (const Pool& pool : this->pools) {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        result += pool.blocks.size();
+    }
+    return result;
+}
+
+TPG::TPGArenaFactory::TPGArenaFactory()
+    : arena{std::make_shared<TPG::TPGArena>()}
+{
+}
+
+TPG::TPGArenaFactory::TPGArenaFactory(std::shared_ptr<TPGArena> arena)
+    : arena{std::move(arena)}
+{
+}
+
+std::shared_ptr<TPG::TPGGraph> TPG::TPGArenaFactory::createTPGGraph(
+    const Environment& env) const
+{
+    return std::make_shared<TPG::TPGGraph>(
+        env, std::make_unique<TPGArenaFactory>(this->arena));
+}
+
+TPG::TPGTeam* TPG::TPGArenaFactory::createTPGTeam() const
+{
+    return new (*this->arena) Pooled<TPG::TPGTeam>();
+}
+
+TPG::TPGAction* TPG::TPGArenaFactory::createTPGAction(const uint64_t id) const
+{
+    return new (*this->arena) Pooled<TPG::TPGAction>(id);
+}
+
+std::unique_ptr<TPG::TPGEdge> TPG::TPGArenaFactory::createTPGEdge(
+    const TPGVertex* src, const TPGVertex* dest,
+    const std::shared_ptr<Program::Program> prog) const
+{
+    return std::unique_ptr<TPG::TPGEdge>(
+        new (*this->arena) Pooled<TPG::TPGEdge>(src, dest, prog));
+}
+
+std::shared_ptr<Program::Program> TPG::TPGArenaFactory::createProgram(
+    const Environment& env) const
+{
+    return std::allocate_shared<Program::Program>(
+        TPGArenaAllocator<Program::Program>(this->arena), env);
+}
+
+std::shared_ptr<Program::Program> TPG::TPGArenaFactory::createProgram(
+    const Program::Program& other) const
+{
+    return std::allocate_shared<Program::Program>(
+        TPGArenaAllocator<Program::Program>(this->arena), other);
+}
+
+const std::shared_ptr<TPG::TPGArena>& TPG::TPGArenaFactory::getArena() const
+{
+    return this->arena;
+}
@@ -51,6 +51,19 @@ std::shared_ptr<Program::Program> TPG::TPGEdge::getProgramSharedPointer()
     return this->program;
 }
 
+std::weak_ptr<const Program::Program> TPG::TPGEdge::getProgramWeakPointer()
+    const
+{
+    return this->program;
+}
+
+bool TPG::TPGEdge::hasProgram(
+    const std::weak_ptr<const Program::Program>& prog) const
+{
+    return !prog.owner_before(this->program) &&
+           !this->program.owner_before(prog);
+}
+
 const TPG::TPGVertex* TPG::TPGEdge::getSource() const
 {
     return this->source;
@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <set>
+#include <stdexcept>
 #include <vector>
 
 #include "program/programExecutionEngine.h"
@@ -48,20 +49,83 @@ void TPG::TPGExecutionEngine::setArchive(Archive* newArchive)
     this->archive = newArchive;
 }
 
+void TPG::TPGExecutionEngine::setBidCacheEnabled(bool enabled)
+{
+    this->bidCacheEnabled = enabled;
+    this->bidCache.clear();
+}
+
+bool TPG::TPGExecutionEngine::isBidCacheEnabled() const
+{
+    return this->bidCacheEnabled;
+}
+
+void TPG::TPGExecutionEngine::clearBidCache()
+{
+    this->bidCache.clear();
+}
+
+void TPG::TPGExecutionEngine::setLaneEvaluationEnabled(bool enabled)
+{
+    this->laneEvaluationEnabled = enabled;
+    this->clearLaneEvaluators();
+}
+
+bool TPG::TPGExecutionEngine::isLaneEvaluationEnabled() const
+{
+    return this->laneEvaluationEnabled;
+}
+
+void TPG::TPGExecutionEngine::clearLaneEvaluators()
+{
+    this->laneEvaluators.clear();
+    this->laneEvaluatorsSweepSize = MIN_LANE_EVALUATORS_SWEEP_SIZE;
+}
+
+void TPG::TPGExecutionEngine::sweepLaneEvaluators()
+{
+    for (auto iter = this->laneEvaluators.begin();
+         iter != this->laneEvaluators.end();) {
+        if (iter->second.used) {
+            iter->second.used = false;
+            iter++;
+        }
+        else {
+            iter = this->laneEvaluators.erase(iter);
+        }
+    }
+    this->laneEvaluatorsSweepSize = std::max(
+        MIN_LANE_EVALUATORS_SWEEP_SIZE, 2 * this->laneEvaluators.size());
+}
+
 double TPG::TPGExecutionEngine::evaluateEdge(const TPGEdge& edge)
 {
     // Get the program
     Program::Program& prog = edge.getProgram();
 
-    // Set the progExecutionEngine to the program
-    this->progExecutionEngine.setProgram(prog);
+    double result;
+    auto iterCache = (this->bidCacheEnabled) ? this->bidCache.find(&prog)
+                                             : this->bidCache.end();
+    if (iterCache != this->bidCache.end()) {
+        // Reuse the result of a previous execution
+        result = iterCache->second;
+    }
+    else {
+        // Set the progExecutionEngine to the program
+        this->progExecutionEngine.setProgram(prog);
+
+        // Execute the program.
+        result = this->progExecutionEngine.executeProgram();
 
-    // Execute the program.
-    double result = this->progExecutionEngine.executeProgram();
+        // Filter NaN results: replace with -inf
+        result = (std::isnan(result))
+                     ? -std::numeric_limits<double>::infinity()
+                     : result;
 
-    // Filter NaN results: replace with -inf
-    result = (std::isnan(result)) ? -std::numeric_limits<double>::infinity()
-                                  : result;
+        if (this->bidCacheEnabled) {
+            this->bidCache.emplace(&prog, result);
+        }
+    }
 
     // Put the result in the archive before returning it.
     if (this->archive != NULL) {
@@ -72,9 +136,82 @@ double TPG::TPGExecutionEngine::evaluateEdge(const TPGEdge& edge)
     return result;
 }
 
+size_t TPG::TPGExecutionEngine::getBestBidIndex(
+    const std::vector<double>& bids)
+{
+    size_t bestIdx = 0;
+    for (size_t idx = 1; idx < bids.size(); idx++) {
+        if (bids[idx] >= bids[bestIdx]) {
+            bestIdx = idx;
+        }
+    }
+    return bestIdx;
+}
+
+void TPG::TPGExecutionEngine::evaluateTeamBids(const TPGTeam& team,
+                                               std::vector<double>& bids)
+{
+    const std::list<TPG::TPGEdge*>& outgoingEdges = team.getOutgoingEdges();
+
+    bids.resize(outgoingEdges.size());
+
+    if (this->laneEvaluationEnabled && !this->bidCacheEnabled) {
+        // Discard LaneEvaluator of teams no longer evaluated
+        if (this->laneEvaluators.size() >= this->laneEvaluatorsSweepSize &&
+            this->laneEvaluators.count(&team) == 0) {
+            this->sweepLaneEvaluators();
+        }
+
+        // Get the LaneEvaluator of the team, rebuilt if its programs changed
+        TeamLaneEvaluator& teamEvaluator = this->laneEvaluators[&team];
+        bool upToDate = teamEvaluator.evaluator != nullptr &&
+                        teamEvaluator.programs.size() == outgoingEdges.size();
+        auto weakProgram = teamEvaluator.programs.begin();
+        for (auto edge = outgoingEdges.begin();
+             upToDate && edge != outgoingEdges.end(); edge++) {
+            upToDate = (*edge)->hasProgram(*weakProgram++);
+        }
+        if (!upToDate) {
+            std::vector<const Program::Program*> programs;
+            teamEvaluator.programs.clear();
+            for (const TPGEdge* edge : outgoingEdges) {
+                programs.push_back(&edge->getProgram());
+                teamEvaluator.programs.push_back(
+                    edge->getProgramWeakPointer());
+            }
+            teamEvaluator.evaluator =
+                std::make_unique<Program::LaneEvaluator>(programs);
+        }
+        teamEvaluator.used = true;
+
+        if (teamEvaluator.evaluator->isEvaluable()) {
+            const auto& dataSources =
+                this->progExecutionEngine.getDataSources();
+            teamEvaluator.evaluator->evaluate(dataSources, bids.data());
+            size_t idx = 0;
+            for (const TPGEdge* edge : outgoingEdges) {
+                // Filter NaN results: replace with -inf
+                double& result = bids[idx++];
+                result = (std::isnan(result))
+                             ? -std::numeric_limits<double>::infinity()
+                             : result;
+                if (this->archive != NULL) {
+                    this->archive->addRecording(&edge->getProgram(),
+                                                dataSources, result);
+                }
+            }
+            return;
+        }
+    }
+
+    size_t idx = 0;
+    for (const TPGEdge* edge : outgoingEdges) {
+        bids[idx++] = this->evaluateEdge(*edge);
+    }
+}
+
 const TPG::TPGEdge& TPG::TPGExecutionEngine::evaluateTeam(const TPGTeam& team)
 {
-    // Copy outgoing edge list
     const std::list<TPG::TPGEdge*>& outgoingEdges = team.getOutgoingEdges();
 
     // Note: No need to exclude previously visited edges as the graph is now
@@ -84,36 +221,23 @@ const TPG::TPGEdge& TPG::TPGExecutionEngine::evaluateTeam(const TPGTeam& team)
     std::cout << "New team :" << &team << std::endl;
 #endif
 
+    if (outgoingEdges.empty()) {
+        throw std::runtime_error("Evaluated TPGTeam has no outgoing edge.");
+    }
+
     // Evaluate all TPGEdge
-    // First
-    TPGEdge* bestEdge = *outgoingEdges.begin();
-    double bestBid = this->evaluateEdge(*bestEdge);
-#ifdef DEBUG
-    std::cout << "R = " << bestBid << "*" << std::endl;
-#endif
-    // Others
-    for (auto iter = ++outgoingEdges.begin(); iter != outgoingEdges.end();
-         iter++) {
-        TPGEdge* edge = *iter;
-        double bid = this->evaluateEdge(*edge);
-#ifdef DEBUG
-        std::cout << "R = " << bid;
-#endif
-        if (bid >= bestBid) {
-#ifdef DEBUG
-            std::cout << "*" << std::endl;
-#endif
-            bestEdge = edge;
-            bestBid = bid;
-        }
-        else {
+    this->evaluateTeamBids(team, this->bids);
+
+    // Select the best one
+    size_t bestIdx = getBestBidIndex(this->bids);
 #ifdef DEBUG
-            std::cout << std::endl;
-#endif
-        }
+    for (size_t idx = 0; idx < this->bids.size(); idx++) {
+        std::cout << "R = " << this->bids[idx]
+                  << ((idx == bestIdx) ? "*" : "") << std::endl;
     }
+#endif
 
-    return *bestEdge;
+    return **std::next(outgoingEdges.begin(), bestIdx);
 }
 
 const std::vector<const TPG::TPGVertex*> TPG::TPGExecutionEngine::
@@ -121,6 +245,9 @@ const std::vector<const TPG::TPGVertex*> TPG::TPGExecutionEngine::
 {
     const TPGVertex* currentVertex = &root;
 
+    // Cached results are only valid within an inference.
+    this->bidCache.clear();
+
     std::vector<const TPGVertex*> visitedVertices;
     visitedVertices.push_back(currentVertex);
 
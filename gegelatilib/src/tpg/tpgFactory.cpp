@@ -61,6 +61,18 @@ std::unique_ptr<TPG::TPGEdge> TPG::TPGFactory::createTPGEdge(
     return std::make_unique<TPG::TPGEdge>(src, dest, prog);
 }
 
+std::shared_ptr<Program::Program> TPG::TPGFactory::createProgram(
+    const Environment& env) const
+{
+    return std::make_shared<Program::Program>(env);
+}
+
+std::shared_ptr<Program::Program> TPG::TPGFactory::createProgram(
+    const Program::Program& other) const
+{
+    return std::make_shared<Program::Program>(other);
+}
+
 std::unique_ptr<TPG::TPGExecutionEngine> TPG::TPGFactory::
     createTPGExecutionEngine(const Environment& env, Archive* arch) const
 {
@@ -74,15 +74,36 @@ const TPG::TPGFactory& TPG::TPGGraph::getFactory() const
     return *this->factory;
 }
 
+void TPG::TPGGraph::addVertex(TPGVertex* vertex)
+{
+    this->vertices.push_back(vertex);
+    uint64_t order = this->nextVertexOrder++;
+    this->vertexIndex.emplace(vertex,
+                              VertexPosition{--this->vertices.end(), order});
+    // A new vertex has no incoming edge.
+    this->rootVertices.emplace_hint(this->rootVertices.end(), order, vertex);
+}
+
+void TPG::TPGGraph::updateRootStatus(const TPGVertex* vertex)
+{
+    uint64_t order = this->vertexIndex.at(vertex).order;
+    if (vertex->getIncomingEdges().size() == 0) {
+        this->rootVertices.emplace(order, vertex);
+    }
+    else {
+        this->rootVertices.erase(order);
+    }
+}
+
 const TPG::TPGTeam& TPG::TPGGraph::addNewTeam()
 {
-    this->vertices.push_back(factory->createTPGTeam());
+    this->addVertex(factory->createTPGTeam());
     return (const TPGTeam&)(*this->vertices.back());
 }
 
 const TPG::TPGAction& TPG::TPGGraph::addNewAction(uint64_t actionID)
 {
-    this->vertices.push_back(factory->createTPGAction(actionID));
+    this->addVertex(factory->createTPGAction(actionID));
     return (const TPGAction&)(*this->vertices.back());
 }
 
@@ -100,26 +121,22 @@ const std::vector<const TPG::TPGVertex*> TPG::TPGGraph::getVertices() const
 
 uint64_t TPG::TPGGraph::getNbRootVertices() const
 {
-    return std::count_if(this->vertices.begin(), this->vertices.end(),
-                         [](const TPGVertex* vertex) {
-                             return vertex->getIncomingEdges().size() == 0;
-                         });
+    return this->rootVertices.size();
 }
 
 const std::vector<const TPG::TPGVertex*> TPG::TPGGraph::getRootVertices() const
 {
     std::vector<const TPG::TPGVertex*> result;
-    std::copy_if(this->vertices.begin(), this->vertices.end(),
-                 std::back_inserter(result), [](TPGVertex* vertex) {
-                     return vertex->getIncomingEdges().size() == 0;
-                 });
+    result.reserve(this->rootVertices.size());
+    for (const auto& orderAndVertex : this->rootVertices) {
+        result.push_back(orderAndVertex.second);
+    }
     return result;
 }
 
 bool TPG::TPGGraph::hasVertex(const TPG::TPGVertex& vertex) const
 {
-    return std::find(this->vertices.cbegin(), this->vertices.cend(), &vertex) !=
-           this->vertices.cend();
+    return this->vertexIndex.count(&vertex) != 0;
 }
 
 void TPG::TPGGraph::removeVertex(const TPGVertex& vertex)
@@ -139,6 +156,10 @@ void TPG::TPGGraph::removeVertex(const TPGVertex& vertex)
         for (auto outEdge : outEdgesToRemove) {
             this->removeEdge(*outEdge);
         }
+        // Remove the vertex from the indexes
+        auto iterIndex = this->vertexIndex.find(&vertex);
+        this->rootVertices.erase(iterIndex->second.order);
+        this->vertexIndex.erase(iterIndex);
         // Free the memory of the vertex
         delete *iterator;
         // Remove the pointer from the list.
@@ -181,12 +202,8 @@ const TPG::TPGEdge& TPG::TPGGraph::addNewEdge(
     const std::shared_ptr<Program::Program> prog)
 {
     // Check the TPGVertex existence within the graph.
-    auto srcVertex =
-        std::find_if(this->vertices.begin(), this->vertices.end(),
-                     [&src](TPG::TPGVertex* other) { return other == &src; });
-    auto dstVertex =
-        std::find_if(this->vertices.begin(), this->vertices.end(),
-                     [&dest](TPG::TPGVertex* other) { return other == &dest; });
+    auto srcVertex = this->findVertex(&src);
+    auto dstVertex = this->findVertex(&dest);
     if (dstVertex == this->vertices.end() ||
         srcVertex == this->vertices.end()) {
         throw std::runtime_error("Attempting to add a TPGEdge between vertices "
@@ -208,6 +225,8 @@ const TPG::TPGEdge& TPG::TPGGraph::addNewEdge(
         throw e;
     }
     (*dstVertex)->addIncomingEdge(&newEdge);
+    this->updateRootStatus(*dstVertex);
+    this->edgeIndex.emplace(&newEdge, --this->edges.end());
 
     // return the new edge
     return newEdge;
@@ -221,10 +240,7 @@ const std::list<std::unique_ptr<TPG::TPGEdge>>& TPG::TPGGraph::getEdges() const
 void TPG::TPGGraph::removeEdge(const TPGEdge& edge)
 {
     // Get the edge (if it is in the graph)
-    auto iterator = std::find_if(this->edges.begin(), this->edges.end(),
-                                 [&edge](std::unique_ptr<TPG::TPGEdge>& other) {
-                                     return &edge == other.get();
-                                 });
+    auto iterator = this->findEdge(&edge);
 
     // Disconnect the edge from the vertices
     if (iterator == this->edges.end()) {
@@ -236,7 +252,9 @@ void TPG::TPGGraph::removeEdge(const TPGEdge& edge)
         ->removeOutgoingEdge(iterator->get());
     (*this->findVertex(iterator->get()->getDestination()))
         ->removeIncomingEdge(iterator->get());
+    this->updateRootStatus(iterator->get()->getDestination());
     // Remove the edge
+    this->edgeIndex.erase(&edge);
     this->edges.erase(iterator);
 }
 
@@ -270,8 +288,10 @@ bool TPG::TPGGraph::setEdgeDestination(const TPGEdge& edge,
         // next line would be well deserved since it means an edge in the
         // graph is connected to a vertex not in the graph.
         (*iterOldDest)->removeIncomingEdge(iterEdge->get());
+        this->updateRootStatus(oldDestination);
         // Register the edge to the new destination
         (*iterNewDestination)->addIncomingEdge(iterEdge->get());
+        this->updateRootStatus(&newDest);
         // Set the destination
         iterEdge->get()->setDestination(*iterNewDestination);
         return true;
@@ -308,16 +328,17 @@ bool TPG::TPGGraph::setEdgeSource(const TPGEdge& edge, const TPGVertex& newSrc)
 std::list<TPG::TPGVertex*>::iterator TPG::TPGGraph::findVertex(
     const TPG::TPGVertex* vertex)
 {
-    return std::find(this->vertices.begin(), this->vertices.end(), vertex);
+    auto iterIndex = this->vertexIndex.find(vertex);
+    return (iterIndex != this->vertexIndex.end()) ? iterIndex->second.iterator
+                                                  : this->vertices.end();
 }
 
 std::list<std::unique_ptr<TPG::TPGEdge>>::iterator TPG::TPGGraph::findEdge(
     const TPGEdge* edge)
 {
-    return std::find_if(this->edges.begin(), this->edges.end(),
-                        [&edge](std::unique_ptr<TPG::TPGEdge>& other) {
-                            return other.get() == edge;
-                        });
+    auto iterIndex = this->edgeIndex.find(edge);
+    return (iterIndex != this->edgeIndex.end()) ? iterIndex->second
+                                                : this->edges.end();
 }
 
 void TPG::TPGGraph::clearProgramIntrons()
@@ -0,0 +1,131 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+
+#include "tpg/tpgAction.h"
+#include "tpg/tpgEdge.h"
+#include "tpg/tpgTeam.h"
+
+#include "tpg/tpgGraphSnapshot.h"
+
+TPG::TPGGraphSnapshot::TPGGraphSnapshot(const TPGGraph& graph)
+    : env{graph.getEnvironment()}
+{
+    const std::vector<const TPGVertex*> graphVertices = graph.getVertices();
+
+    // Index all vertices first, to resolve edge destinations.
+    this->graphVertices = graphVertices;
+    this->vertexIndexes.reserve(graphVertices.size());
+    for (uint64_t idx = 0; idx < graphVertices.size(); idx++) {
+        this->vertexIndexes.emplace(graphVertices[idx], idx);
+    }
+
+    // Flatten vertices and their outgoing edges.
+    std::unordered_map<const Program::Program*, uint64_t> programIndexes;
+    this->vertices.reserve(graphVertices.size());
+    this->edges.reserve(graph.getEdges().size());
+    for (const TPGVertex* vertex : graphVertices) {
+        const TPGAction* action = dynamic_cast<const TPGAction*>(vertex);
+        Vertex flatVertex{action != nullptr,
+                          (action != nullptr) ? action->getActionID() : 0,
+                          this->edges.size(),
+                          vertex->getOutgoingEdges().size()};
+        this->vertices.push_back(flatVertex);
+
+        for (TPGEdge* edge : vertex->getOutgoingEdges()) {
+            std::shared_ptr<Program::Program> prog =
+                edge->getProgramSharedPointer();
+            auto iterProgram = programIndexes.find(prog.get());
+            if (iterProgram == programIndexes.end()) {
+                iterProgram =
+                    programIndexes.emplace(prog.get(), this->programs.size())
+                        .first;
+                this->programs.push_back(prog);
+            }
+            this->edges.push_back(
+                {iterProgram->second,
+                 this->vertexIndexes.at(edge->getDestination())});
+        }
+    }
+
+    // Compile programs once their storage is stable.
+    this->compiledPrograms.reserve(this->programs.size());
+    for (const std::shared_ptr<Program::Program>& prog : this->programs) {
+        this->compiledPrograms.emplace_back(*prog);
+    }
+
+    // Roots
+    for (const TPGVertex* root : graph.getRootVertices()) {
+        this->roots.push_back(this->vertexIndexes.at(root));
+    }
+}
+
+const Environment& TPG::TPGGraphSnapshot::getEnvironment() const
+{
+    return this->env;
+}
+
+const std::vector<TPG::TPGGraphSnapshot::Vertex>& TPG::TPGGraphSnapshot::
+    getVertices() const
+{
+    return this->vertices;
+}
+
+const std::vector<TPG::TPGGraphSnapshot::Edge>& TPG::TPGGraphSnapshot::
+    getEdges() const
+{
+    return this->edges;
+}
+
+const std::vector<uint64_t>& TPG::TPGGraphSnapshot::getRoots() const
+{
+    return this->roots;
+}
+
+const std::vector<Program::CompiledProgram>& TPG::TPGGraphSnapshot::
+    getCompiledPrograms() const
+{
+    return this->compiledPrograms;
+}
+
+const TPG::TPGVertex* TPG::TPGGraphSnapshot::getGraphVertex(
+    uint64_t index) const
+{
+    return this->graphVertices.at(index);
+}
+
+uint64_t TPG::TPGGraphSnapshot::getVertexIndex(const TPGVertex& vertex) const
+{
+    return this->vertexIndexes.at(&vertex);
+}
@@ -0,0 +1,248 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "tpg/tpgSnapshotExecutionEngine.h"
+
+void TPG::TPGSnapshotExecutionEngine::setArchive(Archive* newArchive)
+{
+    this->archive = newArchive;
+}
+
+void TPG::TPGSnapshotExecutionEngine::setTemporalBidCacheEnabled(
+    bool enabled)
+{
+    this->temporalBidCacheEnabled = enabled;
+    this->temporalBids.clear();
+    if (enabled) {
+        this->temporalBids.resize(this->snapshot.getCompiledPrograms().size());
+    }
+}
+
+bool TPG::TPGSnapshotExecutionEngine::isTemporalBidCacheEnabled() const
+{
+    return this->temporalBidCacheEnabled;
+}
+
+void TPG::TPGSnapshotExecutionEngine::clearTemporalBidCache()
+{
+    for (TemporalBid& entry : this->temporalBids) {
+        entry.valid = false;
+    }
+}
+
+void TPG::TPGSnapshotExecutionEngine::setNativeProgramsEnabled(bool enabled)
+{
+    this->nativeProgramsEnabled = enabled;
+    this->nativePrograms.clear();
+    if (enabled) {
+        const auto& compiledPrograms = this->snapshot.getCompiledPrograms();
+        this->nativePrograms.reserve(compiledPrograms.size());
+        for (const Program::CompiledProgram& compiled : compiledPrograms) {
+            this->nativePrograms.emplace_back(
+                std::make_unique<Program::NativeProgram>(compiled));
+        }
+    }
+}
+
+bool TPG::TPGSnapshotExecutionEngine::isNativeProgramsEnabled() const
+{
+    return this->nativeProgramsEnabled;
+}
+
+void TPG::TPGSnapshotExecutionEngine::computeDataDependencies(
+    TemporalBid& entry, const Program::CompiledProgram& compiled) const
+{
+    const auto& dataSources = this->progExecutionEngine.getDataSources();
+
+    // Gather the native addresses read by each operand fetched from the
+    // environment data sources. Registers are reset for each execution and
+    // constants are part of the immutable Program.
+    std::vector<std::vector<size_t>> addresses(dataSources.size());
+    for (const Program::CompiledProgram::CompiledOperand& operand :
+         compiled.getOperands()) {
+        if (operand.dataSourceIndex < this->envDataSourceOffset) {
+            continue;
+        }
+        uint64_t dataSourceIndex =
+            operand.dataSourceIndex - this->envDataSourceOffset;
+        std::vector<size_t> accessed =
+            dataSources.at(dataSourceIndex)
+                .get()
+                .getAddressesAccessed(*operand.type, operand.location);
+        addresses[dataSourceIndex].insert(addresses[dataSourceIndex].end(),
+                                          accessed.begin(), accessed.end());
+    }
+
+    entry.dependencies.clear();
+    for (uint64_t idx = 0; idx < addresses.size(); idx++) {
+        if (addresses[idx].empty()) {
+            continue;
+        }
+        std::sort(addresses[idx].begin(), addresses[idx].end());
+        addresses[idx].erase(
+            std::unique(addresses[idx].begin(), addresses[idx].end()),
+            addresses[idx].end());
+        entry.dependencies.push_back({idx, std::move(addresses[idx])});
+    }
+    entry.versions.resize(entry.dependencies.size());
+    entry.dependenciesComputed = true;
+}
+
+bool TPG::TPGSnapshotExecutionEngine::isTemporalBidReusable(
+    const TemporalBid& entry) const
+{
+    if (!entry.valid) {
+        return false;
+    }
+
+    const auto& dataSources = this->progExecutionEngine.getDataSources();
+    for (size_t idx = 0; idx < entry.dependencies.size(); idx++) {
+        const DataDependency& dependency = entry.dependencies[idx];
+        if (dataSources[dependency.dataSourceIndex].get().isModifiedSince(
+                dependency.addresses, entry.versions[idx])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+double TPG::TPGSnapshotExecutionEngine::evaluateEdge(uint64_t edgeIndex)
+{
+    const uint64_t programIndex =
+        this->snapshot.getEdges()[edgeIndex].programIndex;
+    const Program::CompiledProgram& compiled =
+        this->snapshot.getCompiledPrograms()[programIndex];
+
+    double result;
+    if (this->temporalBidCacheEnabled &&
+        this->isTemporalBidReusable(this->temporalBids[programIndex])) {
+        // Reuse the bid of the previous execution.
+        result = this->temporalBids[programIndex].bid;
+    }
+    else {
+        // Execute the program.
+        result = (this->nativeProgramsEnabled)
+                     ? this->progExecutionEngine.executeNativeProgram(
+                           *this->nativePrograms[programIndex])
+                     : this->progExecutionEngine.executeCompiledProgram(
+                           compiled);
+
+        // Filter NaN results: replace with -inf
+        result = (std::isnan(result))
+                     ? -std::numeric_limits<double>::infinity()
+                     : result;
+
+        if (this->temporalBidCacheEnabled) {
+            // Store the bid with the current version of its dependencies.
+            TemporalBid& entry = this->temporalBids[programIndex];
+            if (!entry.dependenciesComputed) {
+                this->computeDataDependencies(entry, compiled);
+            }
+            const auto& dataSources =
+                this->progExecutionEngine.getDataSources();
+            for (size_t idx = 0; idx < entry.dependencies.size(); idx++) {
+                entry.versions[idx] =
+                    dataSources[entry.dependencies[idx].dataSourceIndex]
+                        .get()
+                        .getModificationVersion();
+            }
+            entry.bid = result;
+            entry.valid = true;
+        }
+    }
+
+    // Put the result in the archive before returning it.
+    if (this->archive != NULL) {
+        this->archive->addRecording(&compiled.getProgram(),
+                                    progExecutionEngine.getDataSources(),
+                                    result);
+    }
+
+    return result;
+}
+
+uint64_t TPG::TPGSnapshotExecutionEngine::evaluateTeam(uint64_t vertexIndex)
+{
+    const TPGGraphSnapshot::Vertex& team =
+        this->snapshot.getVertices()[vertexIndex];
+    if (team.nbEdges == 0) {
+        throw std::runtime_error("Evaluated team has no outgoing edge.");
+    }
+
+    // Evaluate all edges, keeping the last best bid.
+    uint64_t bestEdge = team.firstEdge;
+    double bestBid = this->evaluateEdge(bestEdge);
+    for (uint64_t edgeIndex = team.firstEdge + 1;
+         edgeIndex < team.firstEdge + team.nbEdges; edgeIndex++) {
+        double bid = this->evaluateEdge(edgeIndex);
+        if (bid >= bestBid) {
+            bestEdge = edgeIndex;
+            bestBid = bid;
+        }
+    }
+
+    return bestEdge;
+}
+
+const std::vector<uint64_t>& TPG::TPGSnapshotExecutionEngine::executeFromRoot(
+    uint64_t vertexIndex)
+{
+    const std::vector<TPGGraphSnapshot::Vertex>& vertices =
+        this->snapshot.getVertices();
+
+    this->trace.clear();
+    this->trace.push_back(vertexIndex);
+
+    // Browse the snapshot until an action is reached.
+    while (!vertices.at(vertexIndex).isAction) {
+        uint64_t edgeIndex = this->evaluateTeam(vertexIndex);
+        vertexIndex = this->snapshot.getEdges()[edgeIndex].destination;
+        this->trace.push_back(vertexIndex);
+    }
+
+    return this->trace;
+}
+
+uint64_t TPG::TPGSnapshotExecutionEngine::executeActionFromRoot(
+    uint64_t vertexIndex)
+{
+    return this->snapshot.getVertices()
+        .at(this->executeFromRoot(vertexIndex).back())
+        .actionID;
+}
@@ -0,0 +1,190 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include "util/threadPool.h"
+
+Util::ThreadPool::ThreadPool(uint64_t nbThreads)
+    : nbThreads{(nbThreads > 0) ? nbThreads : 1}, task{nullptr},
+      batchCounter{0}, nbActiveWorkers{0}, stopWorkers{false}
+{
+    for (uint64_t idx = 0; idx < this->nbThreads; idx++) {
+        this->queues.emplace_back(new JobQueue());
+    }
+
+    // Thread 0 is the calling thread.
+    for (uint64_t idx = 1; idx < this->nbThreads; idx++) {
+        this->workers.emplace_back(&ThreadPool::workerLoop, this, idx);
+    }
+}
+
+Util::ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->batchMutex);
+        this->stopWorkers = true;
+    }
+    this->batchStart.notify_all();
+
+    for (std::thread& worker : this->workers) {
+        worker.join();
+    }
+}
+
+uint64_t Util::ThreadPool::getNbThreads() const
+{
+    return this->nbThreads;
+}
+
+bool Util::ThreadPool::popJob(uint64_t threadIdx, uint64_t& jobIdx)
+{
+    // Own queue first, from the front.
+    {
+        JobQueue& own = *this->queues[threadIdx];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            jobIdx = own.jobs.front();
+            own.jobs.pop_front();
+            return true;
+        }
+    }
+
+    // Steal from other queues, from the back.
+    for (uint64_t offset = 1; offset < this->nbThreads; offset++) {
+        JobQueue& other =
+            *this->queues[(threadIdx + offset) % this->nbThreads];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.jobs.empty()) {
+            jobIdx = other.jobs.back();
+            other.jobs.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Util::ThreadPool::processJobs(uint64_t threadIdx)
+{
+    uint64_t jobIdx;
+    while (this->popJob(threadIdx, jobIdx)) {
+        try {
+            (*this->task)(jobIdx, threadIdx);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(this->batchMutex);
+            if (!this->exception) {
+                this->exception = std::current_exception();
+            }
+        }
+    }
+}
+
+void Util::ThreadPool::workerLoop(uint64_t threadIdx)
+{
+    uint64_t lastBatch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->batchMutex);
+            this->batchStart.wait(lock, [this, lastBatch] {
+                return this->stopWorkers || this->batchCounter != lastBatch;
+            });
+            if (this->stopWorkers) {
+                return;
+            }
+            lastBatch = this->batchCounter;
+        }
+
+        this->processJobs(threadIdx);
+
+        {
+            std::lock_guard<std::mutex> lock(this->batchMutex);
+            this->nbActiveWorkers--;
+            if (this->nbActiveWorkers == 0) {
+                this->batchEnd.notify_one();
+            }
+        }
+    }
+}
+
+void Util::ThreadPool::parallelFor(uint64_t nbJobs, const Task& task)
+{
+    if (nbJobs == 0) {
+        return;
+    }
+
+    // Sequential execution
+    if (this->nbThreads == 1 || nbJobs == 1) {
+        for (uint64_t jobIdx = 0; jobIdx < nbJobs; jobIdx++) {
+            task(jobIdx, 0);
+        }
+        return;
+    }
+
+    // Distribute jobs by contiguous blocks among thread queues.
+    for (uint64_t threadIdx = 0; threadIdx < this->nbThreads; threadIdx++) {
+        JobQueue& queue = *this->queues[threadIdx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (uint64_t jobIdx = threadIdx * nbJobs / this->nbThreads;
+             jobIdx < (threadIdx + 1) * nbJobs / this->nbThreads; jobIdx++) {
+            queue.jobs.push_back(jobIdx);
+        }
+    }
+
+    // Start the batch
+    {
+        std::lock_guard<std::mutex> lock(this->batchMutex);
+        this->task = &task;
+        this->exception = nullptr;
+        this->nbActiveWorkers = this->workers.size();
+        this->batchCounter++;
+    }
+    this->batchStart.notify_all();
+
+    // Work in the calling thread also
+    this->processJobs(0);
+
+    // Wait for the workers
+    std::exception_ptr batchException;
+    {
+        std::unique_lock<std::mutex> lock(this->batchMutex);
+        this->batchEnd.wait(lock,
+                            [this] { return this->nbActiveWorkers == 0; });
+        this->task = nullptr;
+        batchException = this->exception;
+        this->exception = nullptr;
+    }
+
+    if (batchException) {
+        std::rethrow_exception(batchException);
+    }
+}
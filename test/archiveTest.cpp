@@ -35,6 +35,7 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <cmath>
 #include <gtest/gtest.h>
 
 #include "data/dataHandler.h"
@@ -164,6 +165,35 @@ TEST_F(ArchiveTest, AddRecordingTests)
         << "Number or dataHandlers copied in the archive is incorrect.";
 }
 
+TEST_F(ArchiveTest, AddRecordingDataHandlersReferenceCount)
+{
+    Archive archive(100, 1.0);
+    Data::PrimitiveTypeArray<int>& d =
+        (Data::PrimitiveTypeArray<int>&)vect.at(1).get();
+
+    // Cycle on 10 different data, several times the Archive size.
+    for (auto i = 0; i < 500; i++) {
+        d.setDataAt(typeid(int), 2, i % 10);
+        archive.addRecording(p, vect, (double)i);
+    }
+    ASSERT_EQ(archive.getNbRecordings(), 100)
+        << "Number or recordings in the archive is incorrect.";
+    ASSERT_EQ(archive.getNbDataHandlers(), 10)
+        << "Number or dataHandlers copied in the archive is incorrect.";
+
+    // New data for each recording, evicting all previous DataHandler copies.
+    for (auto i = 0; i < 100; i++) {
+        d.setDataAt(typeid(int), 2, 1000 + i);
+        archive.addRecording(p, vect, (double)i);
+    }
+    ASSERT_EQ(archive.getNbDataHandlers(), 100)
+        << "Number or dataHandlers copied in the archive is incorrect.";
+    for (auto i = 0; i < 100; i++) {
+        ASSERT_TRUE(archive.hasDataHandlers(archive.at(i).dataHash))
+            << "DataHandler of a recording is missing from the archive.";
+    }
+}
+
 TEST_F(ArchiveTest, AddRecordingWithProbabilityTests)
 {
     // For these test, force archivingProbability to 0.5
@@ -271,6 +301,70 @@ TEST_F(ArchiveTest, areProgramResultsUnique)
         << "Within margin fake program bidding behavior not detected as such.";
 }
 
+TEST_F(ArchiveTest, areProgramResultsUniqueIndexed)
+{
+    Archive archive(38, 1.0, 0, 0.1);
+    Data::PrimitiveTypeArray<int>& d =
+        (Data::PrimitiveTypeArray<int>&)vect.at(1).get();
+    Program::Program p2(*e);
+    Program::Program p3(*e);
+
+    // p results: 1.0, 2.0, p2 results: 1.0, 5.0, p3 results: NaN, 1.0
+    size_t hash1 = archive.getCombinedHash(vect);
+    archive.addRecording(p, vect, 1.0);
+    archive.addRecording(&p2, vect, 1.0);
+    archive.addRecording(&p3, vect, std::nan(""));
+    d.setDataAt(typeid(int), 2, 1337);
+    size_t hash2 = archive.getCombinedHash(vect);
+    archive.addRecording(p, vect, 2.0);
+    archive.addRecording(&p2, vect, 5.0);
+    archive.addRecording(&p3, vect, 1.0);
+
+    // Many other programs, so that the index is used for small maps.
+    std::vector<Program::Program> others(32, Program::Program(*e));
+    d.setDataAt(typeid(int), 2, 7);
+    for (auto i = 0; i < others.size(); i++) {
+        archive.addRecording(&others.at(i), vect, 100.0 + i);
+    }
+
+    // Results matching p within the interval, but not p2.
+    std::map<size_t, double> hashesAndResults1 = {{hash1, 1.05},
+                                                  {hash2, 1.95}};
+    ASSERT_FALSE(archive.areProgramResultsUnique(hashesAndResults1, 0.1))
+        << "Equal fake program bidding behavior not detected as such.";
+    ASSERT_TRUE(archive.areProgramResultsUnique(hashesAndResults1, 0.01))
+        << "Unique fake program bidding behavior not detected as such.";
+
+    // NaN results are never equal.
+    std::map<size_t, double> hashesAndResults2 = {{hash1, std::nan("")},
+                                                  {hash2, 3.0}};
+    ASSERT_TRUE(archive.areProgramResultsUnique(hashesAndResults2))
+        << "NaN results should not be equivalent.";
+
+    // Results matching p2 only for its first recording.
+    std::map<size_t, double> hashesAndResults3 = {{hash1, 1.0},
+                                                  {hash2, 4.0}};
+    ASSERT_TRUE(archive.areProgramResultsUnique(hashesAndResults3))
+        << "Unique fake program bidding behavior not detected as such.";
+
+    // Wide tau margin not using the index gives the same results.
+    ASSERT_FALSE(archive.areProgramResultsUnique(hashesAndResults3, 10.0))
+        << "Within margin fake program bidding behavior not detected as such.";
+
+    // Evict all recordings from p and p2 on hash1.
+    d.setDataAt(typeid(int), 2, 42);
+    for (auto i = 0; i < 3; i++) {
+        archive.addRecording(&others.at(i), vect, 3.0);
+    }
+    std::map<size_t, double> hashesAndResults4 = {{hash1, 1.0}};
+    ASSERT_TRUE(archive.areProgramResultsUnique(hashesAndResults4))
+        << "Evicted recordings should not be used for uniqueness checks.";
+
+    archive.clear();
+    ASSERT_TRUE(archive.areProgramResultsUnique(hashesAndResults1))
+        << "Cleared Archive should not contain equivalent program.";
+}
+
 TEST_F(ArchiveTest, DataHandlersAccessors)
 {
     Archive archive(4);
@@ -244,6 +244,76 @@ TEST(Array2DWrapperTest, getDataAt)
 }
 
 #ifdef CODE_GENERATION
+TEST(Array2DWrapperTest, fetchDataAt)
+{
+    const size_t h = 3;
+    const size_t w = 5;
+    std::vector<int> values(h * w);
+    Data::Array2DWrapper<int> a(w, h, &values);
+    Data::OperandBuffer operands(1);
+
+    // Fill the array
+    for (auto idx = 0; idx < h * w; idx++) {
+        values.at(idx) = idx;
+    }
+    a.invalidateCachedHash();
+
+    // Native type and 1D arrays are not copied
+    for (auto idx = 0; idx < a.getAddressSpace(typeid(int[3])); idx++) {
+        operands.clear();
+        a.fetchDataAt(typeid(int[3]), idx, operands);
+        ASSERT_EQ(operands.getPointer<int>(0),
+                  values.data() + (idx / (w - 3 + 1) * w + idx % (w - 3 + 1)))
+            << "Fetched 1D array is not a pointer to the original data.";
+    }
+
+    // 2D arrays spanning the full width are not copied
+    for (auto idx = 0; idx < a.getAddressSpace(typeid(int[2][w])); idx++) {
+        operands.clear();
+        a.fetchDataAt(typeid(int[2][w]), idx, operands);
+        ASSERT_EQ(operands.getPointer<int>(0), values.data() + idx * w)
+            << "Fetched full width 2D array is not a pointer to the original "
+               "data.";
+    }
+
+    // Other 2D arrays have the same content as with getDataAt
+    for (auto idx = 0; idx < a.getAddressSpace(typeid(int[2][3])); idx++) {
+        operands.clear();
+        a.fetchDataAt(typeid(int[2][3]), idx, operands);
+        std::shared_ptr<const int> valSPtr =
+            (a.getDataAt(typeid(int[2][3]), idx))
+                .getSharedPointer<const int[]>();
+        for (auto subIdx = 0; subIdx < 6; subIdx++) {
+            ASSERT_EQ(operands.getPointer<int>(0)[subIdx],
+                      valSPtr.get()[subIdx])
+                << "Value of fetched 2D array is not as expected.";
+        }
+    }
+
+    // Other 2D arrays are strided views when allowed
+    operands.setStridedAllowed(true);
+    for (auto idx = 0; idx < a.getAddressSpace(typeid(int[2][3])); idx++) {
+        operands.clear();
+        a.fetchDataAt(typeid(int[2][3]), idx, operands);
+        ASSERT_EQ(operands.getPointer<int>(0),
+                  values.data() + (idx / (w - 3 + 1) * w + idx % (w - 3 + 1)))
+            << "Fetched strided 2D array is not a pointer to the original "
+               "data.";
+        ASSERT_EQ(operands[0].stride, w)
+            << "Stride of fetched 2D array is not as expected.";
+    }
+
+#ifndef NDEBUG
+    operands.clear();
+    ASSERT_THROW(a.fetchDataAt(typeid(int[h * w]), 1, operands),
+                 std::invalid_argument)
+        << "Fetching a non-handled type should cause an exception.";
+    ASSERT_THROW(a.fetchDataAt(typeid(int[w - 1]), h * (w - 1) + 1, operands),
+                 std::out_of_range)
+        << "Address exceeding the addressSpace should cause an exception.";
+#endif
+}
+
 TEST(Array2DWrapperTest, getNativeType)
 {
     Data::DataHandler* d = new Data::Array2DWrapper<double>(4, 6);
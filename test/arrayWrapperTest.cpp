@@ -253,6 +253,65 @@ TEST(ArrayWrapperTest, GetDataAtArray)
     delete d;
 }
 
+TEST(ArrayWrapperTest, FetchDataAt)
+{
+    const size_t size{8};
+    std::vector<int> values{0, 1, 2, 3, 4, 5, 6, 7};
+    const size_t sizeArray = 3;
+    Data::ArrayWrapper<int> d(size, &values);
+    Data::OperandBuffer operands(2);
+
+    // Native type and arrays are not copied
+    for (int i = 0; i < size - sizeArray + 1; i++) {
+        operands.clear();
+        ASSERT_NO_THROW(d.fetchDataAt(typeid(int), i, operands))
+            << "Fetching native type data failed.";
+        ASSERT_NO_THROW(d.fetchDataAt(typeid(int[sizeArray]), i, operands))
+            << "Fetching array data failed.";
+        ASSERT_EQ(operands.size(), 2) << "Fetched data were not pushed.";
+        ASSERT_EQ(operands.getPointer<int>(0), values.data() + i)
+            << "Fetched native type data is not a pointer to the original "
+               "data.";
+        ASSERT_EQ(operands.getPointer<int>(1), values.data() + i)
+            << "Fetched array data is not a pointer to the original data.";
+        ASSERT_EQ(*operands[1].type, typeid(int[sizeArray]))
+            << "Type of fetched data is not the requested one.";
+    }
+
+    operands.clear();
+#ifndef NDEBUG
+    ASSERT_THROW(d.fetchDataAt(typeid(int[sizeArray]), size - 1, operands),
+                 std::out_of_range)
+        << "Address exceeding the addressSpace should cause an exception.";
+    ASSERT_THROW(d.fetchDataAt(typeid(long[sizeArray]), 0, operands),
+                 std::invalid_argument)
+        << "Requesting a non-handled type, even at a valid location, should "
+           "cause an exception.";
+#endif
+
+    // Capacity of the buffer
+    d.fetchDataAt(typeid(int), 0, operands);
+    d.fetchDataAt(typeid(int), 1, operands);
+    ASSERT_THROW(d.fetchDataAt(typeid(int), 2, operands), std::out_of_range)
+        << "Fetching data in a full OperandBuffer should cause an exception.";
+}
+
+TEST(ArrayWrapperTest, GetContiguousData)
+{
+    std::vector<int> values{0, 1, 2, 3, 4, 5, 6, 7};
+    Data::ArrayWrapper<int> d(values.size());
+
+    ASSERT_EQ(d.getContiguousData(typeid(int)), nullptr)
+        << "An ArrayWrapper without pointer has no contiguous data.";
+    d.setPointer(&values);
+    ASSERT_EQ(d.getContiguousData(typeid(int)), values.data())
+        << "Contiguous data of the native type should be the wrapped data.";
+    ASSERT_EQ(d.getContiguousData(typeid(int[3])), nullptr)
+        << "Contiguous data should only be exposed for the native type.";
+    ASSERT_EQ(d.getContiguousData(typeid(double)), nullptr)
+        << "Contiguous data should only be exposed for the native type.";
+}
+
 TEST(ArrayWrapperTest, GetLargestAddressSpace)
 {
     Data::DataHandler* d =
@@ -310,6 +369,111 @@ TEST(ArrayWrapperTest, Hash)
     ASSERT_EQ(d.getHash(), 0);
 }
 
+TEST(ArrayWrapperTest, ModifiedAddresses)
+{
+    std::vector<double> values(8);
+    Data::ArrayWrapper<double> d(8, &values);
+
+    uint64_t version = d.getModificationVersion();
+    ASSERT_FALSE(d.isModifiedSince({0, 3, 7}, version))
+        << "No address should be modified right after the version is read.";
+
+    // Modify a single address
+    size_t hash = d.getHash();
+    values.at(3) = 42.0;
+    ASSERT_NO_THROW(d.markAddressModified(3))
+        << "Marking a valid address as modified failed.";
+    ASSERT_NE(hash, d.getHash())
+        << "Marking an address as modified should invalidate the hash.";
+    ASSERT_GT(d.getModificationVersion(), version)
+        << "Modification version should increase on modification.";
+    ASSERT_FALSE(d.isModifiedSince({0, 1, 2, 4}, version))
+        << "Unmodified addresses are reported as modified.";
+    ASSERT_TRUE(d.isModifiedSince({2, 3}, version))
+        << "Modified address is not reported as modified.";
+    ASSERT_FALSE(d.isModifiedSince({3}, d.getModificationVersion()))
+        << "Address should not be modified since the latest version.";
+    ASSERT_THROW(d.markAddressModified(8), std::out_of_range)
+        << "Marking an out of range address should fail.";
+
+    // Modify all addresses
+    version = d.getModificationVersion();
+    d.invalidateCachedHash();
+    ASSERT_TRUE(d.isModifiedSince({0}, version))
+        << "Invalidating the hash should mark all addresses as modified.";
+    version = d.getModificationVersion();
+    d.setPointer(&values);
+    ASSERT_TRUE(d.isModifiedSince({5}, version))
+        << "Setting the pointer should mark all addresses as modified.";
+
+    // PrimitiveTypeArray tracks its own modifications
+    Data::PrimitiveTypeArray<double> p(8);
+    version = p.getModificationVersion();
+    p.setDataAt(typeid(double), 2, 1.0);
+    ASSERT_FALSE(p.isModifiedSince({0, 1, 3}, version))
+        << "Unmodified addresses are reported as modified.";
+    ASSERT_TRUE(p.isModifiedSince({2}, version))
+        << "Address set with setDataAt is not reported as modified.";
+    version = p.getModificationVersion();
+    p.resetData();
+    ASSERT_TRUE(p.isModifiedSince({7}, version))
+        << "Resetting data should mark all addresses as modified.";
+}
+
+TEST(ArrayWrapperTest, IncrementalHash)
+{
+    // Several hash blocks, the last one being incomplete.
+    std::vector<double> values(300);
+    for (size_t i = 0; i < values.size(); i++) {
+        values.at(i) = (double)i / 3.0;
+    }
+    Data::ArrayWrapper<double> d(values.size(), &values);
+    const size_t initialHash = d.getHash();
+
+    // Modify addresses in two blocks
+    values.at(5) = -12.0;
+    d.markAddressModified(5);
+    values.at(299) = 42.0;
+    d.markAddressModified(299);
+    const size_t incrementalHash = d.getHash();
+    ASSERT_NE(incrementalHash, initialHash)
+        << "Modified addresses should change the hash.";
+
+    // Compare with a complete computation of the hash
+    d.invalidateCachedHash();
+    ASSERT_EQ(d.getHash(), incrementalHash)
+        << "Incremental hash differs from the complete hash computation.";
+
+    // Restoring values restores the hash
+    values.at(5) = 5.0 / 3.0;
+    d.markAddressModified(5);
+    values.at(299) = 299.0 / 3.0;
+    d.markAddressModified(299);
+    ASSERT_EQ(d.getHash(), initialHash)
+        << "Restoring modified values should restore the hash.";
+
+    // Order of elements matters
+    std::swap(values.at(0), values.at(64));
+    d.markAddressModified(0);
+    d.markAddressModified(64);
+    ASSERT_NE(d.getHash(), initialHash)
+        << "Swapping elements from different blocks should change the hash.";
+    std::swap(values.at(0), values.at(64));
+    d.invalidateCachedHash();
+
+    // Clone keeps the hash, and updates it incrementally too.
+    Data::PrimitiveTypeArray<double>* clone =
+        (Data::PrimitiveTypeArray<double>*)d.clone();
+    ASSERT_EQ(clone->getHash(), initialHash)
+        << "Clone should have the same hash as the original ArrayWrapper.";
+    clone->setDataAt(typeid(double), 130, 3.0);
+    values.at(130) = 3.0;
+    d.markAddressModified(130);
+    ASSERT_EQ(clone->getHash(), d.getHash())
+        << "Identical modifications should produce identical hashes.";
+    delete clone;
+}
+
 TEST(ArrayWrapperTest, CanHandleConstants)
 {
     Data::DataHandler* d = new Data::ArrayWrapper<int>(4);
@@ -0,0 +1,86 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+/// doc in ../README.md
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "BatchTwoTeams.h"
+
+#define NB_SAMPLES 1000
+
+double* in1;
+
+int main(int argc, char* argv[])
+{
+    // Number of samples not multiple of the block size
+    in_t* inputs = malloc(NB_SAMPLES * sizeof(in_t));
+    int* actions = malloc(NB_SAMPLES * sizeof(int));
+    srand(0);
+    for (int i = 0; i < NB_SAMPLES; i++) {
+        for (int j = 0; j < sizeof(inputs[i].in1) / sizeof(double); j++) {
+            inputs[i].in1[j] = (double)(rand() % 21 - 10);
+        }
+    }
+
+    inferenceTPGBatch(inputs, NB_SAMPLES, actions);
+
+    // Compare with the inference of each sample
+    int nbErrors = 0;
+    int nbActions[4] = {0, 0, 0, 0};
+    for (int i = 0; i < NB_SAMPLES; i++) {
+        in1 = inputs[i].in1;
+        int action = inferenceTPG();
+        if (action != actions[i]) {
+            nbErrors++;
+        }
+        nbActions[action]++;
+    }
+
+    free(inputs);
+    free(actions);
+
+    if (nbErrors > 0) {
+        fprintf(stderr, "%d actions of the batch inference differ.\n",
+                nbErrors);
+        return 1;
+    }
+    // Check that all paths of the TPG were taken.
+    for (int a = 1; a < 4; a++) {
+        if (nbActions[a] == 0) {
+            fprintf(stderr, "action %d was never returned.\n", a);
+            return 2;
+        }
+    }
+    return 0;
+}
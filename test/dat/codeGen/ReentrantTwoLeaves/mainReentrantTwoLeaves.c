@@ -0,0 +1,86 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+/// doc in ../README.md
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ReentrantTwoLeaves.h"
+
+#define NB_THREADS 4
+#define NB_INFERENCES 100000
+
+/// Run inferences with a context owned by the thread.
+void* runInferences(void* arg)
+{
+    long threadIdx = (long)arg;
+    double input[3];
+    TPGContext ctx;
+    ctx.in1 = input;
+
+    for (int i = 0; i < NB_INFERENCES; i++) {
+        input[0] = (double)i;
+        input[1] = (double)((i + threadIdx) % 3);
+        input[2] = 1.0;
+        // P1 = in1[0] + in1[1] leads to action 1, P2 = in1[0] + in1[2] to
+        // action 2, which wins ties.
+        int expected = (input[1] > input[2]) ? 1 : 2;
+        if (inferenceTPG(&ctx) != expected) {
+            return (void*)1;
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char* argv[])
+{
+    pthread_t threads[NB_THREADS];
+    for (long t = 0; t < NB_THREADS; t++) {
+        if (pthread_create(&threads[t], NULL, runInferences, (void*)t) != 0) {
+            fprintf(stderr, "error while creating thread %ld.\n", t);
+            return 3;
+        }
+    }
+
+    int nbErrors = 0;
+    for (int t = 0; t < NB_THREADS; t++) {
+        void* result;
+        pthread_join(threads[t], &result);
+        if (result != NULL) {
+            fprintf(stderr, "wrong action returned in thread %d.\n", t);
+            nbErrors++;
+        }
+    }
+    return (nbErrors == 0) ? 0 : 1;
+}
@@ -56,3 +56,36 @@ TEST(DataHashTest, HashNullptr)
     std::nullptr_t t = NULL;
     ASSERT_EQ(Data::Hash<std::nullptr_t>()(t), 12161962213042174405u);
 }
+
+TEST(DataHashTest, WordHash)
+{
+    ASSERT_EQ(Data::WordHash<double>()(0.0), Data::WordHash<double>()(-0.0))
+        << "Positive and negative zero should have the same hash.";
+    ASSERT_EQ(Data::WordHash<float>()(0.0f), Data::WordHash<float>()(-0.0f))
+        << "Positive and negative zero should have the same hash.";
+    ASSERT_NE(Data::WordHash<double>()(1.0), Data::WordHash<double>()(2.0))
+        << "Different values should have different hashes.";
+    ASSERT_NE(Data::WordHash<int>()(1), Data::WordHash<int>()(256))
+        << "Different values should have different hashes.";
+    ASSERT_EQ(Data::WordHash<uint64_t>()(1337),
+              Data::WordHash<uint64_t>()(1337))
+        << "Hash should be deterministic.";
+
+    // Byte ranges
+    const unsigned char bytes[20] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    const size_t hash10 = Data::_Word_hash_append_bytes(
+        Data::_FNV_offset_basis, bytes, 10);
+    ASSERT_EQ(hash10, Data::_Word_hash_append_bytes(Data::_FNV_offset_basis,
+                                                    bytes, 10))
+        << "Hash should be deterministic.";
+    ASSERT_NE(hash10, Data::_Word_hash_append_bytes(Data::_FNV_offset_basis,
+                                                    bytes, 11))
+        << "Trailing zeros should change the hash.";
+    ASSERT_NE(hash10, Data::_Word_hash_append_bytes(Data::_FNV_offset_basis,
+                                                    bytes, 16))
+        << "Trailing zeros should change the hash.";
+    ASSERT_NE(Data::_Word_hash_append_bytes(Data::_FNV_offset_basis, bytes, 0),
+              Data::_Word_hash_append_bytes(Data::_FNV_offset_basis + 1, bytes,
+                                            0))
+        << "Initial value should change the hash.";
+}
@@ -38,13 +38,34 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <cmath>
 
 #include "data/dataHandler.h"
 #include "data/untypedSharedPtr.h"
 #include "instructions/addPrimitiveType.h"
+#include "instructions/doubleOperationInstruction.h"
 #include "instructions/lambdaInstruction.h"
 #include "instructions/multByConstant.h"
 #include "instructions/set.h"
+#include "program/doubleOperation.h"
+
+/// Instruction declaring an addition while subtracting its operands.
+class MislabelledSubtraction
+    : public Instructions::LambdaInstruction<double, double>
+{
+  public:
+    MislabelledSubtraction()
+        : LambdaInstruction([](double a, double b) { return a - b; })
+    {
+    }
+
+    bool getDoubleOperation(Program::DoubleOperation& operation) const override
+    {
+        operation = {
+            Program::DoubleOperation::Opcode::ADD, nullptr, {0, 1}, 2};
+        return true;
+    }
+};
 
 TEST(InstructionsTest, ConstructorDestructorCall)
 {
@@ -132,6 +153,110 @@ TEST(InstructionsTest, Execute)
     delete i;
 }
 
+TEST(InstructionsTest, ExecuteOperandBuffer)
+{
+    Instructions::Instruction* i = new Instructions::AddPrimitiveType<double>();
+    double a{2.6};
+    double b = 5.5;
+    int c = 3;
+
+    ASSERT_TRUE(i->supportsOperandBuffer())
+        << "AddPrimitiveType<double> should support the OperandBuffer.";
+
+    Data::OperandBuffer operands(2);
+    operands.push(&a, typeid(double));
+    operands.push(&b, typeid(double));
+    ASSERT_TRUE(i->checkOperandTypes(operands))
+        << "Operands of valid types wrongfully classified as invalid.";
+    ASSERT_EQ(i->execute(operands), 8.1)
+        << "Execute method of AddPrimitiveType<double> returns an incorrect "
+           "value with valid operands.";
+
+    operands.clear();
+    operands.push(&a, typeid(double));
+    operands.push(&c, typeid(int));
+    ASSERT_FALSE(i->checkOperandTypes(operands))
+        << "Operands of invalid types wrongfully classified as valid";
+#ifndef NDEBUG
+    ASSERT_EQ(i->execute(operands), 0.0)
+        << "Execute method of AddPrimitiveType<double> returns an incorrect "
+           "value with invalid operands.";
+#endif
+    delete i;
+}
+
+TEST(InstructionsTest, DoubleOperationInstruction)
+{
+    using Opcode = Program::DoubleOperation::Opcode;
+    Instructions::DoubleOperationInstruction sub(Opcode::SUB);
+    Instructions::DoubleOperationInstruction div(Opcode::DIV);
+    Instructions::DoubleOperationInstruction cosine(
+        static_cast<double (*)(double)>(&std::cos));
+    ASSERT_EQ(sub.getNbOperands(), 2)
+        << "Number of operands of a binary operation is different from 2.";
+    ASSERT_EQ(cosine.getNbOperands(), 1)
+        << "Number of operands of a CALL operation is different from 1.";
+    ASSERT_THROW(Instructions::DoubleOperationInstruction(Opcode::CALL),
+                 std::invalid_argument)
+        << "CALL operation without function should not be constructed.";
+
+    double a{2.5};
+    double b = 0.5;
+    std::vector<Data::UntypedSharedPtr> vect;
+    vect.emplace_back(&a, Data::UntypedSharedPtr::emptyDestructor<double>());
+    vect.emplace_back(&b, Data::UntypedSharedPtr::emptyDestructor<double>());
+    ASSERT_EQ(sub.execute(vect), 2.0)
+        << "Execute method of a SUB operation returns an incorrect value.";
+    ASSERT_EQ(div.execute(vect), 5.0)
+        << "Execute method of a DIV operation returns an incorrect value.";
+
+    ASSERT_TRUE(cosine.supportsOperandBuffer())
+        << "DoubleOperationInstruction should support the OperandBuffer.";
+    Data::OperandBuffer operands(1);
+    operands.push(&a, typeid(double));
+    ASSERT_EQ(cosine.execute(operands), std::cos(a))
+        << "Execute method of a CALL operation returns an incorrect value.";
+}
+
+TEST(InstructionsTest, DoubleOperationIdentify)
+{
+    using Opcode = Program::DoubleOperation::Opcode;
+    Program::DoubleOperation operation;
+
+    Instructions::AddPrimitiveType<double> add;
+    ASSERT_TRUE(Program::DoubleOperation::identify(add, operation))
+        << "AddPrimitiveType<double> should be identified.";
+    ASSERT_EQ(operation.opcode, Opcode::ADD)
+        << "Incorrect operation of AddPrimitiveType<double>.";
+    ASSERT_FALSE(Program::DoubleOperation::identify(
+        Instructions::AddPrimitiveType<int>(), operation))
+        << "AddPrimitiveType<int> should not be identified.";
+
+    Instructions::DoubleOperationInstruction squareRoot(Opcode::SQRT);
+    ASSERT_TRUE(Program::DoubleOperation::identify(squareRoot, operation))
+        << "DoubleOperationInstruction should be identified.";
+    ASSERT_EQ(operation.opcode, Opcode::SQRT)
+        << "Incorrect operation of DoubleOperationInstruction.";
+
+    // Operations are never guessed from the print template.
+#ifdef CODE_GENERATION
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; }, "$0 = $1 - $2;");
+#else
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+#endif // CODE_GENERATION
+    ASSERT_FALSE(Program::DoubleOperation::identify(sub, operation))
+        << "LambdaInstruction without declared operation should not be "
+           "identified.";
+
+    // Declared operations are checked against the execution.
+    ASSERT_FALSE(Program::DoubleOperation::identify(MislabelledSubtraction(),
+                                                    operation))
+        << "Operation declared inconsistently with the execution should not "
+           "be identified.";
+}
+
 TEST(InstructionsTest, SetAdd)
 {
     Instructions::Set s;
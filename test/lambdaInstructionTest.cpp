@@ -195,6 +195,77 @@ TEST(LambdaInstructionsTest, ExecuteArray2D)
             new double[6]{arrayBL1, arrayBL2}));
     ASSERT_EQ(instruction->execute(arguments), 144.1)
         << "Result returned by the instruction is not as expected.";
+
+    // Test execution with an OperandBuffer
+    double argA[6]{arrayAL1, arrayAL2};
+    double argB[6]{arrayBL1, arrayBL2};
+    Data::OperandBuffer buffer(2);
+    buffer.push(argA, typeid(const double[2][3]));
+    buffer.push(argB, typeid(const double[2][3]));
+    ASSERT_TRUE(instruction->supportsOperandBuffer())
+        << "LambdaInstruction should support the OperandBuffer.";
+    ASSERT_EQ(instruction->execute(buffer), 144.1)
+        << "Result returned by the instruction with an OperandBuffer is not "
+           "as expected.";
+}
+
+TEST(LambdaInstructionsTest, ExecuteArray2DView)
+{
+    std::function<double(const Data::Array2DView<const double[2][3]>,
+                         const double[2])>
+        mac = [](const Data::Array2DView<const double[2][3]> a,
+                 const double b[2]) {
+            double res = 0.0;
+            for (auto h = 0; h < 2; h++) {
+                for (auto w = 0; w < 3; w++) {
+                    res += a[h][w] * b[h];
+                }
+            }
+            return res;
+        };
+
+    // Build the instruction
+    Instructions::LambdaInstruction<const Data::Array2DView<const double[2][3]>,
+                                    const double[2]>
+        instruction(mac);
+    ASSERT_EQ(instruction.getOperandTypes().at(0).get(),
+              typeid(const double[2][3]))
+        << "Operand type of an Array2DView is not the viewed array type.";
+    ASSERT_TRUE(instruction.supportsStridedOperands())
+        << "Instruction with an Array2DView should support strided operands.";
+
+    double arrB[2]{2.0, 3.0};
+    const double expected =
+        (1.1 + 2.2 + 3.3) * arrB[0] + (4.4 + 5.5 + 6.6) * arrB[1];
+
+    // Test execution with contiguous UntypedSharedPtr
+    std::vector<Data::UntypedSharedPtr> arguments;
+    arguments.emplace_back(
+        std::make_shared<Data::UntypedSharedPtr::Model<const double[]>>(
+            new double[6]{arrayAL1, arrayAL2}));
+    arguments.emplace_back(
+        std::make_shared<Data::UntypedSharedPtr::Model<const double[]>>(
+            new double[2]{arrB[0], arrB[1]}));
+    ASSERT_TRUE(instruction.checkOperandTypes(arguments))
+        << "Operands of valid types wrongfully classified as invalid.";
+    ASSERT_DOUBLE_EQ(instruction.execute(arguments), expected)
+        << "Result returned by the instruction is not as expected.";
+
+    // Test execution with a strided view in a 2D array with 4 columns.
+    double strided[2][4]{{arrayAL1, -1.0}, {arrayAL2, -1.0}};
+    Data::OperandBuffer buffer(2);
+    buffer.push(&strided[0][0], typeid(const double[2][3]), 4);
+    buffer.push(arrB, typeid(const double[2]));
+    ASSERT_DOUBLE_EQ(instruction.execute(buffer), expected)
+        << "Result returned by the instruction with a strided operand is not "
+           "as expected.";
+
+    // Instruction with c-style 2D array do not support strided operands.
+    Instructions::LambdaInstruction<const double[2][3]> instruction2D(
+        [](const double a[2][3]) { return a[0][0]; });
+    ASSERT_FALSE(instruction2D.supportsStridedOperands())
+        << "Instruction with a c-style 2D array should not support strided "
+           "operands.";
 }
 
 TEST(LambdaInstructionsTest, ExecuteAllTypesMixed)
@@ -0,0 +1,234 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "data/dataHandler.h"
+#include "data/primitiveTypeArray.h"
+#include "data/primitiveTypeArray2D.h"
+#include "environment.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/doubleOperationInstruction.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/programMutator.h"
+#include "mutator/rng.h"
+#include "program/doubleOperation.h"
+#include "program/laneEvaluator.h"
+#include "program/program.h"
+#include "program/programExecutionEngine.h"
+
+using Opcode = Program::DoubleOperation::Opcode;
+
+/// Instruction dividing its second operand by its first one.
+class ReversedDivision : public Instructions::LambdaInstruction<double, double>
+{
+  public:
+    ReversedDivision()
+        : LambdaInstruction([](double a, double b) { return b / a; })
+    {
+    }
+
+    bool getDoubleOperation(Program::DoubleOperation& operation) const override
+    {
+        operation = {Opcode::DIV, nullptr, {1, 0}, 2};
+        return true;
+    }
+};
+
+class LaneEvaluatorTest : public ::testing::Test
+{
+  protected:
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Instructions::Set set;
+    Instructions::Set unsupportedSet;
+    Environment* e;
+    Environment* unsupportedEnv;
+    Mutator::MutationParameters params;
+
+    /// InstructionSet supported on the current platform.
+    std::vector<Program::LaneEvaluator::InstructionSet> instructionSets;
+
+    virtual void SetUp()
+    {
+        vect.push_back(*(new Data::PrimitiveTypeArray<double>(16)));
+        vect.push_back(*(new Data::PrimitiveTypeArray2D<double>(4, 4)));
+
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        set.add(*(new Instructions::DoubleOperationInstruction(Opcode::SUB)));
+        set.add(*(new Instructions::DoubleOperationInstruction(Opcode::MUL)));
+        set.add(*(new ReversedDivision()));
+        set.add(*(new Instructions::DoubleOperationInstruction(
+            static_cast<double (*)(double)>(&std::cos))));
+        set.add(*(new Instructions::DoubleOperationInstruction(Opcode::SQRT)));
+
+        unsupportedSet.add(*(new Instructions::AddPrimitiveType<double>()));
+        unsupportedSet.add(*(new Instructions::LambdaInstruction<double>(
+            [](double a) { return 2.0 * a; })));
+
+        e = new Environment(set, vect, 8, 0);
+        unsupportedEnv = new Environment(unsupportedSet, vect, 8, 0);
+
+        params.prog.maxProgramSize = 24;
+
+        for (auto instructionSet :
+             {Program::LaneEvaluator::InstructionSet::SCALAR,
+              Program::LaneEvaluator::InstructionSet::AVX2,
+              Program::LaneEvaluator::InstructionSet::AVX512}) {
+            if (Program::LaneEvaluator::isSupported(instructionSet)) {
+                instructionSets.push_back(instructionSet);
+            }
+        }
+    }
+
+    virtual void TearDown()
+    {
+        delete e;
+        delete unsupportedEnv;
+        delete (&(vect.at(0).get()));
+        delete (&(vect.at(1).get()));
+        for (uint64_t i = 0; i < set.getNbInstructions(); i++) {
+            delete (&set.getInstruction(i));
+        }
+        for (uint64_t i = 0; i < unsupportedSet.getNbInstructions(); i++) {
+            delete (&unsupportedSet.getInstruction(i));
+        }
+    }
+
+    /// Fill the data sources with random values.
+    void randomizeData(Mutator::RNG& rng)
+    {
+        for (uint64_t i = 0; i < 16; i++) {
+            ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+                .setDataAt(typeid(double), i, rng.getDouble(-10.0, 10.0));
+            ((Data::PrimitiveTypeArray2D<double>&)vect.at(1).get())
+                .setDataAt(typeid(double), i, rng.getDouble(-10.0, 10.0));
+        }
+    }
+
+    /// Check that two doubles are identical, NaN included.
+    static bool isIdentical(double a, double b)
+    {
+        return (std::isnan(a) && std::isnan(b)) ||
+               std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+};
+
+TEST_F(LaneEvaluatorTest, Constructor)
+{
+    Program::Program p(*e);
+    Program::Line& l0 = p.addNewLine();
+    l0.setInstructionIndex(0); // AddPrimitiveType<double>
+    l0.setOperand(0, 1, 3);    // 4th double of the 1D array
+    l0.setOperand(1, 2, 5);    // 6th double of the 2D array
+    l0.setDestinationIndex(0);
+    p.identifyIntrons();
+
+    ASSERT_TRUE(Program::LaneEvaluator::isSupported(
+        Program::LaneEvaluator::InstructionSet::SCALAR))
+        << "Scalar InstructionSet should always be supported.";
+    ASSERT_TRUE(Program::LaneEvaluator::isSupported(
+        Program::LaneEvaluator::getBestInstructionSet()))
+        << "Best InstructionSet should be supported.";
+
+    for (auto instructionSet : instructionSets) {
+        Program::LaneEvaluator* evaluator;
+        ASSERT_NO_THROW(evaluator =
+                            new Program::LaneEvaluator({&p}, instructionSet))
+            << "Construction of a LaneEvaluator failed.";
+        ASSERT_EQ(evaluator->getInstructionSet(), instructionSet)
+            << "Incorrect InstructionSet of the LaneEvaluator.";
+        ASSERT_TRUE(evaluator->isEvaluable())
+            << "Program with only AddPrimitiveType<double> should be "
+               "evaluable.";
+        ASSERT_NO_THROW(delete evaluator) << "Destruction failed.";
+    }
+}
+
+TEST_F(LaneEvaluatorTest, EvaluateRandomPrograms)
+{
+    Mutator::RNG rng(42);
+    Program::ProgramExecutionEngine progExecEng(*e);
+
+    // 19 Program do not fill the last group of lanes.
+    std::vector<Program::Program> programs(19, Program::Program(*e));
+    std::vector<const Program::Program*> pointers;
+    for (Program::Program& p : programs) {
+        Mutator::ProgramMutator::initRandomProgram(p, params, rng);
+        pointers.push_back(&p);
+    }
+
+    for (auto instructionSet : instructionSets) {
+        Program::LaneEvaluator evaluator(pointers, instructionSet);
+        ASSERT_TRUE(evaluator.isEvaluable())
+            << "Random Program with supported Instruction should be "
+               "evaluable.";
+
+        std::vector<double> results(programs.size());
+        for (int j = 0; j < 4; j++) {
+            randomizeData(rng);
+            evaluator.evaluate(vect, results.data());
+            for (size_t i = 0; i < programs.size(); i++) {
+                progExecEng.setProgram(programs.at(i));
+                double expected = progExecEng.executeProgram();
+                ASSERT_TRUE(isIdentical(results.at(i), expected))
+                    << "Lane evaluation of random Program " << i
+                    << " with InstructionSet " << (int)instructionSet
+                    << " differs from its interpretation: " << results.at(i)
+                    << " instead of " << expected << ".";
+            }
+        }
+    }
+}
+
+TEST_F(LaneEvaluatorTest, UnsupportedProgram)
+{
+    Program::Program p(*unsupportedEnv);
+    Program::Line& l0 = p.addNewLine();
+    l0.setInstructionIndex(1); // Lambda without declared operation
+    l0.setOperand(0, 1, 3);
+    l0.setDestinationIndex(0);
+    p.identifyIntrons();
+
+    Program::LaneEvaluator evaluator({&p});
+    ASSERT_FALSE(evaluator.isEvaluable())
+        << "Program with an unidentified Instruction should not be "
+           "evaluable.";
+    double result;
+    ASSERT_THROW(evaluator.evaluate(vect, &result), std::runtime_error)
+        << "Evaluation of a Program that is not evaluable should fail.";
+}
@@ -38,6 +38,7 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <numeric>
@@ -50,6 +51,7 @@
 #include "tpg/instrumented/tpgTeamInstrumented.h"
 #include "tpg/instrumented/tpgVertexInstrumentation.h"
 #include "tpg/policyStats.h"
+#include "tpg/tpgArenaFactory.h"
 #include "tpg/tpgGraph.h"
 
 #include "instructions/addPrimitiveType.h"
@@ -255,6 +257,94 @@ TEST_F(LearningAgentTest, EvalRoot)
         << "Average score should not exceed the score of a perfect player.";
 }
 
+/// StickGameWithOpponent declared deterministic, counting its resets.
+class DeterministicStickGame : public StickGameWithOpponent
+{
+  public:
+    uint64_t nbResets = 0;
+
+    bool isDeterministic() const override
+    {
+        return true;
+    }
+
+    void reset(size_t seed, Learn::LearningMode mode, uint16_t iterationNumber,
+               uint64_t generationNumber) override
+    {
+        nbResets++;
+        StickGameWithOpponent::reset(0, mode, iterationNumber,
+                                     generationNumber);
+    }
+};
+
+TEST_F(LearningAgentTest, EvalRootDeterministic)
+{
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 3;
+
+    DeterministicStickGame dle;
+    Learn::LearningAgent la(dle, set, params);
+    TPG::TPGExecutionEngine tee(la.getTPGGraph()->getEnvironment());
+    la.init();
+
+    auto job = *la.makeJob(la.getTPGGraph()->getRootVertices().at(0),
+                           Learn::LearningMode::TRAINING);
+    dle.nbResets = 0;
+    std::shared_ptr<Learn::EvaluationResult> result0 =
+        la.evaluateJob(tee, job, 0, Learn::LearningMode::TRAINING, dle);
+    ASSERT_EQ(dle.nbResets, params.nbIterationsPerPolicyEvaluation)
+        << "First evaluation of a policy should reset the environment.";
+
+    // Same policy in another generation: result is reused.
+    std::shared_ptr<Learn::EvaluationResult> result1 =
+        la.evaluateJob(tee, job, 1, Learn::LearningMode::TRAINING, dle);
+    ASSERT_EQ(dle.nbResets, params.nbIterationsPerPolicyEvaluation)
+        << "Evaluation of an already evaluated policy should be skipped.";
+    ASSERT_EQ(result0->getResult(), result1->getResult())
+        << "Reused result differs from the original one.";
+    ASSERT_EQ(result0->getNbEvaluation(), result1->getNbEvaluation())
+        << "Reused result differs from the original one.";
+
+    // Other mode: evaluation is not skipped.
+    la.evaluateJob(tee, job, 1, Learn::LearningMode::VALIDATION, dle);
+    ASSERT_EQ(dle.nbResets, 2 * params.nbIterationsPerPolicyEvaluation)
+        << "Results should not be reused for another LearningMode.";
+
+    // Forget results
+    la.forgetPreviousResults();
+    la.evaluateJob(tee, job, 1, Learn::LearningMode::TRAINING, dle);
+    ASSERT_EQ(dle.nbResets, 3 * params.nbIterationsPerPolicyEvaluation)
+        << "Results should not be reused after forgetPreviousResults.";
+}
+
+TEST_F(LearningAgentTest, TrainDeterministicPrunesFingerprints)
+{
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 3;
+    params.doValidation = true;
+
+    DeterministicStickGame dle;
+    Learn::LearningAgent la(dle, set, params);
+    la.init();
+
+    // Results of policies of decimated roots are forgotten, so that at most
+    // one TRAINING and one VALIDATION result are kept per surviving root.
+    for (uint64_t generation = 0; generation < 10; generation++) {
+        ASSERT_NO_THROW(la.trainOneGeneration(generation))
+            << "Training for one generation failed.";
+        ASSERT_GT(la.getNbResultsPerFingerprint(), 0)
+            << "Results of surviving roots should be kept.";
+        ASSERT_LE(la.getNbResultsPerFingerprint(),
+                  2 * la.getTPGGraph()->getNbRootVertices())
+            << "Results stored for fingerprints should be bounded by the "
+               "number of roots.";
+    }
+
+    la.forgetPreviousResults();
+    ASSERT_EQ(la.getNbResultsPerFingerprint(), 0)
+        << "Results should be forgotten by forgetPreviousResults.";
+}
+
 TEST_F(LearningAgentTest, EvaluateOneRoot)
 {
     params.archiveSize = 50;
@@ -696,6 +786,49 @@ TEST_F(LearningAgentTest, TrainInstrumented)
               107);
 }
 
+// Same as TrainInstrumented, but with a TPGArenaFactory: allocating the
+// graph elements from a TPGArena must not change the training.
+TEST_F(LearningAgentTest, TrainArena)
+{
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 5;
+    params.ratioDeletedRoots = 0.2;
+    params.nbGenerations = 20;
+    params.mutation.tpg.nbRoots = 30;
+    // A root may be evaluated at most for 3 generations
+    params.maxNbEvaluationPerPolicy =
+        params.nbIterationsPerPolicyEvaluation * 3;
+    params.mutation.tpg.forceProgramBehaviorChangeOnMutation = true;
+
+    TPG::TPGArenaFactory factory;
+    Learn::LearningAgent la(le, set, params, factory);
+
+    la.init();
+    bool alt = false;
+    la.train(alt, false);
+
+    TPG::TPGGraph& tpg = *la.getTPGGraph();
+    ASSERT_EQ(tpg.getNbVertices(), 29)
+        << "Graph does not have the expected determinst characteristics.";
+    ASSERT_EQ(tpg.getNbRootVertices(), 25)
+        << "Graph does not have the expected determinist characteristics.";
+    ASSERT_EQ(tpg.getEdges().size(), 92)
+        << "Graph does not have the expected determinst characteristics.";
+    ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX), 8778232462724898875)
+        << "Graph does not have the expected determinst characteristics.";
+
+    // Elements of removed roots were recycled by the TPGArena
+    ASSERT_GT(factory.getArena()->getNbFreeSlots(), 0)
+        << "Elements removed during training should be recycled by the "
+           "TPGArena.";
+    ASSERT_GE(factory.getArena()->getNbUsedSlots(),
+              tpg.getNbVertices() + tpg.getEdges().size())
+        << "Elements of the trained TPGGraph should be allocated in the "
+           "TPGArena of the factory.";
+}
+
 TEST_F(LearningAgentTest, KeepBestPolicy)
 {
     params.archiveSize = 50;
@@ -883,6 +1016,53 @@ TEST_F(ParallelLearningAgentTest, EvalAllRootsParallel)
            "TPGGraph.";
 }
 
+/// StickGameWithOpponent counting the number of clones.
+class CountingStickGame : public StickGameWithOpponent
+{
+  public:
+    /// Number of calls to clone(), shared by all clones.
+    std::shared_ptr<std::atomic<uint64_t>> nbClones =
+        std::make_shared<std::atomic<uint64_t>>(0);
+
+    Learn::LearningEnvironment* clone() const override
+    {
+        (*this->nbClones)++;
+        return new CountingStickGame(*this);
+    }
+};
+
+TEST_F(ParallelLearningAgentTest, EvalAllRootsParallelPersistentClones)
+{
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 2;
+    params.nbThreads = 4;
+
+    CountingStickGame countingLE;
+    Learn::ParallelLearningAgent pla(countingLE, set, params);
+    pla.init();
+
+    for (uint64_t generation = 0; generation < 3; generation++) {
+        ASSERT_NO_THROW(
+            pla.evaluateAllRoots(generation, Learn::LearningMode::TRAINING))
+            << "Evaluation of roots failed.";
+    }
+    // The calling thread uses the main LearningEnvironment.
+    uint64_t nbClones = *countingLE.nbClones;
+    ASSERT_LE(nbClones, params.nbThreads - 1)
+        << "LearningEnvironment should be cloned at most once per thread "
+           "during the lifetime of the agent.";
+
+    ASSERT_NO_THROW(pla.resyncEvaluationContexts())
+        << "Resync of the evaluation contexts failed.";
+    ASSERT_NO_THROW(pla.evaluateAllRoots(3, Learn::LearningMode::TRAINING))
+        << "Evaluation of roots after a resync failed.";
+    ASSERT_LE(*countingLE.nbClones, nbClones + params.nbThreads - 1)
+        << "LearningEnvironment should be cloned at most once per thread "
+           "after a resync.";
+}
+
 TEST_F(ParallelLearningAgentTest, EvalAllRootsParallelTrainingDeterminism)
 {
     // Check that parallel execution leads to the exact same results as
@@ -1236,6 +1416,49 @@ TEST_F(ParallelLearningAgentTest, TrainParallelDeterminism)
            "TPGGraphs.";
 }
 
+// Same as previous, with the counter-based RNG
+TEST_F(ParallelLearningAgentTest, TrainParallelDeterminismCounterBasedRNG)
+{
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 5;
+    params.ratioDeletedRoots = 0.2;
+    params.nbGenerations = 20;
+    params.mutation.tpg.nbRoots = 30;
+    params.maxNbEvaluationPerPolicy =
+        params.nbIterationsPerPolicyEvaluation * 5;
+    params.counterBasedRNG = true;
+
+    Learn::LearningAgent la(le, set, params);
+    la.init();
+    ASSERT_EQ(la.getRNG().getEngineType(),
+              Mutator::RNG::EngineType::PHILOX_4X32)
+        << "LearningAgent should use the counter-based RNG.";
+
+    bool alt = false;
+    la.train(alt, false);
+
+    params.nbThreads = 4;
+    Learn::ParallelLearningAgent pla(le, set, params);
+    pla.init();
+    pla.train(alt, false);
+
+    ASSERT_GT(la.getTPGGraph()->getNbVertices(), 0)
+        << "Number of vertex in the trained graph should not be 0.";
+    ASSERT_EQ(la.getTPGGraph()->getNbVertices(),
+              pla.getTPGGraph()->getNbVertices())
+        << "LearningAgent and ParallelLearning agent result in different "
+           "TPGGraphs.";
+    ASSERT_EQ(la.getTPGGraph()->getEdges().size(),
+              pla.getTPGGraph()->getEdges().size())
+        << "LearningAgent and ParallelLearning agent result in different "
+           "TPGGraphs.";
+    ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX),
+              pla.getRNG().getUnsignedInt64(0, UINT64_MAX))
+        << "LearningAgent and ParallelLearning agent RNG diverged.";
+}
+
 TEST_F(ParallelLearningAgentTest, KeepBestPolicy)
 {
     params.archiveSize = 50;
@@ -50,6 +50,7 @@
 #include "instructions/lambdaInstruction.h"
 #include "instructions/multByConstant.h"
 #include "mutator/lineMutator.h"
+#include "mutator/philoxEngine.h"
 #include "mutator/programMutator.h"
 #include "mutator/rng.h"
 #include "mutator/tpgMutator.h"
@@ -129,6 +130,96 @@ TEST_F(MutatorTest, RNG)
         << "Returned pseudo-random value changed with a known seed.";
 }
 
+TEST_F(MutatorTest, PhiloxEngine)
+{
+    // Known answers of the Philox4x32-10 reference implementation
+    std::array<uint32_t, 4> block =
+        Mutator::PhiloxEngine::generateBlock({0, 0, 0, 0}, {0, 0});
+    ASSERT_EQ(block, (std::array<uint32_t, 4>{0x6627e8d5, 0xe169c58d,
+                                              0xbc57ac4c, 0x9b00dbd8}))
+        << "Philox4x32-10 bijection differs from the reference.";
+    block = Mutator::PhiloxEngine::generateBlock(
+        {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+        {0xffffffff, 0xffffffff});
+    ASSERT_EQ(block, (std::array<uint32_t, 4>{0x408f276d, 0x41c83b0e,
+                                              0xa20bc7c6, 0x6d5451fd}))
+        << "Philox4x32-10 bijection differs from the reference.";
+
+    // Discard is equivalent to drawing numbers
+    Mutator::PhiloxEngine engine(42, 3);
+    Mutator::PhiloxEngine engineCopy(engine);
+    for (int i = 0; i < 5; i++) {
+        engine();
+    }
+    engineCopy.discard(5);
+    ASSERT_EQ(engine, engineCopy) << "Engines should be in the same state.";
+    ASSERT_EQ(engine(), engineCopy())
+        << "Discarded engine should generate the same numbers.";
+
+    // Streams differ
+    Mutator::PhiloxEngine otherStream(42, 4);
+    Mutator::PhiloxEngine firstStream(42, 3);
+    ASSERT_NE(firstStream(), otherStream())
+        << "Different streams should generate different numbers.";
+}
+
+TEST_F(MutatorTest, RNGStreams)
+{
+    for (auto type : {Mutator::RNG::EngineType::MT19937_64,
+                      Mutator::RNG::EngineType::PHILOX_4X32}) {
+        Mutator::RNG rng(12, type);
+        ASSERT_EQ(rng.getEngineType(), type)
+            << "Incorrect engine type of the RNG.";
+
+        // Streams only depend on the seed and the tuple
+        Mutator::RNG stream = rng.getStream(3, 5, 0);
+        uint64_t value = stream.getUnsignedInt64(0, UINT64_MAX);
+        rng.getUnsignedInt64(0, UINT64_MAX);
+        ASSERT_EQ(rng.getStream(3, 5, 0).getUnsignedInt64(0, UINT64_MAX),
+                  value)
+            << "Stream should not depend on the numbers drawn from the RNG.";
+        ASSERT_EQ(stream.getEngineType(), type)
+            << "Stream should use the engine type of the RNG.";
+
+        // Different tuples give different streams
+        ASSERT_NE(rng.getStream(3, 6, 0).getUnsignedInt64(0, UINT64_MAX),
+                  value)
+            << "Different indexes should give different streams.";
+        ASSERT_NE(rng.getStream(4, 5, 0).getUnsignedInt64(0, UINT64_MAX),
+                  value)
+            << "Different generations should give different streams.";
+        ASSERT_NE(rng.getStream(3, 5, 1).getUnsignedInt64(0, UINT64_MAX),
+                  value)
+            << "Different purposes should give different streams.";
+
+        // Seed changes all streams
+        rng.setSeed(13);
+        ASSERT_NE(rng.getStream(3, 5, 0).getUnsignedInt64(0, UINT64_MAX),
+                  value)
+            << "Different seeds should give different streams.";
+
+        // Copies draw the same numbers
+        Mutator::RNG copy(rng);
+        ASSERT_EQ(copy.getDouble(0.0, 1.0), rng.getDouble(0.0, 1.0))
+            << "Copy of the RNG should draw the same numbers.";
+        int32_t number = copy.getInt32(-5, 5);
+        ASSERT_TRUE(number >= -5 && number <= 5)
+            << "Number drawn outside of the requested bounds.";
+    }
+
+    // Changing the engine type resets the RNG with its seed.
+    Mutator::RNG rng(0);
+    rng.setEngineType(Mutator::RNG::EngineType::PHILOX_4X32);
+    Mutator::RNG philox(0, Mutator::RNG::EngineType::PHILOX_4X32);
+    ASSERT_EQ(rng.getUnsignedInt64(0, UINT64_MAX),
+              philox.getUnsignedInt64(0, UINT64_MAX))
+        << "RNG with a new engine type should draw the same numbers as a "
+           "new RNG.";
+    rng.setEngineType(Mutator::RNG::EngineType::MT19937_64);
+    ASSERT_EQ(rng.getUnsignedInt64(0, 100), 24)
+        << "Returned pseudo-random value changed with a known seed.";
+}
+
 TEST_F(MutatorTest, LineMutatorInitRandomCorrectLine1)
 {
     Mutator::RNG rng;
@@ -840,6 +931,71 @@ TEST_F(MutatorTest, TPGMutatorMutateTeam)
     // already covered in other unit tests.
 }
 
+TEST_F(MutatorTest, TPGMutatorPrepareAndCommitTeamMutation)
+{
+    Mutator::RNG rng(0, Mutator::RNG::EngineType::PHILOX_4X32);
+
+    // Create a TPG
+    TPG::TPGGraph tpg(*e);
+    const TPG::TPGTeam& vertex0 = tpg.addNewTeam();
+    const TPG::TPGAction& vertex1 = tpg.addNewAction(0);
+    const TPG::TPGAction& vertex2 = tpg.addNewAction(1);
+    tpg.addNewEdge(vertex0, vertex1, progPointer);
+    tpg.addNewEdge(vertex0, vertex2, progPointer);
+    const TPG::TPGAction& vertex3 = tpg.addNewAction(2);
+    const TPG::TPGTeam& vertex4 = tpg.addNewTeam();
+    tpg.addNewEdge(vertex4, vertex3, progPointer);
+    tpg.addNewEdge(vertex0, vertex3, progPointer);
+
+    std::vector<TPG::TPGEdge*> preExistingEdges;
+    for (const std::unique_ptr<TPG::TPGEdge>& edge : tpg.getEdges()) {
+        preExistingEdges.push_back(edge.get());
+    }
+
+    Mutator::MutationParameters params;
+    params.tpg.maxOutgoingEdges = 5;
+    params.tpg.pEdgeDeletion = 0.7;
+    params.tpg.pEdgeAddition = 0.7;
+    params.tpg.pProgramMutation = 0.2;
+    params.tpg.pEdgeDestinationChange = 0.1;
+    params.tpg.pEdgeDestinationIsAction = 0.5;
+
+    Mutator::TPGMutator::TeamMutation mutation;
+    ASSERT_NO_THROW(mutation = Mutator::TPGMutator::prepareTeamMutation(
+                        tpg, vertex0, {&vertex0, &vertex4},
+                        {&vertex1, &vertex2, &vertex3}, preExistingEdges,
+                        params, rng))
+        << "Preparing the mutation of a team should not fail.";
+
+    // The graph is not modified by the preparation
+    ASSERT_EQ(tpg.getNbVertices(), 5);
+    ASSERT_EQ(tpg.getEdges().size(), 4);
+
+    ASSERT_GE(mutation.edges.size(), 2) << "A mutated team keeps 2 edges.";
+    ASSERT_LE(mutation.edges.size(), params.tpg.maxOutgoingEdges)
+        << "A mutated team has at most maxOutgoingEdges edges.";
+    ASSERT_EQ(mutation.isNewProgram.size(), mutation.edges.size());
+    size_t nbNewPrograms = std::count(mutation.isNewProgram.begin(),
+                                      mutation.isNewProgram.end(), true);
+    ASSERT_GE(nbNewPrograms, 1) << "At least one Program should be mutated.";
+
+    // Commit the mutation
+    std::list<std::shared_ptr<Program::Program>> newPrograms;
+    const TPG::TPGTeam* newTeam = nullptr;
+    ASSERT_NO_THROW(newTeam = &Mutator::TPGMutator::commitTeamMutation(
+                        tpg, mutation, newPrograms))
+        << "Committing the mutation of a team should not fail.";
+    ASSERT_EQ(tpg.getNbVertices(), 6);
+    ASSERT_EQ(newTeam->getOutgoingEdges().size(), mutation.edges.size());
+    ASSERT_EQ(newPrograms.size(), nbNewPrograms);
+    auto edgeIter = newTeam->getOutgoingEdges().begin();
+    for (const auto& edge : mutation.edges) {
+        ASSERT_EQ((*edgeIter)->getDestination(), edge.first);
+        ASSERT_EQ(&(*edgeIter)->getProgram(), edge.second.get());
+        edgeIter++;
+    }
+}
+
 TEST_F(MutatorTest, TPGMutatorMutateProgramBehaviorAgainstArchive)
 {
     Mutator::RNG rng;
@@ -1127,3 +1283,86 @@ TEST_F(MutatorTest, TPGMutatorPopulate)
         Mutator::TPGMutator::populateTPG(tpg2, arch, params, rng, nbActions, 0))
         << "Populating an empty TPG failed.";
 }
+
+TEST_F(MutatorTest, TPGMutatorPopulateCounterBasedRNGDeterminism)
+{
+    Mutator::MutationParameters params;
+
+    uint64_t nbActions = 4;
+    params.tpg.initNbRoots = 4;
+    params.tpg.maxInitOutgoingEdges = 3;
+    params.prog.maxProgramSize = 96;
+    params.tpg.nbRoots = 20;
+    // Proba as in Kelly's paper
+    params.tpg.pEdgeDeletion = 0.7;
+    params.tpg.pEdgeAddition = 0.7;
+    params.tpg.pProgramMutation = 0.2;
+    params.tpg.pEdgeDestinationChange = 0.1;
+    params.tpg.pEdgeDestinationIsAction = 0.5;
+    params.prog.pAdd = 0.5;
+    params.prog.pDelete = 0.5;
+    params.prog.pMutate = 1.0;
+    params.prog.pSwap = 1.0;
+    params.prog.pConstantMutation = 0.5;
+    params.prog.minConstValue = 0;
+    params.prog.maxConstValue = 10;
+
+    // Populate identical graphs with different numbers of threads, the last
+    // one with a persistent ThreadPool.
+    Util::ThreadPool pool(3);
+    const std::vector<uint64_t> nbThreadsList{0, 1, 4, 3};
+    std::vector<std::unique_ptr<TPG::TPGGraph>> graphs;
+    for (size_t idx = 0; idx < nbThreadsList.size(); idx++) {
+        Mutator::RNG rng(0, Mutator::RNG::EngineType::PHILOX_4X32);
+        graphs.emplace_back(new TPG::TPGGraph(*e));
+        TPG::TPGGraph& tpg = *graphs.back();
+        Archive arch;
+        Mutator::TPGMutator::initRandomTPG(tpg, params, rng, nbActions);
+        TPG::TPGExecutionEngine tee(*e, &arch);
+        for (auto rootVertex : tpg.getRootVertices()) {
+            tee.executeFromRoot(*rootVertex);
+        }
+        ASSERT_NO_THROW(Mutator::TPGMutator::populateTPG(
+            tpg, arch, params, rng, nbActions, nbThreadsList.at(idx),
+            (idx == nbThreadsList.size() - 1) ? &pool : nullptr))
+            << "Populating a TPG with " << nbThreadsList.at(idx)
+            << " threads failed.";
+        ASSERT_EQ(tpg.getRootVertices().size(), params.tpg.nbRoots);
+    }
+
+    // Check that all graphs are identical
+    const TPG::TPGGraph& reference = *graphs.front();
+    const auto refVertices = reference.getVertices();
+    for (size_t idx = 1; idx < graphs.size(); idx++) {
+        const TPG::TPGGraph& tpg = *graphs.at(idx);
+        const auto vertices = tpg.getVertices();
+        ASSERT_EQ(vertices.size(), refVertices.size())
+            << "Different number of vertices with graph " << idx;
+        ASSERT_EQ(tpg.getEdges().size(), reference.getEdges().size())
+            << "Different number of edges with graph " << idx;
+        auto refEdge = reference.getEdges().begin();
+        for (const std::unique_ptr<TPG::TPGEdge>& edge : tpg.getEdges()) {
+            ASSERT_EQ(std::find(vertices.begin(), vertices.end(),
+                                edge->getSource()) -
+                          vertices.begin(),
+                      std::find(refVertices.begin(), refVertices.end(),
+                                (*refEdge)->getSource()) -
+                          refVertices.begin())
+                << "Different edge source with graph " << idx;
+            ASSERT_EQ(std::find(vertices.begin(), vertices.end(),
+                                edge->getDestination()) -
+                          vertices.begin(),
+                      std::find(refVertices.begin(), refVertices.end(),
+                                (*refEdge)->getDestination()) -
+                          refVertices.begin())
+                << "Different edge destination with graph " << idx;
+            ASSERT_EQ(edge->getProgram().getNbLines(),
+                      (*refEdge)->getProgram().getNbLines())
+                << "Different Program with graph " << idx;
+            ASSERT_TRUE(edge->getProgram().hasIdenticalBehavior(
+                (*refEdge)->getProgram()))
+                << "Different Program with graph " << idx;
+            refEdge++;
+        }
+    }
+}
@@ -0,0 +1,334 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "data/dataHandler.h"
+#include "data/primitiveTypeArray.h"
+#include "data/primitiveTypeArray2D.h"
+#include "environment.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/doubleOperationInstruction.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/programMutator.h"
+#include "mutator/rng.h"
+#include "program/doubleOperation.h"
+#include "program/compiledProgram.h"
+#include "program/nativeProgram.h"
+#include "program/program.h"
+#include "program/programExecutionEngine.h"
+
+using Opcode = Program::DoubleOperation::Opcode;
+
+/// Instruction dividing its second operand by its first one.
+class ReversedDivision : public Instructions::LambdaInstruction<double, double>
+{
+  public:
+    ReversedDivision()
+        : LambdaInstruction([](double a, double b) { return b / a; })
+    {
+    }
+
+    bool getDoubleOperation(Program::DoubleOperation& operation) const override
+    {
+        operation = {Opcode::DIV, nullptr, {1, 0}, 2};
+        return true;
+    }
+};
+
+class NativeProgramTest : public ::testing::Test
+{
+  protected:
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Instructions::Set set;
+    Instructions::Set unsupportedSet;
+    Environment* e;
+    Environment* unsupportedEnv;
+    Mutator::MutationParameters params;
+
+    virtual void SetUp()
+    {
+        vect.push_back(*(new Data::PrimitiveTypeArray<double>(16)));
+        vect.push_back(*(new Data::PrimitiveTypeArray2D<double>(4, 4)));
+
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        set.add(*(new Instructions::DoubleOperationInstruction(Opcode::SUB)));
+        set.add(*(new Instructions::DoubleOperationInstruction(Opcode::MUL)));
+        set.add(*(new ReversedDivision()));
+        set.add(*(new Instructions::DoubleOperationInstruction(
+            static_cast<double (*)(double)>(&std::cos))));
+        set.add(*(new Instructions::DoubleOperationInstruction(Opcode::SQRT)));
+        set.add(*(new Instructions::DoubleOperationInstruction(
+            static_cast<double (*)(double)>(&std::log))));
+
+        unsupportedSet.add(*(new Instructions::AddPrimitiveType<double>()));
+        unsupportedSet.add(*(new Instructions::LambdaInstruction<double>(
+            [](double a) { return 2.0 * a; })));
+
+        e = new Environment(set, vect, 8, 0);
+        unsupportedEnv = new Environment(unsupportedSet, vect, 8, 0);
+
+        params.prog.maxProgramSize = 24;
+    }
+
+    virtual void TearDown()
+    {
+        delete e;
+        delete unsupportedEnv;
+        delete (&(vect.at(0).get()));
+        delete (&(vect.at(1).get()));
+        for (uint64_t i = 0; i < set.getNbInstructions(); i++) {
+            delete (&set.getInstruction(i));
+        }
+        for (uint64_t i = 0; i < unsupportedSet.getNbInstructions(); i++) {
+            delete (&unsupportedSet.getInstruction(i));
+        }
+    }
+
+    /// Fill the data sources with random values.
+    void randomizeData(Mutator::RNG& rng)
+    {
+        for (uint64_t i = 0; i < 16; i++) {
+            ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+                .setDataAt(typeid(double), i, rng.getDouble(-10.0, 10.0));
+            ((Data::PrimitiveTypeArray2D<double>&)vect.at(1).get())
+                .setDataAt(typeid(double), i, rng.getDouble(-10.0, 10.0));
+        }
+    }
+
+    /// Check that two doubles are identical, NaN included.
+    static bool isIdentical(double a, double b)
+    {
+        return (std::isnan(a) && std::isnan(b)) ||
+               std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+};
+
+TEST_F(NativeProgramTest, Constructor)
+{
+    Program::Program p(*e);
+    Program::Line& l0 = p.addNewLine();
+    l0.setInstructionIndex(0); // AddPrimitiveType<double>
+    l0.setOperand(0, 1, 3);    // 4th double of the 1D array
+    l0.setOperand(1, 2, 5);    // 6th double of the 2D array
+    l0.setDestinationIndex(0);
+    p.identifyIntrons();
+    Program::CompiledProgram compiled(p);
+
+    Program::NativeProgram* native;
+    ASSERT_NO_THROW(native = new Program::NativeProgram(compiled))
+        << "Construction of a NativeProgram failed.";
+    ASSERT_EQ(&native->getCompiledProgram(), &compiled)
+        << "NativeProgram does not reference its CompiledProgram.";
+    ASSERT_EQ(native->isNative(), Program::NativeProgram::isPlatformSupported())
+        << "Program with only AddPrimitiveType<double> should be translated "
+           "on supported platforms.";
+    if (native->isNative()) {
+        ASSERT_EQ(native->getDataSources().size(), 2)
+            << "Incorrect number of data source ranges.";
+        ASSERT_EQ(native->getDataSources().at(0).dataSourceIndex, 1)
+            << "Incorrect data source index of a range.";
+        ASSERT_EQ(native->getDataSources().at(0).minLocation, 3)
+            << "Incorrect min location of a range.";
+        ASSERT_EQ(native->getDataSources().at(1).maxLocation, 5)
+            << "Incorrect max location of a range.";
+    }
+    ASSERT_NO_THROW(delete native) << "Destruction failed.";
+}
+
+TEST_F(NativeProgramTest, IsInstructionSupported)
+{
+    const bool supported = Program::NativeProgram::isPlatformSupported();
+    for (uint64_t i = 0; i < set.getNbInstructions(); i++) {
+        ASSERT_EQ(Program::NativeProgram::isInstructionSupported(
+                      set.getInstruction(i)),
+                  supported)
+            << "Instruction " << i << " should be supported.";
+    }
+    ASSERT_FALSE(Program::NativeProgram::isInstructionSupported(
+        unsupportedSet.getInstruction(1)))
+        << "Instruction without declared operation should not be supported.";
+}
+
+TEST_F(NativeProgramTest, ExecuteRandomPrograms)
+{
+    Mutator::RNG rng(42);
+    Program::ProgramExecutionEngine progExecEng(*e);
+
+    uint64_t nbNative = 0;
+    for (int i = 0; i < 100; i++) {
+        Program::Program p(*e);
+        Mutator::ProgramMutator::initRandomProgram(p, params, rng);
+        Program::CompiledProgram compiled(p);
+        Program::NativeProgram native(compiled);
+        nbNative += native.isNative() ? 1 : 0;
+
+        for (int j = 0; j < 4; j++) {
+            randomizeData(rng);
+            double expected = progExecEng.executeCompiledProgram(compiled);
+            double result = progExecEng.executeNativeProgram(native);
+            ASSERT_TRUE(isIdentical(result, expected))
+                << "Native execution of random Program " << i
+                << " differs from its interpretation: " << result
+                << " instead of " << expected << ".";
+        }
+    }
+
+    if (Program::NativeProgram::isPlatformSupported()) {
+        ASSERT_EQ(nbNative, 100)
+            << "All random Programs should be translated into native code.";
+    }
+}
+
+/// PrimitiveTypeArray not exposing its data as contiguous.
+class NonContiguousArray : public Data::PrimitiveTypeArray<double>
+{
+  public:
+    using Data::PrimitiveTypeArray<double>::PrimitiveTypeArray;
+
+    const void* getContiguousData(const std::type_info& type) const override
+    {
+        return nullptr;
+    }
+};
+
+TEST_F(NativeProgramTest, NonContiguousDataSource)
+{
+    NonContiguousArray data(16);
+    for (uint64_t i = 0; i < 16; i++) {
+        data.setDataAt(typeid(double), i, (double)i + 0.5);
+    }
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources{
+        data};
+    Environment env(set, dataSources, 8, 0);
+    Program::ProgramExecutionEngine progExecEng(env);
+
+    Program::Program p(env);
+    Program::Line& l0 = p.addNewLine();
+    l0.setInstructionIndex(0); // AddPrimitiveType<double>
+    l0.setOperand(0, 1, 3);
+    l0.setOperand(1, 1, 12);
+    l0.setDestinationIndex(0);
+    p.identifyIntrons();
+    Program::CompiledProgram compiled(p);
+    Program::NativeProgram native(compiled);
+
+    ASSERT_EQ(progExecEng.executeNativeProgram(native), 16.0)
+        << "Data source without contiguous data should be interpreted.";
+}
+
+TEST_F(NativeProgramTest, InconsistentPrintTemplate)
+{
+    ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+        .setDataAt(typeid(double), 3, 5.0);
+    ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+        .setDataAt(typeid(double), 12, 1.5);
+
+    // The print template of the Instruction does not match its lambda.
+#ifdef CODE_GENERATION
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; }, "$0 = $1 + $2;");
+#else
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+#endif // CODE_GENERATION
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::Set inconsistentSet;
+    inconsistentSet.add(sub);
+    inconsistentSet.add(add);
+    Environment env(inconsistentSet, vect, 8, 0);
+    Program::ProgramExecutionEngine progExecEng(env);
+
+    Program::Program p(env);
+    Program::Line& l0 = p.addNewLine();
+    l0.setInstructionIndex(0);
+    l0.setOperand(0, 1, 3);
+    l0.setOperand(1, 1, 12);
+    l0.setDestinationIndex(0);
+    p.identifyIntrons();
+    Program::CompiledProgram compiled(p);
+    Program::NativeProgram native(compiled);
+
+    ASSERT_FALSE(Program::NativeProgram::isInstructionSupported(sub))
+        << "Instruction should not be identified from its print template.";
+    ASSERT_FALSE(native.isNative())
+        << "Program with an inconsistent print template should not be "
+           "native.";
+    ASSERT_EQ(progExecEng.executeNativeProgram(native), 3.5)
+        << "Result of the Program should follow the lambda of the "
+           "Instruction.";
+}
+
+TEST_F(NativeProgramTest, Fallback)
+{
+    Mutator::RNG rng(0);
+    Program::ProgramExecutionEngine progExecEng(*unsupportedEnv);
+    randomizeData(rng);
+
+    Program::Program p(*unsupportedEnv);
+    Program::Line& l0 = p.addNewLine();
+    l0.setInstructionIndex(1); // Lambda without declared operation
+    l0.setOperand(0, 1, 2);
+    l0.setDestinationIndex(1);
+    Program::Line& l1 = p.addNewLine();
+    l1.setInstructionIndex(0); // AddPrimitiveType<double>
+    l1.setOperand(0, 0, 1);
+    l1.setOperand(1, 2, 7);
+    l1.setDestinationIndex(0);
+    p.identifyIntrons();
+    Program::CompiledProgram compiled(p);
+    Program::NativeProgram native(compiled);
+
+    ASSERT_FALSE(native.isNative())
+        << "Program with an unsupported Instruction should not be native.";
+    ASSERT_THROW(native.execute(nullptr, nullptr), std::runtime_error)
+        << "Executing a non-native NativeProgram should fail.";
+    ASSERT_EQ(progExecEng.executeNativeProgram(native),
+              progExecEng.executeCompiledProgram(compiled))
+        << "Non-native Program should be interpreted.";
+
+    // Invalid line
+    Program::Line& l2 = p.addNewLine();
+    l2.setInstructionIndex(2, false);
+    Program::CompiledProgram compiled2(p);
+    Program::NativeProgram native2(compiled2);
+    ASSERT_FALSE(native2.isNative())
+        << "Program with an invalid line should not be native.";
+    ASSERT_THROW(progExecEng.executeNativeProgram(native2), std::out_of_range)
+        << "Invalid line should throw as with the interpreter.";
+}
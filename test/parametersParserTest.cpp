@@ -61,7 +61,7 @@ TEST(LearningParametersTest, readConfigFile)
         << "Ill-formed parameters file should result in no root filling";
 
     File::ParametersParser::readConfigFile(TESTS_DAT_PATH "params.json", root);
-    ASSERT_EQ(13, root.size())
+    ASSERT_EQ(14, root.size())
         << "Wrong number of elements in parsed json file";
     ASSERT_EQ(10, root["mutation"]["tpg"].size())
         << "Wrong number of elements in parsed json file";
@@ -99,6 +99,7 @@ TEST(LearningParametersTest, setAllParamsFrom)
     ASSERT_EQ(2.0, params.nbThreads);
     ASSERT_EQ(200, params.nbGenerations);
     ASSERT_EQ(true, params.doValidation);
+    ASSERT_EQ(true, params.counterBasedRNG);
     ASSERT_EQ(100, params.mutation.tpg.nbRoots);
     ASSERT_EQ(5, params.mutation.tpg.initNbRoots);
     ASSERT_EQ(3, params.mutation.tpg.maxInitOutgoingEdges);
@@ -171,6 +172,7 @@ TEST(LearningParametersTest, writeParametersToJson)
     ASSERT_EQ(params.archiveSize, params2.archiveSize);
     ASSERT_EQ(params.archivingProbability, params2.archivingProbability);
     ASSERT_EQ(params.doValidation, params2.doValidation);
+    ASSERT_EQ(params.counterBasedRNG, params2.counterBasedRNG);
     ASSERT_EQ(params.maxNbActionsPerEval, params2.maxNbActionsPerEval);
     ASSERT_EQ(params.maxNbEvaluationPerPolicy,
               params2.maxNbEvaluationPerPolicy);
@@ -0,0 +1,211 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+
+#include "data/primitiveTypeArray.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/multByConstant.h"
+#include "program/program.h"
+#include "program/programExecutionEngine.h"
+#include "tpg/tpgGraph.h"
+
+#include "tpg/policyFingerprint.h"
+
+class PolicyFingerprintTest : public ::testing::Test
+{
+  protected:
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Instructions::Set set;
+    Environment* e = NULL;
+    TPG::TPGGraph* tpg = NULL;
+
+    /// Create a Program multiplying a data by a constant.
+    std::shared_ptr<Program::Program> makeProgram(uint64_t location,
+                                                  int32_t constant)
+    {
+        auto prog = std::make_shared<Program::Program>(*e);
+        auto& line = prog->addNewLine();
+        line.setInstructionIndex(1);
+        line.setOperand(0, 2, location); // Dhandler 0
+        line.setOperand(1, 1, 0);        // CHandler at location 0
+        line.setDestinationIndex(0);
+        prog->getConstantHandler().setDataAt(typeid(Data::Constant), 0,
+                                             {constant});
+        prog->identifyIntrons();
+        return prog;
+    }
+
+    virtual void SetUp()
+    {
+        vect.push_back(*(new Data::PrimitiveTypeArray<double>(8)));
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        set.add(*(new Instructions::MultByConstant<double>()));
+        set.add(*(new Instructions::LambdaInstruction<const Data::Constant[2]>(
+            [](const Data::Constant a[2]) {
+                return (double)a[0] + (double)a[1];
+            })));
+        e = new Environment(set, vect, 8, 2);
+        tpg = new TPG::TPGGraph(*e);
+    }
+
+    virtual void TearDown()
+    {
+        delete tpg;
+        delete e;
+        delete (&(vect.at(0).get()));
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+        delete (&set.getInstruction(2));
+    }
+};
+
+TEST_F(PolicyFingerprintTest, ProgramFingerprint)
+{
+    TPG::PolicyFingerprint fingerprint;
+    auto prog0 = makeProgram(3, 2);
+    auto prog1 = makeProgram(3, 2);
+    auto prog2 = makeProgram(3, 5);
+    auto prog3 = makeProgram(4, 2);
+
+    ASSERT_EQ(fingerprint.getFingerprint(*prog0),
+              fingerprint.getFingerprint(*prog1))
+        << "Identical programs should have the same fingerprint.";
+    ASSERT_NE(fingerprint.getFingerprint(*prog0),
+              fingerprint.getFingerprint(*prog2))
+        << "Programs using different constants should have different "
+           "fingerprints.";
+    ASSERT_NE(fingerprint.getFingerprint(*prog0),
+              fingerprint.getFingerprint(*prog3))
+        << "Programs reading different data should have different "
+           "fingerprints.";
+
+    // Add an intron line to prog1: writes a register that is never read.
+    auto& line = prog1->addNewLine();
+    line.setInstructionIndex(0);
+    line.setOperand(0, 2, 1);
+    line.setOperand(1, 2, 2);
+    line.setDestinationIndex(3);
+    prog1->identifyIntrons();
+    fingerprint.clear();
+    ASSERT_EQ(fingerprint.getFingerprint(*prog0),
+              fingerprint.getFingerprint(*prog1))
+        << "Intron lines should not change the fingerprint of a program.";
+}
+
+TEST_F(PolicyFingerprintTest, ProgramFingerprintConstantArray)
+{
+    // Programs summing two consecutive constants.
+    auto makeSumProgram = [this](int32_t c0, int32_t c1) {
+        auto prog = std::make_shared<Program::Program>(*e);
+        auto& line = prog->addNewLine();
+        line.setInstructionIndex(2);
+        line.setOperand(0, 1, 0); // Constant[2] at location 0
+        line.setDestinationIndex(0);
+        prog->getConstantHandler().setDataAt(typeid(Data::Constant), 0, {c0});
+        prog->getConstantHandler().setDataAt(typeid(Data::Constant), 1, {c1});
+        prog->identifyIntrons();
+        return prog;
+    };
+
+    Program::ProgramExecutionEngine progExecEng(*e);
+    auto prog0 = makeSumProgram(1, 2);
+    auto prog1 = makeSumProgram(1, 50);
+    auto prog2 = makeSumProgram(1, 2);
+    progExecEng.setProgram(*prog0);
+    ASSERT_EQ(progExecEng.executeProgram(), 3.0);
+    progExecEng.setProgram(*prog1);
+    ASSERT_EQ(progExecEng.executeProgram(), 51.0);
+
+    TPG::PolicyFingerprint fingerprint;
+    ASSERT_NE(fingerprint.getFingerprint(*prog0),
+              fingerprint.getFingerprint(*prog1))
+        << "Programs differing by any Constant read by an array operand "
+           "should have different fingerprints.";
+    ASSERT_EQ(fingerprint.getFingerprint(*prog0),
+              fingerprint.getFingerprint(*prog2))
+        << "Identical programs should have the same fingerprint.";
+}
+
+TEST_F(PolicyFingerprintTest, VertexFingerprint)
+{
+    // (T= Team, A= Action)
+    //
+    // T0 -> A0, A1
+    // T1 -> A0, A1 (distinct but identical programs)
+    // T2 -> A1, A0 (same programs, other order)
+    // T3 -> T1, A1
+    for (int i = 0; i < 4; i++) {
+        tpg->addNewTeam();
+    }
+    tpg->addNewAction(0);
+    tpg->addNewAction(1);
+    auto v = tpg->getVertices();
+    auto progA = makeProgram(0, 1);
+    auto progB = makeProgram(1, 1);
+    tpg->addNewEdge(*v.at(0), *v.at(4), progA);
+    tpg->addNewEdge(*v.at(0), *v.at(5), progB);
+    tpg->addNewEdge(*v.at(1), *v.at(4), makeProgram(0, 1));
+    tpg->addNewEdge(*v.at(1), *v.at(5), makeProgram(1, 1));
+    tpg->addNewEdge(*v.at(2), *v.at(5), progB);
+    tpg->addNewEdge(*v.at(2), *v.at(4), progA);
+    tpg->addNewEdge(*v.at(3), *v.at(1), progA);
+    tpg->addNewEdge(*v.at(3), *v.at(5), progB);
+
+    TPG::PolicyFingerprint fingerprint;
+    ASSERT_NE(fingerprint.getFingerprint(*v.at(4)),
+              fingerprint.getFingerprint(*v.at(5)))
+        << "Actions with different IDs should have different fingerprints.";
+    ASSERT_EQ(fingerprint.getFingerprint(*v.at(0)),
+              fingerprint.getFingerprint(*v.at(1)))
+        << "Teams with identical subgraphs should have the same fingerprint.";
+    ASSERT_NE(fingerprint.getFingerprint(*v.at(0)),
+              fingerprint.getFingerprint(*v.at(2)))
+        << "Order of outgoing edges should change the fingerprint.";
+    ASSERT_NE(fingerprint.getFingerprint(*v.at(0)),
+              fingerprint.getFingerprint(*v.at(3)))
+        << "Teams with different subgraphs should have different "
+           "fingerprints.";
+    ASSERT_FALSE(fingerprint.hasCycle()) << "No cycle should be detected.";
+
+    // Create a cycle T1 -> T3 -> T1
+    tpg->addNewEdge(*v.at(1), *v.at(3), progB);
+    fingerprint.clear();
+    fingerprint.getFingerprint(*v.at(3));
+    ASSERT_TRUE(fingerprint.hasCycle()) << "Cycle should be detected.";
+    fingerprint.clear();
+    fingerprint.getFingerprint(*v.at(0));
+    ASSERT_FALSE(fingerprint.hasCycle())
+        << "Clear should reset the cycle detection.";
+}
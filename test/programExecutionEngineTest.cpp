@@ -46,6 +46,7 @@
 #include "instructions/lambdaInstruction.h"
 #include "instructions/multByConstant.h"
 #include "instructions/set.h"
+#include "program/compiledProgram.h"
 #include "program/line.h"
 #include "program/program.h"
 #include "program/programExecutionEngine.h"
@@ -262,3 +263,118 @@ TEST_F(ProgramExecutionEngineTest, execute)
     ASSERT_EQ(result, r0) << "Result of the program from Fixture, with an "
                              "additional ignored line, is not as expected.";
 }
+
+TEST_F(ProgramExecutionEngineTest, compiledProgram)
+{
+    Program::CompiledProgram* compiled;
+    ASSERT_NO_THROW(compiled = new Program::CompiledProgram(*p))
+        << "Compilation of the Program from fixture failed.";
+
+    ASSERT_EQ(&compiled->getProgram(), p)
+        << "CompiledProgram does not reference its Program.";
+    ASSERT_EQ(compiled->getLines().size(), 4)
+        << "Intron line should not be part of the CompiledProgram.";
+    ASSERT_EQ(compiled->getOperands().size(), 7)
+        << "Incorrect number of operands in the CompiledProgram.";
+    ASSERT_EQ(compiled->getMaxNbOperands(), 2)
+        << "Incorrect maximum number of operands in the CompiledProgram.";
+
+    // Operand location of the 2nd line are scaled at compilation.
+    const Program::CompiledProgram::CompiledOperand& op =
+        compiled->getOperands().at(compiled->getLines().at(1).firstOperand);
+    ASSERT_EQ(op.dataSourceIndex, 0)
+        << "Incorrect data source for a compiled operand.";
+    ASSERT_EQ(op.location, 5) << "Incorrect location for a compiled operand.";
+    ASSERT_EQ(*op.type, typeid(double))
+        << "Incorrect type for a compiled operand.";
+
+    ASSERT_NO_THROW(delete compiled) << "Destruction failed.";
+}
+
+TEST_F(ProgramExecutionEngineTest, executeCompiledProgram)
+{
+    Program::ProgramExecutionEngine progExecEng(*p);
+    double result;
+
+    double r0 = progExecEng.executeProgram();
+
+    Program::CompiledProgram compiled(*p);
+    ASSERT_NO_THROW(result = progExecEng.executeCompiledProgram(compiled))
+        << "CompiledProgram from fixture failed to execute.";
+    ASSERT_EQ(result, r0) << "Result of the CompiledProgram differs from the "
+                             "result of the interpreted Program.";
+
+    // Execution with an engine whose current Program is different.
+    Program::Program p2(*e);
+    Program::ProgramExecutionEngine progExecEng2(p2);
+    ASSERT_EQ(progExecEng2.executeCompiledProgram(compiled), r0)
+        << "Result of the CompiledProgram differs when executed by an engine "
+           "with a different current Program.";
+
+    // Introduce a new line in the program to test the throw
+    Program::Line& l5 = p->addNewLine();
+    l5.setInstructionIndex(4, false);
+    Program::CompiledProgram compiled2(*p);
+    ASSERT_THROW(progExecEng.executeCompiledProgram(compiled2),
+                 std::out_of_range)
+        << "CompiledProgram line using a incorrect Instruction index should "
+           "throw an exception.";
+    ASSERT_NO_THROW(result =
+                        progExecEng.executeCompiledProgram(compiled2, true))
+        << "CompiledProgram line using a incorrect Instruction index should "
+           "not interrupt the Execution when ignored.";
+    ASSERT_EQ(result, r0) << "Result of the CompiledProgram, with an "
+                             "additional ignored line, is not as expected.";
+}
+
+TEST_F(ProgramExecutionEngineTest, executeCompiledProgramBatch)
+{
+    Program::ProgramExecutionEngine progExecEng(*p);
+    Program::CompiledProgram compiled(*p);
+    double r0 = progExecEng.executeProgram();
+
+    // Create copies of the data sources with a different value.
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect2;
+    for (const auto& dataHandler : vect) {
+        vect2.push_back(*dataHandler.get().clone());
+    }
+    ((Data::PrimitiveTypeArray<double>&)vect2.at(1).get())
+        .setDataAt(typeid(double), 25, value0 + 1.0);
+    progExecEng.setDataSources(vect2);
+    double r1 = progExecEng.executeProgram();
+    progExecEng.setDataSources(vect);
+
+    std::vector<std::reference_wrapper<
+        const std::vector<std::reference_wrapper<const Data::DataHandler>>>>
+        dataSourcesSets{vect2, vect, vect2};
+    std::vector<double> results;
+    ASSERT_NO_THROW(
+        progExecEng.executeCompiledProgramBatch(compiled, dataSourcesSets,
+                                                results))
+        << "Batch execution of the CompiledProgram failed.";
+    ASSERT_EQ(results.size(), 3) << "Incorrect number of results.";
+    ASSERT_EQ(results.at(0), r1) << "Batch result differs from the result of "
+                                    "the interpreted Program.";
+    ASSERT_EQ(results.at(1), r0) << "Batch result differs from the result of "
+                                    "the interpreted Program.";
+    ASSERT_EQ(results.at(2), r1) << "Batch result differs from the result of "
+                                    "the interpreted Program.";
+
+    // Data sources of the engine are restored.
+    ASSERT_EQ(progExecEng.executeCompiledProgram(compiled), r0)
+        << "Data sources of the engine were not restored after the batch "
+           "execution.";
+
+    // Incompatible data sources
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect3{
+        vect.at(0), vect.at(1)};
+    dataSourcesSets.push_back(vect3);
+    ASSERT_THROW(progExecEng.executeCompiledProgramBatch(
+                     compiled, dataSourcesSets, results),
+                 std::runtime_error)
+        << "Batch execution with incompatible data sources should fail.";
+
+    for (const auto& dataHandler : vect2) {
+        delete &dataHandler.get();
+    }
+}
@@ -204,6 +204,49 @@ TEST_F(ProgramTest, CopyConstructor)
         << "Line operand.location value was not copied on Program copy.";
 }
 
+TEST_F(ProgramTest, ProgramLinesStorage)
+{
+    Program::Program p(*e);
+    for (auto i = 0; i < 20; i++) {
+        Program::Line& l = p.addNewLine();
+        l.setInstructionIndex(i % 2);
+        l.setDestinationIndex(i % 8);
+        l.setOperand(0, 1, i);
+    }
+
+    // Lines of a copied Program are stored contiguously, in order.
+    Program::Program p1(p);
+    const ptrdiff_t stride = (const char*)&p1.getLine(1) -
+                             (const char*)&p1.getLine(0);
+    for (auto i = 1; i < 20; i++) {
+        ASSERT_EQ((const char*)&p1.getLine(i) - (const char*)&p1.getLine(i - 1),
+                  stride)
+            << "Lines of a copied Program should be stored contiguously.";
+        ASSERT_EQ(p1.getLine(i), p.getLine(i))
+            << "Copied line differs from the original one.";
+    }
+
+    // References to lines remain valid when adding and removing lines.
+    Program::Line& l5 = p1.getLine(5);
+    p1.removeLine(2);
+    p1.addNewLine(0);
+    p1.addNewLine();
+    ASSERT_EQ(&p1.getLine(5), &l5)
+        << "Reference to a Line should remain valid when other lines are "
+           "added or removed.";
+    ASSERT_EQ(l5.getOperand(0).second, 5)
+        << "Line was modified by the addition or removal of other lines.";
+
+    // Lines added in the slot of a removed line are zero-filled.
+    const Program::Line& added = p1.getLine(0);
+    ASSERT_EQ(added.getInstructionIndex(), 0)
+        << "New line should be zero-filled.";
+    ASSERT_EQ(added.getDestinationIndex(), 0)
+        << "New line should be zero-filled.";
+    ASSERT_EQ(added.getOperand(0).second, 0)
+        << "New line should be zero-filled.";
+}
+
 TEST_F(ProgramTest, ProgramSwapLines)
 {
     Program::Program p(*e);
@@ -0,0 +1,109 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include "util/threadPool.h"
+
+TEST(ThreadPoolTest, Constructor)
+{
+    Util::ThreadPool* pool = nullptr;
+    ASSERT_NO_THROW(pool = new Util::ThreadPool(4))
+        << "Construction of a ThreadPool failed.";
+    ASSERT_EQ(pool->getNbThreads(), 4) << "Incorrect number of threads.";
+    ASSERT_NO_THROW(delete pool) << "Destruction of a ThreadPool failed.";
+
+    Util::ThreadPool sequentialPool(0);
+    ASSERT_EQ(sequentialPool.getNbThreads(), 1)
+        << "A ThreadPool should have at least one thread.";
+}
+
+TEST(ThreadPoolTest, ParallelFor)
+{
+    Util::ThreadPool pool(4);
+    const uint64_t nbJobs = 1000;
+
+    // Run several batches to check the reuse of threads.
+    for (auto batch = 0; batch < 3; batch++) {
+        std::vector<uint64_t> results(nbJobs, 0);
+        std::atomic<uint64_t> nbExecutions(0);
+        std::atomic<bool> threadIdxOk(true);
+
+        ASSERT_NO_THROW(
+            pool.parallelFor(nbJobs, [&](uint64_t jobIdx, uint64_t threadIdx) {
+                results.at(jobIdx) = jobIdx * jobIdx;
+                nbExecutions++;
+                if (threadIdx >= pool.getNbThreads()) {
+                    threadIdxOk = false;
+                }
+            }))
+            << "Execution of a batch of jobs failed.";
+
+        ASSERT_EQ(nbExecutions, nbJobs)
+            << "Each job should be executed exactly once.";
+        ASSERT_TRUE(threadIdxOk) << "Thread index out of range.";
+        for (uint64_t i = 0; i < nbJobs; i++) {
+            ASSERT_EQ(results.at(i), i * i) << "Job " << i << " not executed.";
+        }
+    }
+
+    // Empty batch
+    ASSERT_NO_THROW(pool.parallelFor(0, [](uint64_t, uint64_t) {}))
+        << "Execution of an empty batch of jobs failed.";
+}
+
+TEST(ThreadPoolTest, ParallelForException)
+{
+    Util::ThreadPool pool(3);
+    std::atomic<uint64_t> nbExecutions(0);
+
+    ASSERT_THROW(pool.parallelFor(100,
+                                  [&](uint64_t jobIdx, uint64_t) {
+                                      nbExecutions++;
+                                      if (jobIdx == 42) {
+                                          throw std::runtime_error("Job 42");
+                                      }
+                                  }),
+                 std::runtime_error)
+        << "Exception thrown by a job should be rethrown by parallelFor.";
+
+    // The pool remains usable after an exception.
+    nbExecutions = 0;
+    ASSERT_NO_THROW(pool.parallelFor(
+        100, [&](uint64_t, uint64_t) { nbExecutions++; }))
+        << "ThreadPool should remain usable after an exception.";
+    ASSERT_EQ(nbExecutions, 100) << "Each job should be executed once.";
+}
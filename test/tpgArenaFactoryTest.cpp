@@ -0,0 +1,333 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+
+#include "data/primitiveTypeArray.h"
+#include "environment.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "program/program.h"
+
+#include "tpg/tpgArenaFactory.h"
+#include "tpg/tpgGraph.h"
+
+class TPGArenaFactoryTest : public ::testing::Test
+{
+  protected:
+    const size_t size1{24};
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Instructions::Set set;
+    Environment* e = NULL;
+
+    virtual void SetUp()
+    {
+        vect.push_back(
+            *(new Data::PrimitiveTypeArray<double>((unsigned int)size1)));
+
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        auto minus = [](double a, double b) -> double { return a - b; };
+        set.add(*(new Instructions::LambdaInstruction<double, double>(minus)));
+
+        e = new Environment(set, vect, 8, 5);
+    }
+
+    virtual void TearDown()
+    {
+        delete e;
+        delete (&(vect.at(0).get()));
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+    }
+};
+
+TEST_F(TPGArenaFactoryTest, TPGArenaAllocateDeallocate)
+{
+    TPG::TPGArena arena;
+    void* ptr0 = NULL;
+    void* ptr1 = NULL;
+
+    ASSERT_NO_THROW(ptr0 = arena.allocate(40))
+        << "Allocation in a TPGArena should not fail.";
+    ASSERT_NO_THROW(ptr1 = arena.allocate(48))
+        << "Allocation in a TPGArena should not fail.";
+    ASSERT_NE(ptr0, ptr1) << "Two live slots should not overlap.";
+    ASSERT_EQ((uintptr_t)ptr0 % TPG::TPGArena::SLOT_ALIGNMENT, 0)
+        << "Slots of the TPGArena should be aligned.";
+    ASSERT_EQ(arena.getNbUsedSlots(), 2)
+        << "Incorrect number of used slots in the TPGArena.";
+    ASSERT_EQ(arena.getNbBlocks(), 1)
+        << "Slots of the same size class should share their block.";
+
+    ASSERT_NO_THROW(arena.deallocate(ptr0, 40))
+        << "Deallocation in a TPGArena should not fail.";
+    ASSERT_EQ(arena.getNbUsedSlots(), 1)
+        << "Incorrect number of used slots in the TPGArena.";
+    ASSERT_EQ(arena.getNbFreeSlots(), 1)
+        << "Incorrect number of free slots in the TPGArena.";
+
+    // The freed slot is recycled by the next allocation of the same class.
+    ASSERT_EQ(arena.allocate(33), ptr0)
+        << "A freed slot should be reused by the TPGArena.";
+    ASSERT_EQ(arena.getNbFreeSlots(), 0)
+        << "Incorrect number of free slots in the TPGArena.";
+
+    // Another size class uses another block.
+    void* ptr2 = arena.allocate(200);
+    ASSERT_EQ(arena.getNbBlocks(), 2)
+        << "A new size class should allocate a new block.";
+    arena.deallocate(ptr2, 200);
+
+    // Large allocations are not pooled.
+    void* ptr3 = arena.allocate(TPG::TPGArena::MAX_SLOT_SIZE + 1);
+    ASSERT_EQ(arena.getNbUsedSlots(), 2)
+        << "Large allocations should not be counted in the TPGArena.";
+    ASSERT_NO_THROW(arena.deallocate(ptr3, TPG::TPGArena::MAX_SLOT_SIZE + 1))
+        << "Deallocation of a large allocation should not fail.";
+
+    arena.deallocate(ptr0, 40);
+    arena.deallocate(ptr1, 48);
+    ASSERT_EQ(arena.getNbUsedSlots(), 0)
+        << "Incorrect number of used slots in the TPGArena.";
+}
+
+TEST_F(TPGArenaFactoryTest, TPGArenaThreadCaches)
+{
+    TPG::TPGArena arena;
+    const size_t nbSlots = 3 * TPG::TPGArena::THREAD_CACHE_CAPACITY;
+    std::vector<void*> slots(nbSlots);
+
+    // Freeing more slots than the cache capacity gives some back to the pool.
+    for (size_t i = 0; i < nbSlots; i++) {
+        slots[i] = arena.allocate(64);
+    }
+    for (void* slot : slots) {
+        arena.deallocate(slot, 64);
+    }
+    ASSERT_EQ(arena.getNbFreeSlots(), nbSlots)
+        << "Slots in the pools and in the caches should all be free.";
+
+    // All of them are reused before a new block is allocated.
+    std::set<void*> reused;
+    for (size_t i = 0; i < nbSlots; i++) {
+        reused.insert(arena.allocate(64));
+    }
+    ASSERT_EQ(reused, std::set<void*>(slots.begin(), slots.end()))
+        << "Slots freed in the pool and in the cache should be reused.";
+    ASSERT_EQ(arena.getNbBlocks(), 1)
+        << "No block should be allocated while free slots remain.";
+    for (void* slot : reused) {
+        arena.deallocate(slot, 64);
+    }
+
+    // Concurrent allocations and deallocations from several threads.
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++) {
+        threads.emplace_back([&arena, t]() {
+            std::vector<size_t*> threadSlots(100);
+            for (size_t iter = 0; iter < 100; iter++) {
+                for (size_t i = 0; i < threadSlots.size(); i++) {
+                    threadSlots[i] = static_cast<size_t*>(
+                        arena.allocate(16 * (1 + (i % 8))));
+                    *threadSlots[i] = t * 1000 + i;
+                }
+                for (size_t i = 0; i < threadSlots.size(); i++) {
+                    // Slots handed out to other threads do not overlap.
+                    ASSERT_EQ(*threadSlots[i], t * 1000 + i);
+                    arena.deallocate(threadSlots[i], 16 * (1 + (i % 8)));
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(arena.getNbUsedSlots(), 0)
+        << "Incorrect number of used slots in the TPGArena.";
+}
+
+TEST_F(TPGArenaFactoryTest, TPGArenaFactory)
+{
+    TPG::TPGArenaFactory factory;
+    const std::shared_ptr<TPG::TPGArena>& arena = factory.getArena();
+
+    TPG::TPGVertex* team = NULL;
+    TPG::TPGVertex* action = NULL;
+    std::shared_ptr<Program::Program> prog;
+    std::unique_ptr<TPG::TPGEdge> edge;
+
+    ASSERT_NO_THROW(team = factory.createTPGTeam())
+        << "Creation of a TPGTeam with a TPGArenaFactory failed.";
+    ASSERT_NE(dynamic_cast<TPG::TPGTeam*>(team), nullptr)
+        << "TPGArenaFactory should create a TPGTeam.";
+    ASSERT_NO_THROW(action = factory.createTPGAction(3))
+        << "Creation of a TPGAction with a TPGArenaFactory failed.";
+    ASSERT_EQ(dynamic_cast<TPG::TPGAction*>(action)->getActionID(), 3)
+        << "TPGAction created by a TPGArenaFactory has an incorrect ID.";
+    ASSERT_NO_THROW(prog = factory.createProgram(*e))
+        << "Creation of a Program with a TPGArenaFactory failed.";
+    prog->addNewLine();
+    ASSERT_NO_THROW(edge = factory.createTPGEdge(team, action, prog))
+        << "Creation of a TPGEdge with a TPGArenaFactory failed.";
+    ASSERT_EQ(&edge->getProgram(), prog.get())
+        << "TPGEdge created by a TPGArenaFactory has an incorrect Program.";
+
+    std::shared_ptr<Program::Program> progCopy;
+    ASSERT_NO_THROW(progCopy = factory.createProgram(*prog))
+        << "Copy of a Program with a TPGArenaFactory failed.";
+    ASSERT_EQ(progCopy->getNbLines(), 1)
+        << "Program copied by a TPGArenaFactory has an incorrect content.";
+
+    ASSERT_EQ(arena->getNbUsedSlots(), 5)
+        << "Elements created by the TPGArenaFactory should be allocated in "
+           "its TPGArena.";
+
+    // Deleting elements gives their slot back to the TPGArena
+    void* teamAddress = team;
+    ASSERT_NO_THROW(edge.reset())
+        << "Deletion of a TPGEdge from a TPGArenaFactory failed.";
+    ASSERT_NO_THROW(delete action)
+        << "Deletion of a TPGAction from a TPGArenaFactory failed.";
+    ASSERT_NO_THROW(delete team)
+        << "Deletion of a TPGTeam from a TPGArenaFactory failed.";
+    prog.reset();
+    progCopy.reset();
+    ASSERT_EQ(arena->getNbUsedSlots(), 0)
+        << "Deleted elements should be given back to the TPGArena.";
+
+    // Storage of deleted elements is recycled
+    team = factory.createTPGTeam();
+    ASSERT_EQ((void*)team, teamAddress)
+        << "TPGArenaFactory should recycle the storage of deleted elements.";
+    delete team;
+}
+
+#ifndef NDEBUG
+TEST_F(TPGArenaFactoryTest, TPGArenaDestroyedBeforeElements)
+{
+    ASSERT_DEATH(
+        {
+            TPG::TPGArenaFactory factory;
+            factory.createTPGTeam();
+        },
+        "TPGArena destroyed before the elements allocated in it")
+        << "Destroying a TPGArena before its elements should fail in debug "
+           "builds.";
+}
+#endif // NDEBUG
+
+TEST_F(TPGArenaFactoryTest, TPGGraphWithTPGArenaFactory)
+{
+    std::shared_ptr<TPG::TPGArena> arena;
+    std::shared_ptr<TPG::TPGGraph> tpg;
+    {
+        TPG::TPGArenaFactory factory;
+        arena = factory.getArena();
+        tpg = factory.createTPGGraph(*e);
+    }
+
+    ASSERT_NE(dynamic_cast<const TPG::TPGArenaFactory*>(&tpg->getFactory()),
+              nullptr)
+        << "TPGGraph created by a TPGArenaFactory should use a "
+           "TPGArenaFactory.";
+    ASSERT_EQ(dynamic_cast<const TPG::TPGArenaFactory&>(tpg->getFactory())
+                  .getArena(),
+              arena)
+        << "TPGGraph should share the TPGArena of the TPGArenaFactory.";
+
+    const TPG::TPGVertex& team = tpg->addNewTeam();
+    const TPG::TPGVertex& action = tpg->addNewAction(0);
+    std::shared_ptr<Program::Program> prog =
+        tpg->getFactory().createProgram(*e);
+    tpg->addNewEdge(team, action, prog);
+    prog.reset();
+    ASSERT_EQ(arena->getNbUsedSlots(), 4)
+        << "Elements of the TPGGraph should be allocated in its TPGArena.";
+
+    tpg->removeVertex(team);
+    ASSERT_EQ(arena->getNbUsedSlots(), 1)
+        << "Elements removed from the TPGGraph should be given back to the "
+           "TPGArena.";
+
+    // The TPGGraph keeps the arena alive until its elements are deleted.
+    std::weak_ptr<TPG::TPGArena> weakArena = arena;
+    arena.reset();
+    ASSERT_FALSE(weakArena.expired())
+        << "TPGArena should outlive the TPGGraph elements.";
+    ASSERT_NO_THROW(tpg.reset()) << "Destruction of a TPGGraph failed.";
+    ASSERT_TRUE(weakArena.expired())
+        << "TPGArena should be released with the last TPGGraph element.";
+}
+
+TEST_F(TPGArenaFactoryTest, TPGGraphMoveWithTPGArenaFactory)
+{
+    std::weak_ptr<TPG::TPGArena> weakArena;
+    std::unique_ptr<TPG::TPGGraph> target =
+        std::make_unique<TPG::TPGGraph>(*e);
+    {
+        TPG::TPGArenaFactory factory;
+        weakArena = factory.getArena();
+        std::shared_ptr<TPG::TPGGraph> source = factory.createTPGGraph(*e);
+        const TPG::TPGVertex& team = source->addNewTeam();
+        const TPG::TPGVertex& action = source->addNewAction(0);
+        source->addNewEdge(team, action,
+                           source->getFactory().createProgram(*e));
+
+        // Elements are moved to a TPGGraph built with another TPGFactory,
+        // and the source TPGGraph is destroyed.
+        ASSERT_NO_THROW(*target = std::move(*source))
+            << "Move of a TPGGraph with a TPGArenaFactory failed.";
+    }
+
+    ASSERT_FALSE(weakArena.expired())
+        << "TPGArena should follow its elements in the TPGGraph they are "
+           "moved to.";
+    ASSERT_NE(
+        dynamic_cast<const TPG::TPGArenaFactory*>(&target->getFactory()),
+        nullptr)
+        << "TPGGraph should get the TPGFactory of the moved elements.";
+    ASSERT_EQ(weakArena.lock()->getNbUsedSlots(), 4)
+        << "Moved elements should still be allocated in their TPGArena.";
+
+    // New elements of the TPGGraph go to the same TPGArena.
+    target->addNewTeam();
+    ASSERT_EQ(weakArena.lock()->getNbUsedSlots(), 5)
+        << "Elements added after the move should use the same TPGArena.";
+
+    ASSERT_NO_THROW(target.reset()) << "Destruction of a TPGGraph failed.";
+    ASSERT_TRUE(weakArena.expired())
+        << "TPGArena should be released with the last TPGGraph element.";
+}
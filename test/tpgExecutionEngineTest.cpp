@@ -35,6 +35,7 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <cstring>
 #include <gtest/gtest.h>
 
 #include "data/dataHandler.h"
@@ -223,6 +224,32 @@ TEST_F(TPGExecutionEngineTest, EvaluateTeam)
         << "Edge selected during team evaluation is incorrect.";
 }
 
+TEST_F(TPGExecutionEngineTest, EvaluateTeamBids)
+{
+    TPG::TPGExecutionEngine tpee(*e);
+    const TPG::TPGTeam& team = *(const TPG::TPGTeam*)(tpg->getVertices().at(1));
+
+    std::vector<double> bids;
+    ASSERT_NO_THROW(tpee.evaluateTeamBids(team, bids))
+        << "Evaluation of the bids of a valid TPGTeam failed.";
+    ASSERT_EQ(bids.size(), 4) << "Incorrect number of bids for the TPGTeam.";
+    const std::vector<double> expectedBids{5, 9, 6, 3};
+    for (auto idx = 0; idx < bids.size(); idx++) {
+        ASSERT_NEAR(bids.at(idx), expectedBids.at(idx), PARAM_FLOAT_PRECISION)
+            << "Incorrect bid for the " << idx << "th outgoing edge.";
+    }
+
+    // With equal bids, the last edge is selected
+    makeProgramReturn(*progPointers.at(7), 9);
+    ASSERT_EQ(&tpee.evaluateTeam(team), edges.at(7))
+        << "Edge selected during team evaluation with equal bids is incorrect.";
+
+    // Team without outgoing edge
+    const TPG::TPGTeam& emptyTeam = tpg->addNewTeam();
+    ASSERT_THROW(tpee.evaluateTeam(emptyTeam), std::runtime_error)
+        << "Evaluation of a TPGTeam without outgoing edge should fail.";
+}
+
 TEST_F(TPGExecutionEngineTest, EvaluateFromRoot)
 {
     TPG::TPGExecutionEngine tpee(*e);
@@ -246,3 +273,174 @@ TEST_F(TPGExecutionEngineTest, EvaluateFromRoot)
     ASSERT_EQ(result.at(3), tpg->getVertices().at(6))
         << "2nd element of the traversed path during execution is incorrect.";
 }
+
+TEST_F(TPGExecutionEngineTest, BidCache)
+{
+    TPG::TPGExecutionEngine tpee(*e, &a);
+    ASSERT_FALSE(tpee.isBidCacheEnabled())
+        << "Bid cache should be disabled by default.";
+    ASSERT_NO_THROW(tpee.setBidCacheEnabled(true))
+        << "Enabling the bid cache failed.";
+    ASSERT_TRUE(tpee.isBidCacheEnabled()) << "Bid cache should be enabled.";
+
+    ASSERT_NEAR(tpee.evaluateEdge(*edges.at(0)), 5, PARAM_FLOAT_PRECISION)
+        << "Evaluation of the program of an Edge failed with bid cache.";
+
+    // Change the data: the cached result is returned until cleared.
+    ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+        .setDataAt(typeid(double), 0, 2.0);
+    ASSERT_NEAR(tpee.evaluateEdge(*edges.at(0)), 5, PARAM_FLOAT_PRECISION)
+        << "Cached result of the program of an Edge was not used.";
+    ASSERT_EQ(a.getNbRecordings(), 2)
+        << "Cached evaluations should still be recorded in the archive.";
+    tpee.clearBidCache();
+    ASSERT_NEAR(tpee.evaluateEdge(*edges.at(0)), 10, PARAM_FLOAT_PRECISION)
+        << "Cleared bid cache should not be used.";
+
+    // Share a program between two edges reached by the same inference.
+    tpg->setEdgeDestination(*edges.at(7), *tpg->getVertices().at(4));
+    edges.at(7)->setProgram(progPointers.at(5));
+    std::vector<const TPG::TPGVertex*> result;
+    ASSERT_NO_THROW(result =
+                        tpee.executeFromRoot(*tpg->getRootVertices().at(0)))
+        << "Execution of a TPGGraph from a valid root failed with bid cache.";
+    TPG::TPGExecutionEngine tpeeNoCache(*e);
+    ASSERT_EQ(result,
+              tpeeNoCache.executeFromRoot(*tpg->getRootVertices().at(0)))
+        << "Traversed path differs with bid cache.";
+}
+
+TEST_F(TPGExecutionEngineTest, LaneEvaluation)
+{
+    TPG::TPGExecutionEngine tpee(*e);
+    TPG::TPGExecutionEngine tpeeRef(*e);
+    ASSERT_FALSE(tpee.isLaneEvaluationEnabled())
+        << "Lane evaluation should be disabled by default.";
+    tpee.setLaneEvaluationEnabled(true);
+    ASSERT_TRUE(tpee.isLaneEvaluationEnabled())
+        << "Lane evaluation should be enabled.";
+
+    // Programs with MultByConstant are evaluated with evaluateEdge().
+    std::vector<double> bids, expectedBids;
+    tpee.evaluateTeamBids(*(const TPG::TPGTeam*)tpg->getVertices().at(0),
+                          bids);
+    tpeeRef.evaluateTeamBids(*(const TPG::TPGTeam*)tpg->getVertices().at(0),
+                             expectedBids);
+    ASSERT_EQ(bids, expectedBids)
+        << "Bids of programs that cannot be evaluated in lanes differ.";
+
+    // A team whose 10 programs only use AddPrimitiveType<double>.
+    for (uint64_t i = 0; i < size1; i++) {
+        ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+            .setDataAt(typeid(double), i, 1.0 / (3.0 + (double)i));
+    }
+    const TPG::TPGTeam& team = tpg->addNewTeam();
+    for (uint64_t i = 0; i < 10; i++) {
+        std::shared_ptr<Program::Program> prog(new Program::Program(*e));
+        Program::Line& l0 = prog->addNewLine();
+        l0.setInstructionIndex(0);
+        l0.setOperand(0, 2, i);
+        l0.setOperand(1, 2, i + 1);
+        l0.setDestinationIndex(1);
+        Program::Line& l1 = prog->addNewLine();
+        l1.setInstructionIndex(0);
+        l1.setOperand(0, 0, 1);
+        l1.setOperand(1, 2, 2 * i);
+        l1.setDestinationIndex(0);
+        prog->identifyIntrons();
+        tpg->addNewEdge(team, *tpg->getVertices().at(4 + (i % 4)), prog);
+    }
+
+    tpee.setArchive(&a);
+    ASSERT_NO_THROW(tpee.evaluateTeamBids(team, bids))
+        << "Lane evaluation of the bids of a team failed.";
+    tpeeRef.evaluateTeamBids(team, expectedBids);
+    ASSERT_EQ(bids.size(), expectedBids.size())
+        << "Incorrect number of bids with lane evaluation.";
+    for (size_t i = 0; i < bids.size(); i++) {
+        ASSERT_EQ(std::memcmp(&bids.at(i), &expectedBids.at(i),
+                              sizeof(double)),
+                  0)
+            << "Bid " << i << " differs with lane evaluation.";
+    }
+    ASSERT_EQ(a.getNbRecordings(), 10)
+        << "Bids evaluated in lanes should be recorded in the archive.";
+    ASSERT_EQ(&tpee.evaluateTeam(team), &tpeeRef.evaluateTeam(team))
+        << "Best edge differs with lane evaluation.";
+
+    // Modified data is read by the next evaluation.
+    ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+        .setDataAt(typeid(double), 18, 100.0);
+    tpee.evaluateTeamBids(team, bids);
+    tpeeRef.evaluateTeamBids(team, expectedBids);
+    ASSERT_EQ(bids, expectedBids)
+        << "Bids differ with lane evaluation after a data modification.";
+}
+
+TEST_F(TPGExecutionEngineTest, LaneEvaluationDeletedTeam)
+{
+    TPG::TPGExecutionEngine tpee(*e);
+    TPG::TPGExecutionEngine tpeeRef(*e);
+    tpee.setLaneEvaluationEnabled(true);
+    for (uint64_t i = 0; i < size1; i++) {
+        ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+            .setDataAt(typeid(double), i, 1.0 / (3.0 + (double)i));
+    }
+
+    // Add a team with a single program, using AddPrimitiveType<double>, so
+    // that the allocator is likely to reuse the addresses of deleted ones.
+    auto addTeam = [this](uint64_t offset) -> const TPG::TPGTeam& {
+        const TPG::TPGTeam& team = tpg->addNewTeam();
+        std::shared_ptr<Program::Program> prog(new Program::Program(*e));
+        Program::Line& l0 = prog->addNewLine();
+        l0.setInstructionIndex(0);
+        l0.setOperand(0, 2, offset);
+        l0.setOperand(1, 2, offset + 1);
+        l0.setDestinationIndex(0);
+        prog->identifyIntrons();
+        tpg->addNewEdge(team, *tpg->getVertices().at(4), prog);
+        return team;
+    };
+
+    std::vector<double> bids, expectedBids;
+    tpee.evaluateTeamBids(addTeam(0), bids);
+
+    // The team and its programs are deleted, and new ones, possibly
+    // allocated at the same addresses, read other data.
+    tpg->removeVertex(*tpg->getVertices().back());
+    const TPG::TPGTeam& newTeam = addTeam(7);
+    ASSERT_NO_THROW(tpee.evaluateTeamBids(newTeam, bids))
+        << "Lane evaluation of the bids of a new team failed.";
+    tpeeRef.evaluateTeamBids(newTeam, expectedBids);
+    ASSERT_EQ(bids, expectedBids)
+        << "LaneEvaluator of a deleted team should not be reused.";
+
+    // Replacing a program of a team is detected too.
+    std::shared_ptr<Program::Program> prog(new Program::Program(*e));
+    Program::Line& l0 = prog->addNewLine();
+    l0.setInstructionIndex(0);
+    l0.setOperand(0, 2, 20);
+    l0.setOperand(1, 2, 21);
+    l0.setDestinationIndex(0);
+    prog->identifyIntrons();
+    newTeam.getOutgoingEdges().front()->setProgram(prog);
+    tpee.evaluateTeamBids(newTeam, bids);
+    tpeeRef.evaluateTeamBids(newTeam, expectedBids);
+    ASSERT_EQ(bids, expectedBids)
+        << "LaneEvaluator should be rebuilt when a program is replaced.";
+
+    // Many teams are created, evaluated and deleted, sweeping the
+    // LaneEvaluator of deleted teams.
+    for (uint64_t i = 0; i < 200; i++) {
+        const TPG::TPGTeam& tmpTeam = addTeam(i % 20);
+        tpee.evaluateTeamBids(tmpTeam, bids);
+        tpeeRef.evaluateTeamBids(tmpTeam, expectedBids);
+        ASSERT_EQ(bids, expectedBids)
+            << "Bids differ with lane evaluation of a new team.";
+        tpg->removeVertex(tmpTeam);
+    }
+    tpee.evaluateTeamBids(newTeam, bids);
+    tpeeRef.evaluateTeamBids(newTeam, expectedBids);
+    ASSERT_EQ(bids, expectedBids)
+        << "Bids differ with lane evaluation after sweeping LaneEvaluator.";
+}
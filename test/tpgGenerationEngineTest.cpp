@@ -38,8 +38,10 @@
 
 #ifdef CODE_GENERATION
 #include <cstddef>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <sstream>
 
 #if defined(_MSC_VER) || (__MINGW32__)
 // C++17 not available in gcc7 or clang7
@@ -370,6 +372,190 @@ TEST_BOTH_MODE(TwoLeaves, {
         << "Error wrong action returned in test TwoLeaves.";
 });
 
+#ifndef _MSC_VER
+TEST_F(TPGGenerationEngineTest, ReentrantTwoLeaves)
+{
+    const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
+    const TPG::TPGVertex* root = (&tpg->addNewTeam());
+
+    const std::shared_ptr<Program::Program> prog1(new Program::Program(*e));
+    Program::Line& prog1L1 = prog1->addNewLine();
+    // reg[0] = ctx->in1[0] + ctx->in1[1];
+    prog1L1.setDestinationIndex(0);
+    prog1L1.setInstructionIndex(0);
+    prog1L1.setOperand(0, 1, 0);
+    prog1L1.setOperand(1, 1, 1);
+
+    const std::shared_ptr<Program::Program> prog2(new Program::Program(*e));
+    Program::Line& prog2L1 = prog2->addNewLine();
+    // reg[0] = ctx->in1[0] + ctx->in1[2];
+    prog2L1.setDestinationIndex(0);
+    prog2L1.setInstructionIndex(0);
+    prog2L1.setOperand(0, 1, 0);
+    prog2L1.setOperand(1, 1, 2);
+
+    tpg->addNewEdge(*root, *leaf, prog1);
+    tpg->addNewEdge(*root, *leaf2, prog2);
+
+    CodeGen::TPGGenerationEngineFactory factory(
+        CodeGen::TPGGenerationEngineFactory::generationEngineMode::
+            reentrantSwitchMode);
+    tpgGen = factory.create("ReentrantTwoLeaves", *tpg, "./src/");
+    ASSERT_NE(dynamic_cast<CodeGen::TPGSwitchGenerationEngine*>(tpgGen.get()),
+              nullptr)
+        << "Factory should create a TPGSwitchGenerationEngine in "
+           "reentrantSwitchMode.";
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    // Inputs and registers are declared in the context.
+    std::ifstream header("./src/ReentrantTwoLeaves_program.h");
+    std::string content((std::istreambuf_iterator<char>(header)),
+                        std::istreambuf_iterator<char>());
+    ASSERT_NE(content.find("typedef struct TPGContext {"), std::string::npos)
+        << "Context struct is missing in the generated program header.";
+    ASSERT_NE(content.find("double P0(TPGContext* ctx);"), std::string::npos)
+        << "Generated programs should take the context as a parameter.";
+
+    cmdCompile += "ReentrantTwoLeaves";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test ReentrantTwoLeaves.";
+
+    cmdExec += "ReentrantTwoLeaves" + executableExtension;
+    ASSERT_EQ(system(cmdExec.c_str()), 0)
+        << "Error wrong action returned in test ReentrantTwoLeaves.";
+}
+#endif // _MSC_VER
+
+TEST_F(TPGGenerationEngineTest, BatchTwoTeams)
+{
+    const TPG::TPGVertex* leaf1 = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
+    const TPG::TPGVertex* leaf3 = (&tpg->addNewAction(3));
+    const TPG::TPGVertex* root = (&tpg->addNewTeam());
+    const TPG::TPGVertex* team = (&tpg->addNewTeam());
+
+    // Programs P = in1[a] op in1[b], with op = 0 for + and 1 for -.
+    auto makeProgram = [this](uint64_t op, uint64_t a, uint64_t b) {
+        std::shared_ptr<Program::Program> prog(new Program::Program(*e));
+        Program::Line& line = prog->addNewLine();
+        line.setDestinationIndex(0);
+        line.setInstructionIndex(op);
+        line.setOperand(0, 1, a);
+        line.setOperand(1, 1, b);
+        prog->identifyIntrons();
+        return prog;
+    };
+
+    tpg->addNewEdge(*root, *leaf1, makeProgram(1, 0, 1));
+    tpg->addNewEdge(*root, *team, makeProgram(0, 1, 2));
+    tpg->addNewEdge(*team, *leaf2, makeProgram(1, 3, 4));
+    tpg->addNewEdge(*team, *leaf3, makeProgram(1, 4, 3));
+
+    CodeGen::TPGGenerationEngineFactory factory(
+        CodeGen::TPGGenerationEngineFactory::generationEngineMode::
+            batchSwitchMode);
+    tpgGen = factory.create("BatchTwoTeams", *tpg, "./src/");
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    cmdCompile += "BatchTwoTeams";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test BatchTwoTeams.";
+
+    cmdExec += "BatchTwoTeams" + executableExtension;
+    ASSERT_EQ(system(cmdExec.c_str()), 0)
+        << "Error batch inference differs from the inference of each sample "
+           "in test BatchTwoTeams.";
+}
+
+TEST_F(TPGGenerationEngineTest, OptimizedTwoTeams)
+{
+    const TPG::TPGVertex* leaf1 = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
+    const TPG::TPGVertex* leaf3 = (&tpg->addNewAction(3));
+    const TPG::TPGVertex* root = (&tpg->addNewTeam());
+    const TPG::TPGVertex* team = (&tpg->addNewTeam());
+    const TPG::TPGVertex* unreachable = (&tpg->addNewTeam());
+
+    // Add a line reg[dest] = src1[loc1] op src2[loc2], with op = 0 for + and
+    // 1 for -.
+    auto addLine = [](Program::Program& prog, uint64_t dest, uint64_t op,
+                      uint64_t src1, uint64_t loc1, uint64_t src2,
+                      uint64_t loc2) {
+        Program::Line& line = prog.addNewLine();
+        line.setDestinationIndex(dest);
+        line.setInstructionIndex(op);
+        line.setOperand(0, src1, loc1);
+        line.setOperand(1, src2, loc2);
+    };
+
+    // Programs of the root share in1[0] + in1[1].
+    std::shared_ptr<Program::Program> prog1(new Program::Program(*e));
+    addLine(*prog1, 0, 0, 1, 0, 1, 1);
+    addLine(*prog1, 0, 1, 0, 0, 1, 2);
+    std::shared_ptr<Program::Program> prog2(new Program::Program(*e));
+    addLine(*prog2, 0, 0, 1, 0, 1, 1);
+    addLine(*prog2, 0, 0, 0, 0, 1, 3);
+    // reg[1] = reg[1] + reg[2] is folded.
+    std::shared_ptr<Program::Program> prog3(new Program::Program(*e));
+    addLine(*prog3, 1, 0, 0, 1, 0, 2);
+    addLine(*prog3, 0, 1, 1, 4, 0, 1);
+    std::shared_ptr<Program::Program> prog4(new Program::Program(*e));
+    addLine(*prog4, 0, 1, 1, 5, 1, 4);
+    std::shared_ptr<Program::Program> prog5(new Program::Program(*e));
+    addLine(*prog5, 0, 1, 1, 6, 1, 7);
+    for (auto prog : {prog1, prog2, prog3, prog4, prog5}) {
+        prog->identifyIntrons();
+    }
+
+    tpg->addNewEdge(*root, *leaf1, prog1);
+    tpg->addNewEdge(*root, *team, prog2);
+    tpg->addNewEdge(*team, *leaf2, prog3);
+    tpg->addNewEdge(*team, *leaf3, prog4);
+    tpg->addNewEdge(*unreachable, *leaf1, prog5);
+    ASSERT_EQ(tpg->getRootVertices().at(0), root)
+        << "Wrong exported root in test OptimizedTwoTeams.";
+
+    CodeGen::TPGGenerationEngineFactory factory(
+        CodeGen::TPGGenerationEngineFactory::generationEngineMode::
+            optimizedSwitchMode);
+    tpgGen = factory.create("OptimizedTwoTeams", *tpg, "./src/");
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    // Check the generated code
+    std::ifstream fileMain("./src/OptimizedTwoTeams.c");
+    std::ifstream fileProgram("./src/OptimizedTwoTeams_program.c");
+    std::stringstream mainCode, programCode;
+    mainCode << fileMain.rdbuf();
+    programCode << fileProgram.rdbuf();
+    ASSERT_EQ(mainCode.str().find("T5"), std::string::npos)
+        << "Unreachable team was generated in test OptimizedTwoTeams.";
+    ASSERT_EQ(programCode.str().find("in1[6]"), std::string::npos)
+        << "Program of an unreachable team was generated in test "
+           "OptimizedTwoTeams.";
+    const std::string& code = programCode.str();
+    ASSERT_NE(code.find("in1[0]"), std::string::npos)
+        << "Shared subexpression missing in test OptimizedTwoTeams.";
+    ASSERT_EQ(code.find("in1[0]"), code.rfind("in1[0]"))
+        << "Shared subexpression generated twice in test OptimizedTwoTeams.";
+    ASSERT_EQ(code.find("reg"), std::string::npos)
+        << "Registers were not folded in test OptimizedTwoTeams.";
+
+    cmdCompile += "OptimizedTwoTeams";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test OptimizedTwoTeams.";
+
+    cmdExec += "OptimizedTwoTeams" + executableExtension;
+    ASSERT_EQ(system(cmdExec.c_str()), 0)
+        << "Error wrong action returned in test OptimizedTwoTeams.";
+}
+
 TEST_BOTH_MODE(ThreeLeaves, {
     // P1 < P2 = P3
     const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
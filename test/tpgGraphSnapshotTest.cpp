@@ -0,0 +1,324 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+
+#include "archive.h"
+#include "data/dataHandler.h"
+#include "data/primitiveTypeArray.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/multByConstant.h"
+#include "program/program.h"
+#include "tpg/tpgAction.h"
+#include "tpg/tpgEdge.h"
+#include "tpg/tpgExecutionEngine.h"
+#include "tpg/tpgGraph.h"
+#include "tpg/tpgTeam.h"
+
+#include "tpg/tpgGraphSnapshot.h"
+#include "tpg/tpgSnapshotExecutionEngine.h"
+
+class TPGGraphSnapshotTest : public ::testing::Test
+{
+  protected:
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Instructions::Set set;
+    Environment* e = NULL;
+    std::vector<std::shared_ptr<Program::Program>> progPointers;
+    TPG::TPGGraph* tpg;
+
+    /// Populate the program instructions so that it returns the given value.
+    void makeProgramReturn(Program::Program& prog, double value)
+    {
+        auto& line = prog.addNewLine();
+        line.setInstructionIndex(1);
+        line.setOperand(0, 2, 0);    // Dhandler 0 location 0
+        line.setOperand(1, 1, 0);    // CHandler at location 0
+        line.setDestinationIndex(0); // 0th register dest
+        prog.getConstantHandler().setDataAt(typeid(Data::Constant), 0,
+                                            {static_cast<int32_t>(value)});
+    }
+
+    virtual void SetUp()
+    {
+        vect.push_back(*(new Data::PrimitiveTypeArray<double>(24)));
+        ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+            .setDataAt(typeid(double), 0, 1.0);
+
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        set.add(*(new Instructions::MultByConstant<double>()));
+        e = new Environment(set, vect, 8, 1);
+        tpg = new TPG::TPGGraph(*e);
+
+        for (int i = 0; i < 6; i++) {
+            progPointers.push_back(
+                std::shared_ptr<Program::Program>(new Program::Program(*e)));
+        }
+        makeProgramReturn(*progPointers.at(0), 5);
+        makeProgramReturn(*progPointers.at(1), 5);
+        makeProgramReturn(*progPointers.at(2), 3);
+        makeProgramReturn(*progPointers.at(3), 8);
+        makeProgramReturn(*progPointers.at(4), 9);
+        makeProgramReturn(*progPointers.at(5), 6);
+
+        // (T= Team, A= Action)
+        //
+        // T0---->T1---->T2
+        // |     /| \    |
+        // v    / v  \   v
+        // A0<-'  A1  `->A2
+        for (int i = 0; i < 3; i++) {
+            tpg->addNewTeam();
+        }
+        for (int i = 0; i < 3; i++) {
+            tpg->addNewAction(i);
+        }
+        auto v = tpg->getVertices();
+        tpg->addNewEdge(*v.at(0), *v.at(3), progPointers.at(0)); // 5
+        tpg->addNewEdge(*v.at(0), *v.at(1), progPointers.at(3)); // 8
+        tpg->addNewEdge(*v.at(1), *v.at(4), progPointers.at(1)); // 5
+        tpg->addNewEdge(*v.at(1), *v.at(2), progPointers.at(4)); // 9
+        tpg->addNewEdge(*v.at(1), *v.at(3), progPointers.at(5)); // 6
+        tpg->addNewEdge(*v.at(1), *v.at(5), progPointers.at(2)); // 3
+        tpg->addNewEdge(*v.at(2), *v.at(5), progPointers.at(2)); // 3 (shared)
+    }
+
+    virtual void TearDown()
+    {
+        delete tpg;
+        delete e;
+        delete (&(vect.at(0).get()));
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+    }
+};
+
+TEST_F(TPGGraphSnapshotTest, Constructor)
+{
+    TPG::TPGGraphSnapshot* snapshot;
+    ASSERT_NO_THROW(snapshot = new TPG::TPGGraphSnapshot(*tpg))
+        << "Construction of the snapshot of a TPGGraph failed.";
+
+    ASSERT_EQ(&snapshot->getEnvironment(), e)
+        << "Environment of the snapshot is incorrect.";
+    ASSERT_EQ(snapshot->getVertices().size(), 6)
+        << "Number of vertices of the snapshot is incorrect.";
+    ASSERT_EQ(snapshot->getEdges().size(), 7)
+        << "Number of edges of the snapshot is incorrect.";
+    ASSERT_EQ(snapshot->getCompiledPrograms().size(), 6)
+        << "Program shared by several edges should be compiled once.";
+    ASSERT_EQ(snapshot->getRoots().size(), 1)
+        << "Number of roots of the snapshot is incorrect.";
+    ASSERT_EQ(snapshot->getGraphVertex(snapshot->getRoots().at(0)),
+              tpg->getRootVertices().at(0))
+        << "Root of the snapshot is incorrect.";
+
+    // CSR layout
+    const TPG::TPGGraphSnapshot::Vertex& t1 = snapshot->getVertices().at(1);
+    ASSERT_FALSE(t1.isAction) << "Team is marked as an action.";
+    ASSERT_EQ(t1.firstEdge, 2) << "First outgoing edge of a team is incorrect.";
+    ASSERT_EQ(t1.nbEdges, 4) << "Number of outgoing edges of a team is "
+                                "incorrect.";
+    const TPG::TPGGraphSnapshot::Vertex& a2 = snapshot->getVertices().at(5);
+    ASSERT_TRUE(a2.isAction) << "Action is not marked as an action.";
+    ASSERT_EQ(a2.actionID, 2) << "Action identifier is incorrect.";
+    ASSERT_EQ(snapshot->getEdges().at(5).programIndex,
+              snapshot->getEdges().at(6).programIndex)
+        << "Edges sharing a Program should share a compiled Program.";
+
+    ASSERT_EQ(snapshot->getVertexIndex(*tpg->getVertices().at(4)), 4)
+        << "Index of a vertex in the snapshot is incorrect.";
+    TPG::TPGGraph otherGraph(*e);
+    ASSERT_THROW(snapshot->getVertexIndex(otherGraph.addNewTeam()),
+                 std::out_of_range)
+        << "Index of a vertex absent from the snapshot should not exist.";
+
+    ASSERT_NO_THROW(delete snapshot) << "Destruction of a snapshot failed.";
+}
+
+TEST_F(TPGGraphSnapshotTest, SnapshotOutlivesGraph)
+{
+    TPG::TPGGraphSnapshot snapshot(*tpg);
+    const Program::Program* prog =
+        &snapshot.getCompiledPrograms().at(0).getProgram();
+    progPointers.clear();
+    delete tpg;
+    tpg = new TPG::TPGGraph(*e);
+
+    TPG::TPGSnapshotExecutionEngine engine(*e, snapshot);
+    ASSERT_EQ(engine.executeActionFromRoot(snapshot.getRoots().at(0)), 2)
+        << "Execution of a snapshot whose TPGGraph was destroyed failed.";
+    ASSERT_EQ(&snapshot.getCompiledPrograms().at(0).getProgram(), prog)
+        << "Program of a snapshot should be kept alive.";
+}
+
+TEST_F(TPGGraphSnapshotTest, ExecuteFromRoot)
+{
+    TPG::TPGGraphSnapshot snapshot(*tpg);
+    Archive archive1, archive2;
+    TPG::TPGExecutionEngine tee(*e, &archive1);
+    TPG::TPGSnapshotExecutionEngine engine(*e, snapshot, &archive2);
+
+    const std::vector<const TPG::TPGVertex*> expected =
+        tee.executeFromRoot(*tpg->getRootVertices().at(0));
+
+    std::vector<uint64_t> trace;
+    ASSERT_NO_THROW(trace = engine.executeFromRoot(snapshot.getRoots().at(0)))
+        << "Execution of a snapshot from a valid root failed.";
+    ASSERT_EQ(trace.size(), expected.size())
+        << "Size of the traversed path is incorrect.";
+    for (auto idx = 0; idx < trace.size(); idx++) {
+        ASSERT_EQ(snapshot.getGraphVertex(trace.at(idx)), expected.at(idx))
+            << "Element " << idx << " of the traversed path is incorrect.";
+    }
+    ASSERT_EQ(engine.executeActionFromRoot(snapshot.getRoots().at(0)), 2)
+        << "Action reached by the execution is incorrect.";
+
+    // Archive: same recordings for one execution
+    ASSERT_EQ(archive2.getNbRecordings(), 2 * archive1.getNbRecordings())
+        << "Number of recordings of the snapshot execution is incorrect.";
+    for (auto idx = 0; idx < archive1.getNbRecordings(); idx++) {
+        ASSERT_EQ(archive1.at(idx).prog, archive2.at(idx).prog)
+            << "Program of recording " << idx << " is incorrect.";
+        ASSERT_EQ(archive1.at(idx).result, archive2.at(idx).result)
+            << "Result of recording " << idx << " is incorrect.";
+    }
+
+    // Empty team
+    tpg->addNewTeam();
+    TPG::TPGGraphSnapshot snapshot2(*tpg);
+    TPG::TPGSnapshotExecutionEngine engine2(*e, snapshot2);
+    ASSERT_THROW(engine2.executeFromRoot(6), std::runtime_error)
+        << "Execution of a team without outgoing edge should fail.";
+}
+
+TEST_F(TPGGraphSnapshotTest, TemporalBidCache)
+{
+    TPG::TPGGraphSnapshot snapshot(*tpg);
+    Archive archive;
+    TPG::TPGSnapshotExecutionEngine engine(*e, snapshot, &archive);
+    const uint64_t root = snapshot.getRoots().at(0);
+
+    ASSERT_FALSE(engine.isTemporalBidCacheEnabled())
+        << "Temporal bid cache should be disabled by default.";
+    ASSERT_NO_THROW(engine.setTemporalBidCacheEnabled(true))
+        << "Enabling the temporal bid cache failed.";
+    ASSERT_TRUE(engine.isTemporalBidCacheEnabled())
+        << "Temporal bid cache should be enabled.";
+
+    // Replace the data with an external vector whose modifications are
+    // notified manually, to observe when cached bids are reused.
+    auto& data = (Data::PrimitiveTypeArray<double>&)vect.at(0).get();
+    std::vector<double> values(24, 0.0);
+    values.at(0) = 1.0;
+    data.setPointer(&values);
+
+    ASSERT_EQ(engine.executeActionFromRoot(root), 2)
+        << "Action reached by the execution is incorrect.";
+    uint64_t nbRecordings = archive.getNbRecordings();
+
+    // Unnotified modification: bids are reused.
+    values.at(0) = -1.0;
+    ASSERT_EQ(engine.executeActionFromRoot(root), 2)
+        << "Cached bids should be reused when read data is not modified.";
+    ASSERT_EQ(archive.getNbRecordings(), 2 * nbRecordings)
+        << "Reused bids should still be recorded in the Archive.";
+
+    // Modification of data not read by the programs: bids are reused.
+    data.markAddressModified(5);
+    ASSERT_EQ(engine.executeActionFromRoot(root), 2)
+        << "Cached bids should be reused when read data is not modified.";
+
+    // Modification of read data: programs are executed again.
+    data.markAddressModified(0);
+    ASSERT_EQ(engine.executeActionFromRoot(root), 0)
+        << "Cached bids should not be reused when read data is modified.";
+
+    // Clearing the cache forces the execution of programs.
+    values.at(0) = 1.0;
+    engine.clearTemporalBidCache();
+    ASSERT_EQ(engine.executeActionFromRoot(root), 2)
+        << "Cached bids should not be reused after clearing the cache.";
+
+    // Disabling the cache
+    values.at(0) = -1.0;
+    engine.setTemporalBidCacheEnabled(false);
+    ASSERT_EQ(engine.executeActionFromRoot(root), 0)
+        << "Bids should not be reused when the cache is disabled.";
+
+    data.setPointer(nullptr);
+}
+
+TEST_F(TPGGraphSnapshotTest, NativePrograms)
+{
+    // Replace the first program with a native one adding two data.
+    auto& line = progPointers.at(0)->getLine(0);
+    line.setInstructionIndex(0); // AddPrimitiveType<double>
+    line.setOperand(0, 2, 0);
+    line.setOperand(1, 2, 1);
+    progPointers.at(0)->identifyIntrons();
+    ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+        .setDataAt(typeid(double), 1, 9.0);
+
+    TPG::TPGGraphSnapshot snapshot(*tpg);
+    TPG::TPGSnapshotExecutionEngine reference(*e, snapshot);
+    Archive archive;
+    TPG::TPGSnapshotExecutionEngine engine(*e, snapshot, &archive);
+    const uint64_t root = snapshot.getRoots().at(0);
+
+    ASSERT_FALSE(engine.isNativeProgramsEnabled())
+        << "Native programs should be disabled by default.";
+    ASSERT_NO_THROW(engine.setNativeProgramsEnabled(true))
+        << "Enabling native programs failed.";
+    ASSERT_TRUE(engine.isNativeProgramsEnabled())
+        << "Native programs should be enabled.";
+
+    // 1 + 9 = 10 > 8
+    ASSERT_EQ(engine.executeFromRoot(root), reference.executeFromRoot(root))
+        << "Trace of the execution with native programs is incorrect.";
+    ASSERT_EQ(engine.executeActionFromRoot(root), 0)
+        << "Action reached with native programs is incorrect.";
+    ASSERT_GT(archive.getNbRecordings(), 0)
+        << "Native programs results should be recorded in the Archive.";
+
+    ((Data::PrimitiveTypeArray<double>&)vect.at(0).get())
+        .setDataAt(typeid(double), 1, 0.0);
+    ASSERT_EQ(engine.executeActionFromRoot(root),
+              reference.executeActionFromRoot(root))
+        << "Action reached with native programs is incorrect.";
+
+    ASSERT_NO_THROW(engine.setNativeProgramsEnabled(false))
+        << "Disabling native programs failed.";
+    ASSERT_EQ(engine.executeFromRoot(root), reference.executeFromRoot(root))
+        << "Trace of the execution without native programs is incorrect.";
+}
@@ -0,0 +1,279 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifdef CODE_GENERATION
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "archive.h"
+#include "data/primitiveTypeArray.h"
+#include "data/primitiveTypeArray2D.h"
+#include "environment.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/rng.h"
+#include "mutator/tpgMutator.h"
+#include "tpg/tpgExecutionEngine.h"
+#include "tpg/tpgGraph.h"
+
+#include "codeGen/tpgNativeExecutionEngine.h"
+
+class TPGNativeExecutionEngineTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    Instructions::LambdaInstruction<double, double> add{
+        [](double a, double b) { return a + b; }, "$0 = $1 + $2;"};
+    Instructions::LambdaInstruction<double, double> sub{
+        [](double a, double b) { return a - b; }, "$0 = $1 - $2;"};
+    Instructions::LambdaInstruction<double> cosinus{
+        [](double a) { return cos(a); }, "$0 = cos($1);"};
+    Data::PrimitiveTypeArray<double> currentState{8};
+    Data::PrimitiveTypeArray2D<double> grid{3, 3};
+    std::vector<std::reference_wrapper<const Data::DataHandler>> data{
+        currentState, grid};
+    Environment* e = nullptr;
+    TPG::TPGGraph* tpg = nullptr;
+    Mutator::RNG rng{0};
+
+    void randomizeData()
+    {
+        for (size_t idx = 0; idx < 8; idx++) {
+            currentState.setDataAt(typeid(double), idx,
+                                   rng.getDouble(-10.0, 10.0));
+        }
+        for (size_t idx = 0; idx < 9; idx++) {
+            grid.setDataAt(typeid(double), idx, rng.getDouble(-10.0, 10.0));
+        }
+    }
+
+    virtual void SetUp()
+    {
+        set.add(add);
+        set.add(sub);
+        set.add(cosinus);
+        e = new Environment(set, data, 8, 0);
+        tpg = new TPG::TPGGraph(*e);
+
+        Mutator::MutationParameters params;
+        params.tpg.initNbRoots = 4;
+        params.tpg.nbRoots = 20;
+        params.tpg.maxInitOutgoingEdges = 3;
+        params.tpg.maxOutgoingEdges = 5;
+        params.prog.maxProgramSize = 20;
+        params.tpg.pEdgeDeletion = 0.7;
+        params.tpg.pEdgeAddition = 0.7;
+        params.tpg.pProgramMutation = 0.2;
+        params.tpg.pEdgeDestinationChange = 0.1;
+        params.tpg.pEdgeDestinationIsAction = 0.5;
+        params.prog.pAdd = 0.5;
+        params.prog.pDelete = 0.5;
+        params.prog.pMutate = 1.0;
+        params.prog.pSwap = 1.0;
+
+        Archive archive;
+        Mutator::TPGMutator::initRandomTPG(*tpg, params, rng, 4);
+        for (int generation = 0; generation < 3; generation++) {
+            Mutator::TPGMutator::populateTPG(*tpg, archive, params, rng, 4,
+                                             0);
+            auto roots = tpg->getRootVertices();
+            for (size_t idx = 0; idx < roots.size() / 2; idx++) {
+                if (dynamic_cast<const TPG::TPGTeam*>(roots.at(idx))) {
+                    tpg->removeVertex(*roots.at(idx));
+                }
+            }
+        }
+        Mutator::TPGMutator::populateTPG(*tpg, archive, params, rng, 4, 0);
+    }
+
+    virtual void TearDown()
+    {
+        delete tpg;
+        delete e;
+    }
+};
+
+TEST_F(TPGNativeExecutionEngineTest, Constructor)
+{
+    ASSERT_NO_THROW(CodeGen::TPGNativeExecutionEngine engine(*e, *tpg))
+        << "Construction of the engine should not fail.";
+}
+
+TEST_F(TPGNativeExecutionEngineTest, ExecuteFromRoot)
+{
+    CodeGen::TPGNativeExecutionEngine nativeEngine(*e, *tpg);
+    TPG::TPGExecutionEngine interpreter(*e);
+
+    if (!nativeEngine.compile()) {
+        GTEST_SKIP() << "No C compiler available for native compilation.";
+    }
+
+    auto roots = tpg->getRootVertices();
+    for (const TPG::TPGVertex* root : roots) {
+        ASSERT_TRUE(nativeEngine.isNative(*root));
+    }
+
+    // Native and interpreted executions visit the same vertices, with the
+    // live data of the environment.
+    for (int iteration = 0; iteration < 20; iteration++) {
+        randomizeData();
+        for (const TPG::TPGVertex* root : roots) {
+            auto expected = interpreter.executeFromRoot(*root);
+            auto result = nativeEngine.executeFromRoot(*root);
+            ASSERT_EQ(result, expected)
+                << "Native execution differs from interpretation.";
+        }
+    }
+}
+
+TEST_F(TPGNativeExecutionEngineTest, CompileSubsetOfRoots)
+{
+    CodeGen::TPGNativeExecutionEngine nativeEngine(*e, *tpg);
+    TPG::TPGExecutionEngine interpreter(*e);
+
+    auto roots = tpg->getRootVertices();
+    if (!nativeEngine.compile({roots.at(0)})) {
+        GTEST_SKIP() << "No C compiler available for native compilation.";
+    }
+
+    ASSERT_TRUE(nativeEngine.isNative(*roots.at(0)));
+    ASSERT_FALSE(nativeEngine.isNative(*roots.at(1)));
+
+    // Other roots are interpreted
+    randomizeData();
+    for (const TPG::TPGVertex* root : roots) {
+        ASSERT_EQ(nativeEngine.executeFromRoot(*root),
+                  interpreter.executeFromRoot(*root));
+    }
+}
+
+TEST_F(TPGNativeExecutionEngineTest, CompilerWithArguments)
+{
+    CodeGen::TPGNativeExecutionEngine defaultEngine(*e, *tpg);
+    if (!defaultEngine.compile()) {
+        GTEST_SKIP() << "No C compiler available for native compilation.";
+    }
+
+    // Compiler command made of several words, like "ccache gcc".
+    const char* cc = std::getenv("CC");
+    CodeGen::TPGNativeExecutionEngine nativeEngine(
+        *e, *tpg, NULL, std::string("env ") + ((cc != nullptr) ? cc : "cc"));
+    ASSERT_TRUE(nativeEngine.compile())
+        << "Compilation should succeed with a compiler command holding "
+           "several words.";
+}
+
+TEST_F(TPGNativeExecutionEngineTest, Fallback)
+{
+    auto roots = tpg->getRootVertices();
+    TPG::TPGExecutionEngine interpreter(*e);
+    randomizeData();
+
+    // Unavailable compiler
+    CodeGen::TPGNativeExecutionEngine noCompilerEngine(
+        *e, *tpg, NULL, "gegelati-nonexistent-compiler");
+    ASSERT_FALSE(noCompilerEngine.compile())
+        << "Compilation should fail without a compiler.";
+    ASSERT_FALSE(noCompilerEngine.isNative(*roots.at(0)));
+    ASSERT_EQ(noCompilerEngine.executeFromRoot(*roots.at(0)),
+              interpreter.executeFromRoot(*roots.at(0)))
+        << "Interpretation should be used when the compilation fails.";
+
+    // Archive is set
+    Archive archive;
+    CodeGen::TPGNativeExecutionEngine archivingEngine(*e, *tpg, &archive);
+    archivingEngine.compile();
+    ASSERT_FALSE(archivingEngine.isNative(*roots.at(0)))
+        << "Native code should not be used when an Archive is set.";
+    ASSERT_EQ(archivingEngine.executeFromRoot(*roots.at(0)),
+              interpreter.executeFromRoot(*roots.at(0)));
+    ASSERT_GT(archive.getNbRecordings(), 0);
+}
+
+TEST_F(TPGNativeExecutionEngineTest, CyclicGraph)
+{
+    // Two teams whose only edges lead to each other.
+    TPG::TPGGraph graph(*e);
+    const TPG::TPGTeam& teamA = graph.addNewTeam();
+    const TPG::TPGTeam& teamB = graph.addNewTeam();
+    std::shared_ptr<Program::Program> prog(new Program::Program(*e));
+    Program::Line& line = prog->addNewLine();
+    line.setInstructionIndex(0);
+    line.setOperand(0, 1, 0);
+    line.setOperand(1, 1, 1);
+    line.setDestinationIndex(0);
+    prog->identifyIntrons();
+    graph.addNewEdge(teamA, teamB, prog);
+    graph.addNewEdge(teamB, teamA, prog);
+
+    CodeGen::TPGNativeExecutionEngine nativeEngine(*e, graph);
+    if (!nativeEngine.compile({&teamA})) {
+        GTEST_SKIP() << "No C compiler available for native compilation.";
+    }
+
+    randomizeData();
+    ASSERT_THROW(nativeEngine.executeFromRoot(teamA), std::runtime_error)
+        << "Native execution of a cyclic TPGGraph should fail instead of "
+           "writing past the end of its trace.";
+}
+
+TEST_F(TPGNativeExecutionEngineTest, NonPrintableInstruction)
+{
+    Instructions::Set nonPrintableSet;
+    Instructions::LambdaInstruction<double, double> mult{
+        [](double a, double b) { return a * b; }};
+    Instructions::LambdaInstruction<double, double> max{
+        [](double a, double b) { return std::max(a, b); }};
+    nonPrintableSet.add(mult);
+    nonPrintableSet.add(max);
+    Environment nonPrintableEnv(nonPrintableSet, data, 8, 0);
+    TPG::TPGGraph graph(nonPrintableEnv);
+    Mutator::MutationParameters params;
+    params.tpg.initNbRoots = 2;
+    params.tpg.maxInitOutgoingEdges = 2;
+    params.prog.maxProgramSize = 20;
+    Mutator::TPGMutator::initRandomTPG(graph, params, rng, 2);
+
+    CodeGen::TPGNativeExecutionEngine engine(nonPrintableEnv, graph);
+    ASSERT_FALSE(engine.compile())
+        << "Compilation should fail with a non printable Instruction.";
+
+    TPG::TPGExecutionEngine interpreter(nonPrintableEnv);
+    const TPG::TPGVertex& root = *graph.getRootVertices().at(0);
+    ASSERT_EQ(engine.executeFromRoot(root), interpreter.executeFromRoot(root));
+}
+
+#endif // CODE_GENERATION
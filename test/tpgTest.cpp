@@ -500,6 +500,56 @@ TEST_F(TPGTest, TPGGraphGetRootVertices)
         << "Vertex classified as root is incorrect.";
 }
 
+TEST_F(TPGTest, TPGGraphRootVerticesUpdate)
+{
+    TPG::TPGGraph tpg(*e);
+    const TPG::TPGVertex& vertex0 = tpg.addNewTeam();
+    const TPG::TPGVertex& vertex1 = tpg.addNewTeam();
+    const TPG::TPGVertex& vertex2 = tpg.addNewTeam();
+    const TPG::TPGAction& vertex3 = tpg.addNewAction(0);
+
+    const TPG::TPGEdge& edge0 = tpg.addNewEdge(vertex0, vertex3, progPointer);
+    const TPG::TPGEdge& edge1 = tpg.addNewEdge(vertex0, vertex1, progPointer);
+    const TPG::TPGEdge& edge2 = tpg.addNewEdge(vertex2, vertex1, progPointer);
+    ASSERT_EQ(tpg.getNbRootVertices(), 2)
+        << "Number of roots of the TPG is incorrect.";
+
+    // Redirect an edge: vertex1 is still a destination of edge1
+    tpg.setEdgeDestination(edge2, vertex3);
+    ASSERT_EQ(tpg.getNbRootVertices(), 2)
+        << "Number of roots of the TPG is incorrect after edge redirection.";
+
+    // Remove the last incoming edge of vertex1
+    tpg.removeEdge(edge1);
+    std::vector<const TPG::TPGVertex*> roots = tpg.getRootVertices();
+    ASSERT_EQ(roots.size(), 3)
+        << "Number of roots of the TPG is incorrect after edge removal.";
+    // Roots are in the same order as in the vertices
+    ASSERT_EQ(roots.at(0), &vertex0) << "Order of root vertices is incorrect.";
+    ASSERT_EQ(roots.at(1), &vertex1) << "Order of root vertices is incorrect.";
+    ASSERT_EQ(roots.at(2), &vertex2) << "Order of root vertices is incorrect.";
+
+    // Remove a root and add an edge toward another
+    tpg.removeVertex(vertex2);
+    tpg.addNewEdge(vertex1, vertex0, progPointer);
+    roots = tpg.getRootVertices();
+    ASSERT_EQ(roots.size(), 1)
+        << "Number of roots of the TPG is incorrect after vertex removal.";
+    ASSERT_EQ(roots.at(0), &vertex1) << "Vertex classified as root is "
+                                        "incorrect.";
+    ASSERT_EQ(tpg.getNbRootVertices(), 1)
+        << "Number of roots of the TPG is incorrect after vertex removal.";
+
+    // Moved graph keeps its roots
+    TPG::TPGGraph tpg2(std::move(tpg));
+    ASSERT_EQ(tpg2.getNbRootVertices(), 1)
+        << "Number of roots of a moved TPG is incorrect.";
+    ASSERT_TRUE(tpg2.hasVertex(vertex1))
+        << "Vertex of a moved TPG not found.";
+    ASSERT_EQ(tpg.getNbRootVertices(), 0)
+        << "Number of roots of an emptied TPG is incorrect.";
+}
+
 TEST_F(TPGTest, TPGGraphCloneVertex)
 {
     TPG::TPGGraph tpg(*e);